@@ -0,0 +1,115 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/batch/include/batch.hpp"
+#include "core/task/func_tests/test_task.hpp"
+
+namespace {
+
+class BatchData {
+ public:
+  explicit BatchData(size_t count) : in(count), out(count, std::vector<int32_t>(1, 0)) {
+    for (size_t i = 0; i < count; i++) {
+      in[i] = std::vector<int32_t>(i + 1, 1);
+
+      auto taskData = std::make_shared<ppc::core::TaskData>();
+      taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in[i].data()));
+      taskData->inputs_count.emplace_back(in[i].size());
+      taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out[i].data()));
+      taskData->outputs_count.emplace_back(out[i].size());
+      batch.push_back(taskData);
+    }
+  }
+
+  std::shared_ptr<ppc::core::BatchExecutor> make_executor() {
+    return std::make_shared<ppc::core::BatchExecutor>(
+        [](std::shared_ptr<ppc::core::TaskData> taskData) {
+          return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+        },
+        batch);
+  }
+
+  void check_outputs() {
+    for (size_t i = 0; i < in.size(); i++) {
+      EXPECT_EQ(static_cast<size_t>(out[i][0]), in[i].size());
+    }
+  }
+
+  std::vector<std::vector<int32_t>> in;
+  std::vector<std::vector<int32_t>> out;
+  std::vector<std::shared_ptr<ppc::core::TaskData>> batch;
+};
+
+}  // namespace
+
+TEST(batch_tests, check_inter_task) {
+  BatchData data(33);
+  auto executor = data.make_executor();
+
+  auto batchAttr = std::make_shared<ppc::core::BatchAttr>();
+  batchAttr->mode = ppc::core::BatchAttr::INTER_TASK;
+  batchAttr->num_threads = 4;
+
+  ASSERT_TRUE(executor->run(batchAttr));
+  EXPECT_EQ(executor->get_mode(), ppc::core::BatchAttr::INTER_TASK);
+  data.check_outputs();
+}
+
+TEST(batch_tests, check_intra_task) {
+  BatchData data(10);
+  auto executor = data.make_executor();
+
+  auto batchAttr = std::make_shared<ppc::core::BatchAttr>();
+  batchAttr->mode = ppc::core::BatchAttr::INTRA_TASK;
+
+  ASSERT_TRUE(executor->run(batchAttr));
+  EXPECT_EQ(executor->get_mode(), ppc::core::BatchAttr::INTRA_TASK);
+  data.check_outputs();
+}
+
+TEST(batch_tests, check_auto_mode) {
+  BatchData data(50);
+  auto executor = data.make_executor();
+
+  auto batchAttr = std::make_shared<ppc::core::BatchAttr>();
+  batchAttr->num_threads = 3;
+
+  ASSERT_TRUE(executor->run(batchAttr));
+  EXPECT_NE(executor->get_mode(), ppc::core::BatchAttr::AUTO);
+  data.check_outputs();
+}
+
+TEST(batch_tests, check_auto_mode_single_problem) {
+  BatchData data(1);
+  auto executor = data.make_executor();
+
+  auto batchAttr = std::make_shared<ppc::core::BatchAttr>();
+  batchAttr->num_threads = 3;
+
+  ASSERT_TRUE(executor->run(batchAttr));
+  EXPECT_EQ(executor->get_mode(), ppc::core::BatchAttr::INTRA_TASK);
+  data.check_outputs();
+}
+
+TEST(batch_tests, check_invalid_problem) {
+  BatchData data(8);
+  // TestTask expects exactly one output element
+  data.batch[5]->outputs_count[0] = 2;
+  data.out[5][0] = -7;
+  auto executor = data.make_executor();
+
+  auto batchAttr = std::make_shared<ppc::core::BatchAttr>();
+  batchAttr->mode = ppc::core::BatchAttr::INTER_TASK;
+  batchAttr->num_threads = 2;
+
+  ASSERT_FALSE(executor->run(batchAttr));
+  auto statuses = executor->get_statuses();
+  ASSERT_EQ(statuses.size(), data.batch.size());
+  for (size_t i = 0; i < statuses.size(); i++) {
+    EXPECT_EQ(statuses[i], i != 5);
+  }
+  // pre_processing() and run() of the invalid problem weren't called
+  EXPECT_EQ(data.out[5][0], -7);
+}
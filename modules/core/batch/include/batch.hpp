@@ -0,0 +1,60 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_BATCH_INCLUDE_BATCH_HPP_
+#define MODULES_CORE_BATCH_INCLUDE_BATCH_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+struct BatchAttr {
+  // INTER_TASK: one problem per worker, every task runs on one thread
+  // INTRA_TASK: problems one by one, every task uses all threads
+  // AUTO: calibrate both modes on first problems and run the rest with the
+  // one which gives higher throughput
+  enum Mode { INTER_TASK, INTRA_TASK, AUTO } mode = AUTO;
+  // number of workers in INTER_TASK mode, get_num_threads() if not positive
+  int num_threads = 0;
+  // state of testing of created tasks
+  TaskData::StateOfTesting state_of_testing = TaskData::StateOfTesting::FUNC;
+};
+
+// Runs one Task implementation over many TaskData instances through the
+// full pipeline: validation() -> pre_processing() -> run() -> post_processing().
+// A problem fails at the first stage returning false, later ones aren't run
+class BatchExecutor {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>)>;
+
+  BatchExecutor(TaskFactory factory_, std::vector<std::shared_ptr<TaskData>> batch_);
+
+  // Run all problems of the batch, returns true if every task is valid and
+  // all of its stages succeeded
+  bool run(const std::shared_ptr<BatchAttr>& batchAttr);
+
+  [[nodiscard]] size_t size() const { return batch.size(); }
+  // status of every problem of the last run
+  [[nodiscard]] std::vector<bool> get_statuses() const;
+  // mode used by the last run (resolved for AUTO)
+  [[nodiscard]] BatchAttr::Mode get_mode() const { return mode; }
+
+ private:
+  TaskFactory factory;
+  std::vector<std::shared_ptr<TaskData>> batch;
+  std::vector<char> statuses;
+  BatchAttr::Mode mode = BatchAttr::AUTO;
+
+  bool run_task(size_t index, TaskData::StateOfTesting state_of_testing);
+  // run problems [begin, end), returns time in seconds
+  double run_inter_task(size_t begin, size_t end, int num_threads, TaskData::StateOfTesting state_of_testing);
+  double run_intra_task(size_t begin, size_t end, TaskData::StateOfTesting state_of_testing);
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_BATCH_INCLUDE_BATCH_HPP_
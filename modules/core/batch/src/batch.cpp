@@ -0,0 +1,93 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/batch/include/batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+#include "core/threads/include/thread_pool.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace {
+
+double current_time() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+ppc::core::BatchExecutor::BatchExecutor(TaskFactory factory_, std::vector<std::shared_ptr<TaskData>> batch_)
+    : factory(std::move(factory_)), batch(std::move(batch_)), statuses(batch.size(), 0) {}
+
+bool ppc::core::BatchExecutor::run(const std::shared_ptr<BatchAttr>& batchAttr) {
+  std::fill(statuses.begin(), statuses.end(), 0);
+  int num_threads = batchAttr->num_threads > 0 ? batchAttr->num_threads : get_num_threads();
+  auto state_of_testing = batchAttr->state_of_testing;
+
+  mode = batchAttr->mode;
+  size_t begin = 0;
+  if (mode == BatchAttr::AUTO) {
+    // every mode gets the same number of problems, inter-task mode needs at
+    // least one problem per worker to show its throughput
+    auto calibration_size = std::min(static_cast<size_t>(num_threads), batch.size() / 2);
+    if (num_threads == 1 || calibration_size == 0) {
+      mode = BatchAttr::INTRA_TASK;
+    } else {
+      auto intra_time = run_intra_task(0, calibration_size, state_of_testing);
+      auto inter_time = run_inter_task(calibration_size, 2 * calibration_size, num_threads, state_of_testing);
+      mode = inter_time < intra_time ? BatchAttr::INTER_TASK : BatchAttr::INTRA_TASK;
+      begin = 2 * calibration_size;
+    }
+  }
+
+  if (mode == BatchAttr::INTER_TASK) {
+    run_inter_task(begin, batch.size(), num_threads, state_of_testing);
+  } else {
+    run_intra_task(begin, batch.size(), state_of_testing);
+  }
+  return std::all_of(statuses.begin(), statuses.end(), [](char status) { return status != 0; });
+}
+
+std::vector<bool> ppc::core::BatchExecutor::get_statuses() const {
+  return std::vector<bool>(statuses.begin(), statuses.end());
+}
+
+bool ppc::core::BatchExecutor::run_task(size_t index, TaskData::StateOfTesting state_of_testing) {
+  auto task = factory(batch[index]);
+  task->get_data()->state_of_testing = state_of_testing;
+  // stages after a failed one aren't called: an invalid problem may be read
+  // out of its bounds by them
+  bool status = task->validation() && task->pre_processing() && task->run() && task->post_processing();
+  statuses[index] = static_cast<char>(status);
+  return status;
+}
+
+double ppc::core::BatchExecutor::run_inter_task(size_t begin, size_t end, int num_threads,
+                                                TaskData::StateOfTesting state_of_testing) {
+  auto start = current_time();
+  std::atomic<size_t> next(begin);
+  auto worker = [&] {
+    ThreadsLimit limit(1);
+    for (auto index = next++; index < end; index = next++) {
+      run_task(index, state_of_testing);
+    }
+  };
+
+  auto num_workers = std::min(static_cast<size_t>(num_threads), end - begin);
+  TaskGroup group;
+  for (size_t i = 1; i < num_workers; i++) {
+    group.run(worker);
+  }
+  if (num_workers > 0) worker();
+  group.wait();
+  return current_time() - start;
+}
+
+double ppc::core::BatchExecutor::run_intra_task(size_t begin, size_t end, TaskData::StateOfTesting state_of_testing) {
+  auto start = current_time();
+  for (auto index = begin; index < end; index++) {
+    run_task(index, state_of_testing);
+  }
+  return current_time() - start;
+}
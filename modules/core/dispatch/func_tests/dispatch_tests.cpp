@@ -0,0 +1,229 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/dispatch/include/dispatch.hpp"
+
+namespace {
+
+// Task which takes fixed overhead plus time per element of input
+template <int OverheadUs, int ElementUs>
+class SleepTask : public ppc::core::Task {
+ public:
+  explicit SleepTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] == 1;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    auto size = static_cast<int>(taskData->inputs_count[0]);
+    std::this_thread::sleep_for(std::chrono::microseconds(OverheadUs + ElementUs * size));
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    reinterpret_cast<uint32_t *>(taskData->outputs[0])[0] = taskData->inputs_count[0];
+    return true;
+  }
+};
+
+// sequential one is faster up to ~100 elements
+using SeqTask = SleepTask<0, 40>;
+using ParallelTask = SleepTask<4000, 0>;
+
+// The fastest one, but it accepts no data
+class RejectingTask : public SleepTask<0, 0> {
+ public:
+  using SleepTask::SleepTask;
+  bool validation() override {
+    SleepTask::validation();
+    return false;
+  }
+};
+
+class DispatchData {
+ public:
+  std::shared_ptr<ppc::core::TaskData> make_data(uint64_t size) {
+    in.assign(size, 1);
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+    taskData->inputs_count.emplace_back(in.size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+    taskData->outputs_count.emplace_back(1);
+    return taskData;
+  }
+
+  // input of size * size elements, like a matrix of the given side
+  std::shared_ptr<ppc::core::TaskData> make_square_data(uint64_t side) { return make_data(side * side); }
+
+  std::vector<uint32_t> in;
+  uint32_t out = 0;
+};
+
+std::shared_ptr<ppc::core::PerfAttr> make_perf_attr() {
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->current_timer = [] {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  };
+  return perfAttr;
+}
+
+void register_sleep_tasks(ppc::core::TaskRegistry &registry) {
+  registry.add("sleep", "seq", [](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<SeqTask>(std::move(taskData));
+  });
+  registry.add("sleep", "omp", [](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<ParallelTask>(std::move(taskData));
+  });
+}
+
+ppc::core::TaskRegistration<SeqTask> registration("dispatch_tests_sleep", "seq");
+
+}  // namespace
+
+TEST(dispatch_tests, check_registry) {
+  ppc::core::TaskRegistry registry;
+  register_sleep_tasks(registry);
+  EXPECT_EQ(registry.get_backends("sleep"), std::vector<std::string>({"omp", "seq"}));
+  EXPECT_TRUE(registry.get_backends("unknown").empty());
+  EXPECT_THROW(registry.add("sleep", "seq", nullptr), std::invalid_argument);
+
+  DispatchData data;
+  EXPECT_THROW(static_cast<void>(registry.create("sleep", "tbb", data.make_data(1))), std::out_of_range);
+  EXPECT_NE(registry.create("sleep", "omp", data.make_data(1)), nullptr);
+}
+
+TEST(dispatch_tests, check_static_registration) {
+  EXPECT_EQ(ppc::core::TaskRegistry::instance().get_backends("dispatch_tests_sleep"),
+            std::vector<std::string>({"seq"}));
+}
+
+TEST(dispatch_tests, check_default_backend) {
+  ppc::core::TaskRegistry registry;
+  register_sleep_tasks(registry);
+  ppc::core::Dispatcher dispatcher("sleep", registry);
+  DispatchData data;
+  EXPECT_EQ(dispatcher.select(*data.make_data(1000)), "seq");
+}
+
+TEST(dispatch_tests, check_calibration) {
+  ppc::core::TaskRegistry registry;
+  register_sleep_tasks(registry);
+  ppc::core::Dispatcher dispatcher("sleep", registry);
+  DispatchData data;
+
+  ppc::core::DispatchAttr dispatchAttr;
+  dispatchAttr.sizes = {10, 25, 400, 800};
+  dispatchAttr.make_data = [&](uint64_t size) { return data.make_data(size); };
+  dispatchAttr.perf_attr = make_perf_attr();
+  dispatcher.calibrate(dispatchAttr);
+
+  ASSERT_EQ(dispatcher.get_crossovers().size(), 2U);
+  EXPECT_EQ(dispatcher.get_crossovers()[0].backend, "seq");
+  EXPECT_EQ(dispatcher.get_crossovers()[1].backend, "omp");
+  EXPECT_EQ(dispatcher.get_crossovers()[1].min_size, 100U);
+  EXPECT_EQ(dispatcher.get_calibration().size(), 4U);
+
+  EXPECT_EQ(dispatcher.select(*data.make_data(5)), "seq");
+  EXPECT_EQ(dispatcher.select(*data.make_data(99)), "seq");
+  EXPECT_EQ(dispatcher.select(*data.make_data(100)), "omp");
+  EXPECT_EQ(dispatcher.select(*data.make_data(5000)), "omp");
+
+  auto task = dispatcher.create(data.make_data(20));
+  ASSERT_TRUE(task->validation());
+  ASSERT_TRUE(task->pre_processing());
+  ASSERT_TRUE(task->run());
+  ASSERT_TRUE(task->post_processing());
+  EXPECT_EQ(data.out, 20U);
+}
+
+TEST(dispatch_tests, check_calibration_by_size_of_data) {
+  ppc::core::TaskRegistry registry;
+  register_sleep_tasks(registry);
+  ppc::core::Dispatcher dispatcher("sleep", registry);
+  DispatchData data;
+
+  // sides of squares, routing compares sums of inputs_count, i.e. areas
+  ppc::core::DispatchAttr dispatchAttr;
+  dispatchAttr.sizes = {3, 5, 20, 28};
+  dispatchAttr.make_data = [&](uint64_t side) { return data.make_square_data(side); };
+  dispatchAttr.perf_attr = make_perf_attr();
+  dispatcher.calibrate(dispatchAttr);
+
+  ASSERT_EQ(dispatcher.get_crossovers().size(), 2U);
+  EXPECT_EQ(dispatcher.get_crossovers()[1].min_size, 100U);
+  EXPECT_EQ(dispatcher.get_calibration().count(784), 1U);
+  EXPECT_EQ(dispatcher.select(*data.make_square_data(9)), "seq");
+  EXPECT_EQ(dispatcher.select(*data.make_square_data(10)), "omp");
+}
+
+TEST(dispatch_tests, check_calibration_skips_rejecting_backend) {
+  ppc::core::TaskRegistry registry;
+  register_sleep_tasks(registry);
+  registry.add("sleep", "tbb", [](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<RejectingTask>(std::move(taskData));
+  });
+  ppc::core::Dispatcher dispatcher("sleep", registry);
+  DispatchData data;
+
+  ppc::core::DispatchAttr dispatchAttr;
+  dispatchAttr.sizes = {10, 800};
+  dispatchAttr.make_data = [&](uint64_t size) { return data.make_data(size); };
+  dispatchAttr.perf_attr = make_perf_attr();
+  dispatcher.calibrate(dispatchAttr);
+
+  for (const auto &crossover : dispatcher.get_crossovers()) EXPECT_NE(crossover.backend, "tbb");
+  for (const auto &[size, times] : dispatcher.get_calibration()) EXPECT_EQ(times.count("tbb"), 0U);
+
+  ppc::core::TaskRegistry rejecting;
+  rejecting.add("sleep", "tbb", [](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<RejectingTask>(std::move(taskData));
+  });
+  ppc::core::Dispatcher nothing("sleep", rejecting);
+  EXPECT_THROW(nothing.calibrate(dispatchAttr), std::runtime_error);
+}
+
+TEST(dispatch_tests, check_save_and_load) {
+  ppc::core::TaskRegistry registry;
+  register_sleep_tasks(registry);
+  std::string path = testing::TempDir() + "dispatch_tests_crossovers.txt";
+  {
+    std::ofstream output(path, std::ios::trunc);
+    output << "other_problem tbb 0" << std::endl;
+    output << "sleep seq 0" << std::endl;
+    output << "sleep omp 1000" << std::endl;
+  }
+
+  ppc::core::Dispatcher dispatcher("sleep", registry);
+  ASSERT_TRUE(dispatcher.load(path));
+  DispatchData data;
+  EXPECT_EQ(dispatcher.select(*data.make_data(999)), "seq");
+  EXPECT_EQ(dispatcher.select(*data.make_data(1000)), "omp");
+
+  ppc::core::Dispatcher other("missing", registry);
+  EXPECT_FALSE(other.load(path));
+
+  // lines of other problems are kept on save
+  dispatcher.save(path);
+  ppc::core::Dispatcher other_problem("other_problem", registry);
+  EXPECT_TRUE(other_problem.load(path));
+  ppc::core::Dispatcher reloaded("sleep", registry);
+  ASSERT_TRUE(reloaded.load(path));
+  EXPECT_EQ(reloaded.get_crossovers().size(), 2U);
+  std::remove(path.c_str());
+}
@@ -0,0 +1,110 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_DISPATCH_INCLUDE_DISPATCH_HPP_
+#define MODULES_CORE_DISPATCH_INCLUDE_DISPATCH_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Implementations of the same problem registered under one key, e.g.
+// "sobel" -> {"seq", "omp", "tbb", "stl"}
+class TaskRegistry {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>)>;
+
+  // Registry of the process used by TaskRegistration
+  static TaskRegistry& instance();
+
+  // Throws std::invalid_argument if the backend of the problem is registered
+  void add(const std::string& problem, const std::string& backend, TaskFactory factory);
+  [[nodiscard]] std::vector<std::string> get_backends(const std::string& problem) const;
+  // Throws std::out_of_range if the backend of the problem is not registered
+  [[nodiscard]] std::shared_ptr<Task> create(const std::string& problem, const std::string& backend,
+                                             std::shared_ptr<TaskData> taskData) const;
+
+ private:
+  mutable std::mutex mutex;
+  std::map<std::string, std::map<std::string, TaskFactory>> factories;
+};
+
+// Registration of a task at static initialization of its translation unit:
+// static ppc::core::TaskRegistration<SobelOMP> registration("sobel", "omp");
+template <class TaskType>
+class TaskRegistration {
+ public:
+  TaskRegistration(const std::string& problem, const std::string& backend) {
+    TaskRegistry::instance().add(problem, backend, [](std::shared_ptr<TaskData> taskData) {
+      return std::make_shared<TaskType>(std::move(taskData));
+    });
+  }
+};
+
+struct DispatchAttr {
+  // sizes of calibration problems, get_size of their TaskData must ascend
+  std::vector<uint64_t> sizes;
+  // TaskData of the given size, its buffers must stay valid until the next
+  // call. It is made once per size and shared by all backends
+  std::function<std::shared_ptr<TaskData>(uint64_t)> make_data;
+  // measurement of every backend with Perf::pipeline_run, 5 runs after one
+  // warmup with steady clock if it is empty
+  std::shared_ptr<PerfAttr> perf_attr;
+  // size of TaskData used for routing, sum of inputs_count if it is empty
+  std::function<uint64_t(const TaskData&)> get_size;
+};
+
+// Routes TaskData of a problem to the backend which was the fastest one for
+// its size during calibration
+class Dispatcher {
+ public:
+  // backend is used for sizes starting from min_size up to the next crossover
+  struct Crossover {
+    uint64_t min_size = 0;
+    std::string backend;
+  };
+
+  explicit Dispatcher(std::string problem_, const TaskRegistry& registry_ = TaskRegistry::instance());
+
+  // Measure all registered backends on every size of attributes, median
+  // times are compared. Backends whose validation rejects the data are
+  // skipped, std::runtime_error if all of them do. Crossovers are placed at
+  // geometric means of get_size of neighbouring points with different winners
+  void calibrate(const DispatchAttr& dispatchAttr);
+
+  // "seq" (or the first registered backend) until calibrated or loaded
+  [[nodiscard]] std::string select(const TaskData& taskData) const;
+  [[nodiscard]] std::shared_ptr<Task> create(std::shared_ptr<TaskData> taskData) const;
+
+  [[nodiscard]] const std::vector<Crossover>& get_crossovers() const { return crossovers; }
+  // median time of every backend by get_size of every calibration point of
+  // the last calibrate()
+  [[nodiscard]] const std::map<uint64_t, std::map<std::string, double>>& get_calibration() const {
+    return calibration;
+  }
+
+  // Crossovers are stored as "problem backend min_size" lines, lines of other
+  // problems of the file are kept
+  void save(const std::string& path) const;
+  // Returns false if the file has no crossovers of the problem
+  bool load(const std::string& path);
+
+ private:
+  std::string problem;
+  const TaskRegistry& registry;
+  std::function<uint64_t(const TaskData&)> get_size;
+  std::vector<Crossover> crossovers;
+  std::map<uint64_t, std::map<std::string, double>> calibration;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_DISPATCH_INCLUDE_DISPATCH_HPP_
@@ -0,0 +1,166 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/dispatch/include/dispatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+uint64_t sum_of_inputs_count(const ppc::core::TaskData& taskData) {
+  return std::accumulate(taskData.inputs_count.begin(), taskData.inputs_count.end(), uint64_t{0});
+}
+
+}  // namespace
+
+ppc::core::TaskRegistry& ppc::core::TaskRegistry::instance() {
+  static TaskRegistry registry;
+  return registry;
+}
+
+void ppc::core::TaskRegistry::add(const std::string& problem, const std::string& backend, TaskFactory factory) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!factories[problem].emplace(backend, std::move(factory)).second) {
+    throw std::invalid_argument("Task " + problem + " is already registered for backend " + backend);
+  }
+}
+
+std::vector<std::string> ppc::core::TaskRegistry::get_backends(const std::string& problem) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::vector<std::string> backends;
+  auto problem_factories = factories.find(problem);
+  if (problem_factories != factories.end()) {
+    for (const auto& [backend, factory] : problem_factories->second) {
+      backends.push_back(backend);
+    }
+  }
+  return backends;
+}
+
+std::shared_ptr<ppc::core::Task> ppc::core::TaskRegistry::create(const std::string& problem,
+                                                                 const std::string& backend,
+                                                                 std::shared_ptr<TaskData> taskData) const {
+  TaskFactory factory;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto problem_factories = factories.find(problem);
+    if (problem_factories == factories.end() || problem_factories->second.count(backend) == 0) {
+      throw std::out_of_range("Task " + problem + " is not registered for backend " + backend);
+    }
+    factory = problem_factories->second.at(backend);
+  }
+  return factory(std::move(taskData));
+}
+
+ppc::core::Dispatcher::Dispatcher(std::string problem_, const TaskRegistry& registry_)
+    : problem(std::move(problem_)), registry(registry_), get_size(sum_of_inputs_count) {}
+
+void ppc::core::Dispatcher::calibrate(const DispatchAttr& dispatchAttr) {
+  if (dispatchAttr.get_size) get_size = dispatchAttr.get_size;
+  auto perfAttr = dispatchAttr.perf_attr ? dispatchAttr.perf_attr : std::make_shared<PerfAttr>();
+  if (!dispatchAttr.perf_attr) {
+    perfAttr->num_running = 5;
+    perfAttr->num_warmup = 1;
+    perfAttr->current_timer = [] {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+  }
+
+  calibration.clear();
+  crossovers.clear();
+  auto backends = registry.get_backends(problem);
+  uint64_t prev_size = 0;
+  for (auto attr_size : dispatchAttr.sizes) {
+    // crossovers are compared with get_size of TaskData in select, so the
+    // point is placed by it rather than by the size of attributes
+    auto taskData = dispatchAttr.make_data(attr_size);
+    auto size = get_size(*taskData);
+    std::string best_backend;
+    double best_time = std::numeric_limits<double>::infinity();
+    for (const auto& backend : backends) {
+      // a backend rejecting the data can't serve it however fast it fails
+      if (!registry.create(problem, backend, taskData)->validation()) continue;
+      auto perfResults = std::make_shared<PerfResults>();
+      Perf perf(registry.create(problem, backend, taskData));
+      perf.pipeline_run(perfAttr, perfResults);
+      calibration[size][backend] = perfResults->median_sec;
+      if (perfResults->median_sec < best_time) {
+        best_time = perfResults->median_sec;
+        best_backend = backend;
+      }
+    }
+    if (best_backend.empty()) {
+      throw std::runtime_error("No backend of task " + problem + " accepts data of size " + std::to_string(size));
+    }
+
+    if (crossovers.empty()) {
+      crossovers.push_back({0, best_backend});
+    } else if (crossovers.back().backend != best_backend) {
+      auto min_size = static_cast<uint64_t>(std::sqrt(static_cast<double>(prev_size) * static_cast<double>(size)));
+      crossovers.push_back({std::max(min_size, prev_size + 1), best_backend});
+    }
+    prev_size = size;
+  }
+}
+
+std::string ppc::core::Dispatcher::select(const TaskData& taskData) const {
+  if (crossovers.empty()) {
+    auto backends = registry.get_backends(problem);
+    if (backends.empty()) throw std::out_of_range("Task " + problem + " is not registered");
+    return std::find(backends.begin(), backends.end(), "seq") != backends.end() ? "seq" : backends.front();
+  }
+  auto size = get_size(taskData);
+  auto crossover = std::upper_bound(crossovers.begin(), crossovers.end(), size,
+                                    [](uint64_t value, const Crossover& current) { return value < current.min_size; });
+  return std::prev(crossover)->backend;
+}
+
+std::shared_ptr<ppc::core::Task> ppc::core::Dispatcher::create(std::shared_ptr<TaskData> taskData) const {
+  auto backend = select(*taskData);
+  return registry.create(problem, backend, std::move(taskData));
+}
+
+void ppc::core::Dispatcher::save(const std::string& path) const {
+  std::vector<std::string> lines;
+  std::ifstream input(path);
+  for (std::string line; std::getline(input, line);) {
+    std::string line_problem;
+    std::istringstream(line) >> line_problem;
+    if (!line.empty() && line_problem != problem) lines.push_back(line);
+  }
+  input.close();
+
+  std::ofstream output(path, std::ios::trunc);
+  for (const auto& line : lines) {
+    output << line << std::endl;
+  }
+  for (const auto& crossover : crossovers) {
+    output << problem << " " << crossover.backend << " " << crossover.min_size << std::endl;
+  }
+}
+
+bool ppc::core::Dispatcher::load(const std::string& path) {
+  std::vector<Crossover> loaded;
+  std::ifstream input(path);
+  for (std::string line; std::getline(input, line);) {
+    std::string line_problem;
+    Crossover crossover;
+    std::istringstream fields(line);
+    if (fields >> line_problem >> crossover.backend >> crossover.min_size && line_problem == problem) {
+      loaded.push_back(crossover);
+    }
+  }
+  if (loaded.empty()) return false;
+  std::sort(loaded.begin(), loaded.end(),
+            [](const Crossover& a, const Crossover& b) { return a.min_size < b.min_size; });
+  loaded.front().min_size = 0;
+  crossovers = std::move(loaded);
+  return true;
+}
@@ -1,6 +1,7 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <stdexcept>
 #include <vector>
 
 #include "core/perf/func_tests/test_task.hpp"
@@ -155,3 +156,522 @@ TEST(perf_tests, check_perf_task_float) {
   ASSERT_LE(perfResults->time_sec, 10.0);
   EXPECT_EQ(out[0], in.size());
 }
+
+TEST(perf_tests, check_perf_pipeline_samples) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with a fake timer: every iteration takes one "second"
+  double ticks = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->num_warmup = 5;
+  perfAttr->current_timer = [&] { return ticks++; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  ASSERT_EQ(perfResults->samples.size(), perfAttr->num_running);
+  EXPECT_DOUBLE_EQ(perfResults->time_sec, 10.0);
+  EXPECT_DOUBLE_EQ(perfResults->min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->median_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->p99_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->stddev_sec, 0.0);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_task_percentiles) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with a fake timer: i-th iteration takes i "seconds"
+  double time = 0.0;
+  double step = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 101;
+  perfAttr->current_timer = [&] { return time += step++; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+
+  ASSERT_EQ(perfResults->samples.size(), perfAttr->num_running);
+  EXPECT_DOUBLE_EQ(perfResults->min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->max_sec, 101.0);
+  EXPECT_DOUBLE_EQ(perfResults->mean_sec, 51.0);
+  EXPECT_DOUBLE_EQ(perfResults->median_sec, 51.0);
+  EXPECT_DOUBLE_EQ(perfResults->p90_sec, 91.0);
+  EXPECT_DOUBLE_EQ(perfResults->p99_sec, 100.0);
+  EXPECT_GT(perfResults->stddev_sec, 0.0);
+}
+
+TEST(perf_tests, check_strong_scaling) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with a fake timer: iteration time is 1 / num_threads
+  double time = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->current_timer = [&] { return time += 1.0 / ppc::core::get_num_threads(); };
+
+  // Create scaling attributes and results
+  auto scalingAttr = std::make_shared<ppc::core::ScalingAttr>();
+  scalingAttr->num_threads = {1, 2, 4};
+  auto scalingResults = std::make_shared<ppc::core::ScalingResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.scaling_run(perfAttr, scalingAttr, scalingResults);
+
+  ASSERT_EQ(scalingResults->points.size(), scalingAttr->num_threads.size());
+  EXPECT_FALSE(scalingResults->weak_scaling);
+  for (const auto &point : scalingResults->points) {
+    EXPECT_EQ(point.perf_results.type_of_running, ppc::core::PerfResults::TypeOfRunning::PIPELINE);
+    EXPECT_NEAR(point.speedup, point.num_threads, 1e-9);
+    EXPECT_NEAR(point.efficiency, 1.0, 1e-9);
+  }
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_scaling_of_ignored_threads) {
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  double time = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->current_timer = [&] { return time += 1.0; };
+
+  // backend stays at one thread whatever the sweep applies
+  auto scalingAttr = std::make_shared<ppc::core::ScalingAttr>();
+  scalingAttr->num_threads = {1, 2};
+  scalingAttr->apply_num_threads = [](int) { return std::shared_ptr<void>(); };
+  scalingAttr->get_num_threads = [] { return 1; };
+  auto scalingResults = std::make_shared<ppc::core::ScalingResults>();
+
+  ppc::core::Perf perfAnalyzer(testTask);
+  EXPECT_THROW(perfAnalyzer.scaling_run(perfAttr, scalingAttr, scalingResults), std::runtime_error);
+}
+
+TEST(perf_tests, check_weak_scaling) {
+  // Create data for every point, problem size grows with thread count
+  std::vector<std::vector<uint32_t>> in;
+  in.reserve(4);
+  std::vector<uint32_t> out(1, 0);
+  auto make_task = [&](int num_threads) {
+    in.emplace_back(num_threads * 1000, 1);
+
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.back().data()));
+    taskData->inputs_count.emplace_back(in.back().size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskData->outputs_count.emplace_back(out.size());
+    return std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+  };
+
+  // Create Perf attributes with a fake timer: iteration time doesn't depend on threads
+  double time = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->current_timer = [&] { return time += 1.0; };
+
+  // Create scaling attributes and results
+  auto scalingAttr = std::make_shared<ppc::core::ScalingAttr>();
+  scalingAttr->num_threads = {1, 2, 4};
+  scalingAttr->make_task = make_task;
+  auto scalingResults = std::make_shared<ppc::core::ScalingResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(make_task(1));
+  perfAnalyzer.scaling_run(perfAttr, scalingAttr, scalingResults, ppc::core::PerfResults::TypeOfRunning::TASK_RUN);
+
+  ASSERT_EQ(scalingResults->points.size(), scalingAttr->num_threads.size());
+  EXPECT_TRUE(scalingResults->weak_scaling);
+  for (const auto &point : scalingResults->points) {
+    EXPECT_EQ(point.perf_results.type_of_running, ppc::core::PerfResults::TypeOfRunning::TASK_RUN);
+    EXPECT_NEAR(point.speedup, point.num_threads, 1e-9);
+    EXPECT_NEAR(point.efficiency, 1.0, 1e-9);
+  }
+  EXPECT_EQ(out[0], in.back().size());
+}
+
+TEST(perf_tests, check_perf_record) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with a fake timer: every iteration takes 0.1 "second"
+  double time = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->pinning = ppc::core::PinningPolicy::COMPACT;
+  perfAttr->current_timer = [&] { return time += 0.1; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto pinning = ppc::core::get_pinning_policy();
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+
+  // policy is applied only during the run
+  EXPECT_EQ(ppc::core::get_pinning_policy(), pinning);
+  EXPECT_EQ(perfResults->pinning, ppc::core::PinningPolicy::COMPACT);
+  EXPECT_EQ(perfResults->problem_size, in.size());
+  EXPECT_EQ(perfResults->num_threads, ppc::core::get_num_threads());
+
+  auto json = ppc::core::Perf::get_perf_record(perfResults, "tasks/omp/example", ppc::core::PerfOutputFormat::JSON);
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_EQ(json.back(), '}');
+  EXPECT_NE(json.find(R"("task":"tasks/omp/example","backend":"omp","type":"pipeline")"), std::string::npos);
+  EXPECT_NE(json.find(R"("problem_size":2000,"num_running":10)"), std::string::npos);
+  EXPECT_NE(json.find(R"("pinning":"compact")"), std::string::npos);
+
+  auto csv = ppc::core::Perf::get_perf_record(perfResults, "tasks/omp/example", ppc::core::PerfOutputFormat::CSV);
+  auto header = ppc::core::Perf::get_perf_record_header(ppc::core::PerfOutputFormat::CSV);
+  EXPECT_EQ(csv.rfind(R"("tasks/omp/example","omp",pipeline,)", 0), 0U);
+  EXPECT_EQ(header.rfind("task,backend,type,", 0), 0U);
+}
+
+TEST(perf_tests, check_perf_hw_counters) {
+  // Create data
+  std::vector<uint32_t> in(200000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->collect_hw_counters = true;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+
+  // counters are optional: they can be forbidden in containers and VMs
+  const auto &hw = perfResults->hw_counters;
+  if (hw.available) {
+    EXPECT_GT(hw.instructions, 0U);
+    EXPECT_GT(hw.ipc, 0.0);
+  } else {
+    EXPECT_EQ(hw.instructions, 0U);
+    EXPECT_EQ(hw.ipc, 0.0);
+  }
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_pipeline_stages) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with a fake timer: every timer call takes 0.01 "second"
+  double time = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->num_warmup = 2;
+  perfAttr->collect_stage_times = true;
+  perfAttr->current_timer = [&] { return time += 0.01; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+
+  ASSERT_EQ(perfResults->stage_samples.size(), perfAttr->num_running);
+  for (const auto &stage_times : perfResults->stage_samples) {
+    EXPECT_NEAR(stage_times.validation, 0.01, 1e-9);
+    EXPECT_NEAR(stage_times.pre_processing, 0.01, 1e-9);
+    EXPECT_NEAR(stage_times.run, 0.01, 1e-9);
+    EXPECT_NEAR(stage_times.post_processing, 0.01, 1e-9);
+  }
+  EXPECT_NEAR(perfResults->stage_mean.run, 0.01, 1e-9);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_batch) {
+  // Create data
+  std::vector<std::vector<uint32_t>> in(16, std::vector<uint32_t>(2000, 1));
+  std::vector<std::vector<uint32_t>> out(16, std::vector<uint32_t>(1, 0));
+
+  // Create batch of TaskData
+  std::vector<std::shared_ptr<ppc::core::TaskData>> batch;
+  for (size_t i = 0; i < in.size(); i++) {
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in[i].data()));
+    taskData->inputs_count.emplace_back(in[i].size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out[i].data()));
+    taskData->outputs_count.emplace_back(out[i].size());
+    batch.push_back(taskData);
+  }
+
+  // Create batch executor
+  auto batchExecutor = std::make_shared<ppc::core::BatchExecutor>(
+      [](std::shared_ptr<ppc::core::TaskData> taskData) {
+        return std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+      },
+      batch);
+  auto batchAttr = std::make_shared<ppc::core::BatchAttr>();
+  batchAttr->num_threads = 2;
+
+  // Create Perf attributes with a fake timer: every batch takes 0.5 "second"
+  double time = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 4;
+  perfAttr->current_timer = [&] { return time += 0.5; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  ppc::core::Perf::batch_run(perfAttr, batchExecutor, batchAttr, perfResults);
+
+  EXPECT_EQ(perfResults->type_of_running, ppc::core::PerfResults::TypeOfRunning::BATCH);
+  EXPECT_EQ(perfResults->problem_size, batch.size());
+  EXPECT_DOUBLE_EQ(perfResults->items_per_sec, 32.0);
+  EXPECT_EQ(batchAttr->mode, ppc::core::BatchAttr::AUTO);
+  for (size_t i = 0; i < in.size(); i++) {
+    EXPECT_EQ(out[i][0], in[i].size());
+  }
+}
+
+TEST(perf_tests, check_perf_stream) {
+  // Create data
+  std::vector<std::vector<uint32_t>> in(8, std::vector<uint32_t>(2000, 1));
+  std::vector<std::vector<uint32_t>> out(8, std::vector<uint32_t>(1, 0));
+
+  // Create stream of TaskData
+  std::vector<std::shared_ptr<ppc::core::TaskData>> stream;
+  for (size_t i = 0; i < in.size(); i++) {
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in[i].data()));
+    taskData->inputs_count.emplace_back(in[i].size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out[i].data()));
+    taskData->outputs_count.emplace_back(out[i].size());
+    stream.push_back(taskData);
+  }
+
+  // Create stream executor
+  auto streamExecutor = std::make_shared<ppc::core::StreamExecutor>(
+      [](std::shared_ptr<ppc::core::TaskData> taskData) {
+        return std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+      },
+      stream);
+  auto streamAttr = std::make_shared<ppc::core::StreamAttr>();
+
+  // Create Perf attributes with a fake timer, throughput is measured by the
+  // executor itself
+  double time = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->num_warmup = 1;
+  perfAttr->current_timer = [&] { return time += 0.5; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  ppc::core::Perf::stream_run(perfAttr, streamExecutor, streamAttr, perfResults);
+
+  EXPECT_EQ(perfResults->type_of_running, ppc::core::PerfResults::TypeOfRunning::STREAM);
+  EXPECT_EQ(perfResults->problem_size, stream.size());
+  EXPECT_EQ(perfResults->samples.size(), 3U);
+  EXPECT_GT(perfResults->items_per_sec, 0.0);
+  for (size_t i = 0; i < in.size(); i++) {
+    ASSERT_EQ(out[i][0], in[i].size());
+  }
+}
+
+namespace {
+
+template <class T>
+class ScratchTestTask : public ppc::test::TestTask<T> {
+ public:
+  explicit ScratchTestTask(std::shared_ptr<ppc::core::TaskData> taskData_) : ppc::test::TestTask<T>(taskData_) {}
+  bool run() override {
+    bool status = ppc::test::TestTask<T>::run();
+    static_cast<void>(this->scratch().template allocate<T>(this->taskData->inputs_count[0]));
+    return status;
+  }
+};
+
+}  // namespace
+
+TEST(perf_tests, check_perf_scratch_bytes) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ScratchTestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->num_warmup = 1;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->scratch_bytes_per_run, in.size() * sizeof(uint32_t));
+
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->scratch_bytes_per_run, in.size() * sizeof(uint32_t));
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_geometric_sizes) {
+  EXPECT_EQ(ppc::core::SweepAttr::geometric_sizes(1, 16), std::vector<uint64_t>({1, 2, 4, 8, 16}));
+  EXPECT_EQ(ppc::core::SweepAttr::geometric_sizes(100, 1000, 3.0), std::vector<uint64_t>({100, 300, 900}));
+  EXPECT_EQ(ppc::core::SweepAttr::geometric_sizes(1, 4, 1.5), std::vector<uint64_t>({1, 2, 3}));
+  EXPECT_TRUE(ppc::core::SweepAttr::geometric_sizes(10, 1).empty());
+}
+
+TEST(perf_tests, check_perf_sweep) {
+  // Create data for every size of the sweep
+  std::vector<std::vector<uint32_t>> in;
+  std::vector<uint32_t> out(1, 0);
+
+  // Create Perf attributes with a fake timer: every iteration takes 1 second
+  double time = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->current_timer = [&] { return time += 1.0; };
+
+  // Create sweep attributes with the work model of the sum: one addition and
+  // four bytes per element
+  auto sweepAttr = std::make_shared<ppc::core::SweepAttr>();
+  sweepAttr->sizes = ppc::core::SweepAttr::geometric_sizes(1000, 8000);
+  sweepAttr->make_task = [&](uint64_t size) {
+    in.emplace_back(size, 1);
+
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.back().data()));
+    taskData->inputs_count.emplace_back(in.back().size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskData->outputs_count.emplace_back(out.size());
+    return std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+  };
+  sweepAttr->flops = [](uint64_t size) { return static_cast<double>(size); };
+  sweepAttr->bytes = [](uint64_t size) { return 4.0 * static_cast<double>(size); };
+
+  auto sweepResults = std::make_shared<ppc::core::SweepResults>();
+  sweepResults->roofline.peak_gflops = 1e-6;
+  sweepResults->roofline.bandwidth_gbs = 1e-6;
+  ppc::core::Perf::sweep_run(perfAttr, sweepAttr, sweepResults);
+
+  ASSERT_EQ(sweepResults->points.size(), 4U);
+  for (const auto &point : sweepResults->points) {
+    EXPECT_EQ(point.perf_results.type_of_running, ppc::core::PerfResults::TypeOfRunning::PIPELINE);
+    EXPECT_NEAR(point.perf_results.median_sec, 1.0, 1e-9);
+    EXPECT_NEAR(point.gflops, static_cast<double>(point.size) * 1e-9, 1e-15);
+    EXPECT_NEAR(point.gbytes_per_sec, 4.0 * static_cast<double>(point.size) * 1e-9, 1e-15);
+    EXPECT_NEAR(point.intensity, 0.25, 1e-12);
+    EXPECT_NEAR(point.attainable_gflops, 0.25e-6, 1e-15);
+  }
+  EXPECT_EQ(out[0], in.back().size());
+}
+
+TEST(perf_tests, check_roofline) {
+  ppc::core::Roofline roofline{10.0, 2.0};
+  EXPECT_NEAR(roofline.ridge_intensity(), 5.0, 1e-12);
+  EXPECT_NEAR(roofline.attainable_gflops(1.0), 2.0, 1e-12);
+  EXPECT_NEAR(roofline.attainable_gflops(100.0), 10.0, 1e-12);
+
+  // Small probes only check that the machine gives sane numbers
+  auto measured = ppc::core::Roofline::measure(3 * (1 << 20), 1);
+  EXPECT_GT(measured.peak_gflops, 0.0);
+  EXPECT_GT(measured.bandwidth_gbs, 0.0);
+}
@@ -0,0 +1,47 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_PERF_INCLUDE_HW_COUNTERS_HPP_
+#define MODULES_CORE_PERF_INCLUDE_HW_COUNTERS_HPP_
+
+#include <cstdint>
+#include <vector>
+
+namespace ppc::core {
+
+struct HwCounters {
+  // false if counters can't be opened (not Linux, perf_event_paranoid,
+  // container without CAP_PERFMON), then all values are zero
+  bool available = false;
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;
+  uint64_t branch_misses = 0;
+  double task_clock_sec = 0.0;
+  // instructions per cycle
+  double ipc = 0.0;
+  // memory traffic estimated by LLC misses (in bytes) per instruction
+  double bytes_per_op = 0.0;
+};
+
+// Linux perf_event counters of all threads of the process, threads created
+// after start() are counted through inheritance
+class HwCountersGroup {
+ public:
+  HwCountersGroup();
+  HwCountersGroup(const HwCountersGroup&) = delete;
+  HwCountersGroup& operator=(const HwCountersGroup&) = delete;
+  ~HwCountersGroup();
+
+  void start();
+  void stop();
+  [[nodiscard]] HwCounters read() const;
+
+ private:
+  enum Counter { CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES, TASK_CLOCK, NUM_COUNTERS };
+  // file descriptors of every counter for every thread
+  std::vector<int> descriptors[NUM_COUNTERS];
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_PERF_INCLUDE_HW_COUNTERS_HPP_
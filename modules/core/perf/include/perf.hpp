@@ -6,9 +6,16 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "core/batch/include/batch.hpp"
+#include "core/perf/include/hw_counters.hpp"
+#include "core/perf/include/roofline.hpp"
+#include "core/stream/include/stream.hpp"
 #include "core/task/include/task.hpp"
+#include "core/threads/include/numa.hpp"
+#include "core/threads/include/threads.hpp"
 
 namespace ppc {
 namespace core {
@@ -16,17 +23,123 @@ namespace core {
 struct PerfAttr {
   // count of task's running
   uint64_t num_running;
+  // count of task's running before measurement (not included in results)
+  uint64_t num_warmup = 0;
+  // collect hardware performance counters during measurement
+  bool collect_hw_counters = false;
+  // time every stage of the task separately in pipeline_run
+  bool collect_stage_times = false;
+  // placement of threads during the run, PPC_PINNING environment variable by default
+  PinningPolicy pinning = get_pinning_policy();
   std::function<double(void)> current_timer = [&] { return 0.0; };
 };
 
 struct PerfResults {
   // measurement of task's time (in seconds)
   double time_sec = 0.0;
-  enum TypeOfRunning { PIPELINE, TASK_RUN, NONE } type_of_running = NONE;
+  // per-iteration measurements (in seconds) and their statistics
+  std::vector<double> samples;
+  double min_sec = 0.0;
+  double max_sec = 0.0;
+  double mean_sec = 0.0;
+  double median_sec = 0.0;
+  double p90_sec = 0.0;
+  double p99_sec = 0.0;
+  double stddev_sec = 0.0;
+  // run metadata: threads of the backend and sum of task's inputs_count
+  int num_threads = 0;
+  uint64_t problem_size = 0;
+  // totals of all measured iterations, if collect_hw_counters is set
+  HwCounters hw_counters;
+  // per-iteration time (in seconds) of every stage, if collect_stage_times is set
+  struct StageTimes {
+    double validation = 0.0;
+    double pre_processing = 0.0;
+    double run = 0.0;
+    double post_processing = 0.0;
+  };
+  std::vector<StageTimes> stage_samples;
+  // mean time of every stage over measured iterations
+  StageTimes stage_mean;
+  // batch_run: problems of the batch processed per second
+  // stream_run: steady-state problems per second of the pipelined stream
+  double items_per_sec = 0.0;
+  // pipeline_run and task_run: bytes requested from scratch memory of the
+  // task per measured function call
+  uint64_t scratch_bytes_per_run = 0;
+  PinningPolicy pinning = PinningPolicy::NONE;
+  enum TypeOfRunning { PIPELINE, TASK_RUN, BATCH, STREAM, NONE } type_of_running = NONE;
   constexpr const static double MAX_TIME = 10.0;
   constexpr const static double MIN_TIME = 0.05;
 };
 
+struct ScalingAttr {
+  // thread counts to run the task with, e.g. {1, 2, 4, 8}
+  std::vector<int> num_threads;
+  // apply thread count to the backend, returned object keeps it alive
+  // (e.g. tbb::global_control) and restores the default one on destruction.
+  // The default one is for OpenMP and std::thread tasks, which take it from
+  // get_num_threads; TBB tasks set both hooks to the ones of tbb_threads.hpp
+  std::function<std::shared_ptr<void>(int)> apply_num_threads = [](int num_threads) {
+    set_num_threads(num_threads);
+    return std::shared_ptr<void>(nullptr, [](void*) { set_num_threads(0); });
+  };
+  // thread count the backend runs with once it is applied; scaling_run
+  // throws std::runtime_error if it differs, as speedup of a backend which
+  // ignores the count would be measured against itself
+  std::function<int()> get_num_threads = [] { return ppc::core::get_num_threads(); };
+  // weak scaling: create task with problem size scaled for the thread count,
+  // strong scaling on the task of Perf is used if it is empty
+  std::function<std::shared_ptr<Task>(int)> make_task;
+};
+
+struct ScalingResults {
+  struct Point {
+    int num_threads = 1;
+    PerfResults perf_results;
+    // relative to the first point of the sweep
+    double speedup = 0.0;
+    double efficiency = 0.0;
+  };
+  std::vector<Point> points;
+  bool weak_scaling = false;
+};
+
+struct SweepAttr {
+  // problem sizes of the sweep, e.g. geometric_sizes(1 << 10, 1 << 24)
+  std::vector<uint64_t> sizes;
+  // create task with initialized data of the given size
+  std::function<std::shared_ptr<Task>(uint64_t)> make_task;
+  // work model of the task: floating point operations and bytes of memory
+  // traffic for the size, a point gets zero rates if the model is empty
+  std::function<double(uint64_t)> flops;
+  std::function<double(uint64_t)> bytes;
+
+  // min_size, min_size * factor, ... up to max_size
+  static std::vector<uint64_t> geometric_sizes(uint64_t min_size, uint64_t max_size, double factor = 2.0);
+};
+
+struct SweepResults {
+  struct Point {
+    uint64_t size = 0;
+    PerfResults perf_results;
+    // rates by median time and work model
+    double gflops = 0.0;
+    double gbytes_per_sec = 0.0;
+    // FLOP per byte
+    double intensity = 0.0;
+    // roofline bound for the intensity, if the roofline is measured
+    double attainable_gflops = 0.0;
+  };
+  std::vector<Point> points;
+  // set it (e.g. by Roofline::measure()) before sweep_run to get attainable
+  // performance of points
+  Roofline roofline;
+};
+
+// Formats of machine-readable perf records
+enum class PerfOutputFormat { JSON, CSV };
+
 class Perf {
  public:
   // Init performance analysis with initialized task and initialized data
@@ -40,13 +153,49 @@ class Perf {
                     const std::shared_ptr<ppc::core::PerfResults>& perfResults);
   // Check performance of task's run() function
   void task_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<ppc::core::PerfResults>& perfResults);
-  // Pint results for automation checkers
+  // Check throughput of full pipeline over all problems of a batch, AUTO
+  // mode is resolved once before measurement
+  static void batch_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<BatchExecutor>& batchExecutor,
+                        const std::shared_ptr<BatchAttr>& batchAttr,
+                        const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  // Check throughput of a stream of problems with pre_processing() of the
+  // next problem overlapped with run() of the current one
+  static void stream_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                         const std::shared_ptr<StreamExecutor>& streamExecutor,
+                         const std::shared_ptr<StreamAttr>& streamAttr,
+                         const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  // Run pipeline_run() or task_run() for every thread count of scaling
+  // attributes and calculate speedup and efficiency of each point
+  void scaling_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<ScalingAttr>& scalingAttr,
+                   const std::shared_ptr<ScalingResults>& scalingResults,
+                   PerfResults::TypeOfRunning type_of_running = PerfResults::TypeOfRunning::PIPELINE);
+  // Run pipeline_run() or task_run() of tasks created for every size of the
+  // sweep and calculate GFLOP/s and GB/s of each point by the work model
+  static void sweep_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<SweepAttr>& sweepAttr,
+                        const std::shared_ptr<SweepResults>& sweepResults,
+                        PerfResults::TypeOfRunning type_of_running = PerfResults::TypeOfRunning::PIPELINE);
+  // Pint results for automation checkers. Besides stdout the record is
+  // appended to the file from PPC_PERF_OUTPUT environment variable if it is
+  // set, in the format from PPC_PERF_FORMAT ("json" lines by default or "csv")
   static void print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults);
+  // Machine-readable record of results with run metadata (one line)
+  static std::string get_perf_record(const std::shared_ptr<PerfResults>& perfResults, const std::string& task_path,
+                                     PerfOutputFormat format);
+  static std::string get_perf_record_header(PerfOutputFormat format);
+  static void print_scaling_statistic(const std::shared_ptr<ScalingResults>& scalingResults);
+  static void print_sweep_statistic(const std::shared_ptr<SweepResults>& sweepResults);
 
  private:
   std::shared_ptr<Task> task;
   static void common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
                          const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  static void calc_statistics(const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  void fill_run_info(const std::shared_ptr<ppc::core::PerfResults>& perfResults) const;
+  void fill_scratch_bytes(const std::shared_ptr<PerfAttr>& perfAttr,
+                          const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                          uint64_t scratch_bytes_before) const;
+  static std::string get_relative_path();
+  static std::string get_type_test_name(PerfResults::TypeOfRunning type_of_running);
 };
 
 }  // namespace core
@@ -0,0 +1,36 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_PERF_INCLUDE_ROOFLINE_HPP_
+#define MODULES_CORE_PERF_INCLUDE_ROOFLINE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ppc::core {
+
+// Roofline model of the machine: attainable performance of a kernel is
+// limited by peak compute or by memory bandwidth times its arithmetic
+// intensity (FLOP per byte of memory traffic)
+struct Roofline {
+  double peak_gflops = 0.0;
+  double bandwidth_gbs = 0.0;
+
+  [[nodiscard]] double attainable_gflops(double intensity) const {
+    return std::min(peak_gflops, bandwidth_gbs * intensity);
+  }
+  // intensity where kernels become compute bound
+  [[nodiscard]] double ridge_intensity() const { return bandwidth_gbs > 0.0 ? peak_gflops / bandwidth_gbs : 0.0; }
+
+  // Measure with built-in probes on get_num_threads() threads, best of
+  // repetitions: STREAM triad over three arrays of stream_bytes in total
+  // (should be several times larger than the last level cache) and
+  // independent multiply-add chains for peak FLOP/s, in FMA vectors of
+  // get_simd_level() from AVX2 on
+  static Roofline measure(size_t stream_bytes = size_t{3} * 64 * 1024 * 1024, int repetitions = 5);
+  static double measure_bandwidth_gbs(size_t stream_bytes, int repetitions);
+  static double measure_peak_gflops(int repetitions);
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_PERF_INCLUDE_ROOFLINE_HPP_
@@ -0,0 +1,116 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/hw_counters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#endif
+
+namespace {
+
+#ifdef __linux__
+int open_counter(uint32_t type, uint64_t config, int tid) {
+  perf_event_attr attr{};
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+}
+
+// value scaled by the time the counter was really counting (multiplexing)
+uint64_t read_counter(int fd) {
+  uint64_t values[3] = {0, 0, 0};
+  if (::read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0) return 0;
+  return static_cast<uint64_t>(static_cast<double>(values[0]) * static_cast<double>(values[1]) /
+                               static_cast<double>(values[2]));
+}
+#endif
+
+}  // namespace
+
+ppc::core::HwCountersGroup::HwCountersGroup() {
+#ifdef __linux__
+  const uint32_t types[NUM_COUNTERS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                        PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE};
+  const uint64_t configs[NUM_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                          PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+                                          PERF_COUNT_SW_TASK_CLOCK};
+
+  // already running threads (e.g. OpenMP or TBB workers) are opened one by one
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", error)) {
+    int tid = std::stoi(entry.path().filename().string());
+    for (int counter = 0; counter < NUM_COUNTERS; counter++) {
+      int fd = open_counter(types[counter], configs[counter], tid);
+      if (fd >= 0) descriptors[counter].push_back(fd);
+    }
+  }
+#endif
+}
+
+ppc::core::HwCountersGroup::~HwCountersGroup() {
+#ifdef __linux__
+  for (const auto& counter_descriptors : descriptors) {
+    for (auto fd : counter_descriptors) close(fd);
+  }
+#endif
+}
+
+void ppc::core::HwCountersGroup::start() {
+#ifdef __linux__
+  for (const auto& counter_descriptors : descriptors) {
+    for (auto fd : counter_descriptors) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+void ppc::core::HwCountersGroup::stop() {
+#ifdef __linux__
+  for (const auto& counter_descriptors : descriptors) {
+    for (auto fd : counter_descriptors) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+  }
+#endif
+}
+
+ppc::core::HwCounters ppc::core::HwCountersGroup::read() const {
+  HwCounters counters;
+#ifdef __linux__
+  uint64_t values[NUM_COUNTERS] = {0, 0, 0, 0, 0};
+  for (int counter = 0; counter < NUM_COUNTERS; counter++) {
+    for (auto fd : descriptors[counter]) values[counter] += read_counter(fd);
+  }
+
+  counters.available = !descriptors[CYCLES].empty() && !descriptors[INSTRUCTIONS].empty();
+  counters.cycles = values[CYCLES];
+  counters.instructions = values[INSTRUCTIONS];
+  counters.llc_misses = values[LLC_MISSES];
+  counters.branch_misses = values[BRANCH_MISSES];
+  counters.task_clock_sec = static_cast<double>(values[TASK_CLOCK]) * 1e-9;
+
+  long cache_line = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+  if (cache_line <= 0) cache_line = 64;
+  if (counters.cycles > 0) {
+    counters.ipc = static_cast<double>(counters.instructions) / static_cast<double>(counters.cycles);
+  }
+  if (counters.instructions > 0) {
+    counters.bytes_per_op = static_cast<double>(counters.llc_misses) * static_cast<double>(cache_line) /
+                            static_cast<double>(counters.instructions);
+  }
+#endif
+  return counters;
+}
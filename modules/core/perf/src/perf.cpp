@@ -3,11 +3,87 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 
+#ifndef PPC_CXX_FLAGS
+#define PPC_CXX_FLAGS ""
+#endif
+
+namespace {
+
+std::string get_env(const char* name) {
+#ifdef _MSC_VER
+  char* value = nullptr;
+  size_t size = 0;
+  if (_dupenv_s(&value, &size, name) != 0 || value == nullptr) return {};
+  std::string result(value);
+  free(value);
+  return result;
+#else
+  const char* value = std::getenv(name);
+  return value != nullptr ? std::string(value) : std::string();
+#endif
+}
+
+std::string get_compiler() {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc " + std::to_string(_MSC_VER);
+#else
+  return "unknown";
+#endif
+}
+
+std::string get_cpu_model() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.rfind("model name", 0) == 0) {
+      auto pos = line.find(':');
+      if (pos != std::string::npos && pos + 2 <= line.size()) return line.substr(pos + 2);
+    }
+  }
+  return "unknown";
+}
+
+std::string escape_json(const std::string& str) {
+  std::stringstream escaped;
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      escaped << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    } else {
+      escaped << c;
+    }
+  }
+  return escaped.str();
+}
+
+std::string escape_csv(const std::string& str) {
+  std::string escaped = "\"";
+  for (auto c : str) {
+    if (c == '"') escaped += '"';
+    escaped += c;
+  }
+  return escaped + "\"";
+}
+
+}  // namespace
+
 ppc::core::Perf::Perf(std::shared_ptr<Task> task_) { set_task(std::move(task_)); }
 
 void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
@@ -18,26 +94,63 @@ void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
 void ppc::core::Perf::pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                    const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
   perfResults->type_of_running = PerfResults::TypeOfRunning::PIPELINE;
+  PinningScope pinning(perfAttr->pinning);
+  perfResults->pinning = perfAttr->pinning;
+  fill_run_info(perfResults);
+  auto scratch_bytes = task->get_scratch_bytes();
+
+  if (!perfAttr->collect_stage_times) {
+    common_run(
+        perfAttr,
+        [&]() {
+          task->validation();
+          task->pre_processing();
+          task->run();
+          task->post_processing();
+        },
+        perfResults);
+    fill_scratch_bytes(perfAttr, perfResults, scratch_bytes);
+    return;
+  }
 
   common_run(
-      std::move(perfAttr),
+      perfAttr,
       [&]() {
+        PerfResults::StageTimes stage_times;
+        auto time_point = perfAttr->current_timer();
+        auto lap = [&]() {
+          auto current = perfAttr->current_timer();
+          auto duration = current - time_point;
+          time_point = current;
+          return duration;
+        };
         task->validation();
+        stage_times.validation = lap();
         task->pre_processing();
+        stage_times.pre_processing = lap();
         task->run();
+        stage_times.run = lap();
         task->post_processing();
+        stage_times.post_processing = lap();
+        perfResults->stage_samples.push_back(stage_times);
       },
-      std::move(perfResults));
+      perfResults);
+  fill_scratch_bytes(perfAttr, perfResults, scratch_bytes);
 }
 
 void ppc::core::Perf::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
   perfResults->type_of_running = PerfResults::TypeOfRunning::TASK_RUN;
+  PinningScope pinning(perfAttr->pinning);
+  perfResults->pinning = perfAttr->pinning;
+  fill_run_info(perfResults);
 
   task->validation();
   task->pre_processing();
+  auto scratch_bytes = task->get_scratch_bytes();
   common_run(
-      std::move(perfAttr), [&]() { task->run(); }, std::move(perfResults));
+      perfAttr, [&]() { task->run(); }, perfResults);
+  fill_scratch_bytes(perfAttr, perfResults, scratch_bytes);
   task->post_processing();
 
   task->validation();
@@ -46,37 +159,297 @@ void ppc::core::Perf::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
   task->post_processing();
 }
 
+void ppc::core::Perf::batch_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                                const std::shared_ptr<BatchExecutor>& batchExecutor,
+                                const std::shared_ptr<BatchAttr>& batchAttr,
+                                const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  perfResults->type_of_running = PerfResults::TypeOfRunning::BATCH;
+  PinningScope pinning(perfAttr->pinning);
+  perfResults->pinning = perfAttr->pinning;
+  perfResults->num_threads = batchAttr->num_threads > 0 ? batchAttr->num_threads : get_num_threads();
+  perfResults->problem_size = batchExecutor->size();
+
+  auto perfBatchAttr = std::make_shared<BatchAttr>(*batchAttr);
+  perfBatchAttr->state_of_testing = TaskData::StateOfTesting::PERF;
+  if (perfBatchAttr->mode == BatchAttr::AUTO) {
+    batchExecutor->run(perfBatchAttr);
+    perfBatchAttr->mode = batchExecutor->get_mode();
+  }
+
+  common_run(perfAttr, [&]() { batchExecutor->run(perfBatchAttr); }, perfResults);
+
+  if (perfResults->time_sec > 0.0) {
+    perfResults->items_per_sec =
+        static_cast<double>(batchExecutor->size() * perfAttr->num_running) / perfResults->time_sec;
+  }
+}
+
+void ppc::core::Perf::stream_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                                 const std::shared_ptr<StreamExecutor>& streamExecutor,
+                                 const std::shared_ptr<StreamAttr>& streamAttr,
+                                 const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  perfResults->type_of_running = PerfResults::TypeOfRunning::STREAM;
+  PinningScope pinning(perfAttr->pinning);
+  perfResults->pinning = perfAttr->pinning;
+  perfResults->num_threads = get_num_threads();
+  perfResults->problem_size = streamExecutor->size();
+
+  auto perfStreamAttr = std::make_shared<StreamAttr>(*streamAttr);
+  perfStreamAttr->state_of_testing = TaskData::StateOfTesting::PERF;
+
+  // fill and drain of the pipeline are excluded from throughput, time of the
+  // whole stream is kept as the latency measurement
+  double throughput_sum = 0.0;
+  uint64_t iteration = 0;
+  common_run(
+      perfAttr,
+      [&]() {
+        streamExecutor->run(perfStreamAttr);
+        if (iteration++ >= perfAttr->num_warmup) {
+          throughput_sum += streamExecutor->get_steady_throughput();
+        }
+      },
+      perfResults);
+
+  if (perfAttr->num_running > 0) {
+    perfResults->items_per_sec = throughput_sum / static_cast<double>(perfAttr->num_running);
+  }
+}
+
+void ppc::core::Perf::fill_run_info(const std::shared_ptr<ppc::core::PerfResults>& perfResults) const {
+  const auto& inputs_count = task->get_data()->inputs_count;
+  perfResults->num_threads = get_num_threads();
+  perfResults->problem_size = std::accumulate(inputs_count.begin(), inputs_count.end(), uint64_t{0});
+}
+
+void ppc::core::Perf::fill_scratch_bytes(const std::shared_ptr<PerfAttr>& perfAttr,
+                                         const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                                         uint64_t scratch_bytes_before) const {
+  auto num_runs = perfAttr->num_warmup + perfAttr->num_running;
+  if (num_runs == 0) return;
+  perfResults->scratch_bytes_per_run = (task->get_scratch_bytes() - scratch_bytes_before) / num_runs;
+}
+
 void ppc::core::Perf::common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
                                  const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  for (uint64_t i = 0; i < perfAttr->num_warmup; i++) {
+    pipeline();
+  }
+
+  perfResults->samples.clear();
+  perfResults->samples.reserve(perfAttr->num_running);
+  perfResults->stage_samples.clear();
+
+  std::unique_ptr<HwCountersGroup> hw_counters;
+  if (perfAttr->collect_hw_counters) {
+    hw_counters = std::make_unique<HwCountersGroup>();
+    hw_counters->start();
+  }
+
   auto begin = perfAttr->current_timer();
+  auto prev = begin;
   for (uint64_t i = 0; i < perfAttr->num_running; i++) {
     pipeline();
+    auto cur = perfAttr->current_timer();
+    perfResults->samples.push_back(cur - prev);
+    prev = cur;
   }
-  auto end = perfAttr->current_timer();
-  perfResults->time_sec = end - begin;
+  perfResults->time_sec = prev - begin;
+
+  if (hw_counters) {
+    hw_counters->stop();
+    perfResults->hw_counters = hw_counters->read();
+  }
+
+  calc_statistics(perfResults);
 }
 
-void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults) {
+void ppc::core::Perf::calc_statistics(const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  if (!perfResults->stage_samples.empty()) {
+    PerfResults::StageTimes stage_mean;
+    for (const auto& stage_times : perfResults->stage_samples) {
+      stage_mean.validation += stage_times.validation;
+      stage_mean.pre_processing += stage_times.pre_processing;
+      stage_mean.run += stage_times.run;
+      stage_mean.post_processing += stage_times.post_processing;
+    }
+    auto count = static_cast<double>(perfResults->stage_samples.size());
+    stage_mean.validation /= count;
+    stage_mean.pre_processing /= count;
+    stage_mean.run /= count;
+    stage_mean.post_processing /= count;
+    perfResults->stage_mean = stage_mean;
+  }
+
+  if (perfResults->samples.empty()) return;
+
+  std::vector<double> sorted(perfResults->samples);
+  std::sort(sorted.begin(), sorted.end());
+  auto count = static_cast<double>(sorted.size());
+
+  // linear interpolation between closest ranks
+  auto percentile = [&](double p) {
+    double rank = p * (count - 1.0);
+    auto lo = static_cast<size_t>(std::floor(rank));
+    auto hi = static_cast<size_t>(std::ceil(rank));
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - static_cast<double>(lo));
+  };
+
+  double sum = 0.0;
+  for (auto sample : sorted) sum += sample;
+  double mean = sum / count;
+  double sq_sum = 0.0;
+  for (auto sample : sorted) sq_sum += (sample - mean) * (sample - mean);
+
+  perfResults->min_sec = sorted.front();
+  perfResults->max_sec = sorted.back();
+  perfResults->mean_sec = mean;
+  perfResults->median_sec = percentile(0.5);
+  perfResults->p90_sec = percentile(0.9);
+  perfResults->p99_sec = percentile(0.99);
+  perfResults->stddev_sec = sorted.size() > 1 ? std::sqrt(sq_sum / (count - 1.0)) : 0.0;
+}
+
+void ppc::core::Perf::scaling_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                                  const std::shared_ptr<ScalingAttr>& scalingAttr,
+                                  const std::shared_ptr<ScalingResults>& scalingResults,
+                                  PerfResults::TypeOfRunning type_of_running) {
+  scalingResults->points.clear();
+  scalingResults->weak_scaling = static_cast<bool>(scalingAttr->make_task);
+
+  for (auto num_threads : scalingAttr->num_threads) {
+    auto threads_guard = scalingAttr->apply_num_threads(num_threads);
+    auto backend_threads = scalingAttr->get_num_threads();
+    if (backend_threads != num_threads) {
+      throw std::runtime_error("Backend runs " + std::to_string(backend_threads) + " threads instead of " +
+                               std::to_string(num_threads) + " of the scaling sweep");
+    }
+    if (scalingResults->weak_scaling) {
+      set_task(scalingAttr->make_task(num_threads));
+    }
+
+    auto perfResults = std::make_shared<PerfResults>();
+    if (type_of_running == PerfResults::TypeOfRunning::TASK_RUN) {
+      task_run(perfAttr, perfResults);
+    } else {
+      pipeline_run(perfAttr, perfResults);
+    }
+
+    ScalingResults::Point point;
+    point.num_threads = num_threads;
+    point.perf_results = *perfResults;
+    scalingResults->points.push_back(std::move(point));
+  }
+
+  if (scalingResults->points.empty()) return;
+
+  // speedup and efficiency are relative to the first point (usually 1 thread),
+  // median is used as it is stable against outliers
+  const auto& base = scalingResults->points.front();
+  auto base_time = base.perf_results.median_sec;
+  auto base_threads = static_cast<double>(base.num_threads);
+  for (auto& point : scalingResults->points) {
+    auto time = point.perf_results.median_sec;
+    if (time <= 0.0 || base_time <= 0.0) continue;
+    auto threads_ratio = static_cast<double>(point.num_threads) / base_threads;
+    if (scalingResults->weak_scaling) {
+      // work grows together with threads: ideal time is constant
+      point.efficiency = base_time / time;
+      point.speedup = point.efficiency * threads_ratio;
+    } else {
+      point.speedup = base_time / time;
+      point.efficiency = point.speedup / threads_ratio;
+    }
+  }
+}
+
+std::vector<uint64_t> ppc::core::SweepAttr::geometric_sizes(uint64_t min_size, uint64_t max_size, double factor) {
+  std::vector<uint64_t> sizes;
+  auto size = static_cast<double>(std::max<uint64_t>(min_size, 1));
+  while (static_cast<uint64_t>(size) <= max_size) {
+    if (sizes.empty() || static_cast<uint64_t>(size) != sizes.back()) {
+      sizes.push_back(static_cast<uint64_t>(size));
+    }
+    size *= std::max(factor, 1.0 + 1e-9);
+  }
+  return sizes;
+}
+
+void ppc::core::Perf::sweep_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<SweepAttr>& sweepAttr,
+                                const std::shared_ptr<SweepResults>& sweepResults,
+                                PerfResults::TypeOfRunning type_of_running) {
+  sweepResults->points.clear();
+  for (auto size : sweepAttr->sizes) {
+    Perf perf(sweepAttr->make_task(size));
+    auto perfResults = std::make_shared<PerfResults>();
+    if (type_of_running == PerfResults::TypeOfRunning::TASK_RUN) {
+      perf.task_run(perfAttr, perfResults);
+    } else {
+      perf.pipeline_run(perfAttr, perfResults);
+    }
+
+    SweepResults::Point point;
+    point.size = size;
+    point.perf_results = *perfResults;
+    auto time = perfResults->median_sec;
+    auto flops = sweepAttr->flops ? sweepAttr->flops(size) : 0.0;
+    auto bytes = sweepAttr->bytes ? sweepAttr->bytes(size) : 0.0;
+    if (time > 0.0) {
+      point.gflops = flops / time * 1e-9;
+      point.gbytes_per_sec = bytes / time * 1e-9;
+    }
+    if (bytes > 0.0) {
+      point.intensity = flops / bytes;
+      point.attainable_gflops = sweepResults->roofline.attainable_gflops(point.intensity);
+    }
+    sweepResults->points.push_back(std::move(point));
+  }
+}
+
+std::string ppc::core::Perf::get_relative_path() {
   std::string relative_path(::testing::UnitTest::GetInstance()->current_test_info()->file());
-  std::string ppc_regex_template("parallel_programming_course");
-  std::string perf_regex_template("perf_tests");
-  std::string type_test_name;
+  std::replace(relative_path.begin(), relative_path.end(), '\\', '/');
 
-  auto time_secs = perfResults->time_sec;
+  // path of the task inside of the project: tasks/<type>/<name> or modules/<...>
+  for (const auto* root : {"/tasks/", "/modules/"}) {
+    auto root_position = relative_path.rfind(root);
+    if (root_position != std::string::npos) {
+      relative_path.erase(0, root_position + 1);
+      break;
+    }
+  }
 
-  if (perfResults->type_of_running == PerfResults::TypeOfRunning::TASK_RUN) {
-    type_test_name = "task_run";
-  } else if (perfResults->type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
-    type_test_name = "pipeline";
-  } else if (perfResults->type_of_running == PerfResults::TypeOfRunning::NONE) {
-    type_test_name = "none";
+  for (const auto* tests_dir : {"/perf_tests/", "/func_tests/"}) {
+    auto tests_position = relative_path.rfind(tests_dir);
+    if (tests_position != std::string::npos) {
+      relative_path.erase(tests_position);
+      break;
+    }
+  }
+  return relative_path;
+}
+
+std::string ppc::core::Perf::get_type_test_name(PerfResults::TypeOfRunning type_of_running) {
+  if (type_of_running == PerfResults::TypeOfRunning::TASK_RUN) {
+    return "task_run";
+  }
+  if (type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
+    return "pipeline";
+  }
+  if (type_of_running == PerfResults::TypeOfRunning::BATCH) {
+    return "batch";
+  }
+  if (type_of_running == PerfResults::TypeOfRunning::STREAM) {
+    return "stream";
   }
+  return "none";
+}
 
-  auto first_found_position = relative_path.find(ppc_regex_template) + ppc_regex_template.length() + 1;
-  relative_path.erase(0, first_found_position);
+void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults) {
+  auto relative_path = get_relative_path();
+  auto type_test_name = get_type_test_name(perfResults->type_of_running);
 
-  auto last_found_position = relative_path.find(perf_regex_template) - 1;
-  relative_path.erase(last_found_position, relative_path.length() - 1);
+  auto time_secs = perfResults->time_sec;
 
   std::stringstream perf_res_str;
   if (time_secs > PerfResults::MIN_TIME && time_secs < PerfResults::MAX_TIME) {
@@ -90,4 +463,118 @@ void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& p
   }
 
   std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << std::endl;
+
+  if (!perfResults->stage_samples.empty()) {
+    const auto& stage_mean = perfResults->stage_mean;
+    std::cout << relative_path << ":" << type_test_name << "_stages:" << std::fixed << std::setprecision(10)
+              << "validation=" << stage_mean.validation << ",pre_processing=" << stage_mean.pre_processing
+              << ",run=" << stage_mean.run << ",post_processing=" << stage_mean.post_processing << std::endl;
+  }
+
+  auto output_path = get_env("PPC_PERF_OUTPUT");
+  if (!output_path.empty()) {
+    auto format = get_env("PPC_PERF_FORMAT") == "csv" ? PerfOutputFormat::CSV : PerfOutputFormat::JSON;
+    bool is_new_file = !std::ifstream(output_path).good();
+    std::ofstream output(output_path, std::ios::app);
+    if (is_new_file && format == PerfOutputFormat::CSV) {
+      output << get_perf_record_header(format) << std::endl;
+    }
+    output << get_perf_record(perfResults, relative_path, format) << std::endl;
+  }
+}
+
+std::string ppc::core::Perf::get_perf_record_header(PerfOutputFormat format) {
+  if (format == PerfOutputFormat::JSON) return {};
+  return "task,backend,type,num_threads,problem_size,num_running,time_sec,min_sec,median_sec,mean_sec,p90_sec,p99_sec,"
+         "max_sec,stddev_sec,samples,hw_available,cycles,instructions,llc_misses,branch_misses,task_clock_sec,ipc,"
+         "bytes_per_op,validation_sec,pre_processing_sec,run_sec,post_processing_sec,items_per_sec,"
+         "scratch_bytes_per_run,pinning,compiler,cxx_flags,cpu_model,timestamp";
+}
+
+std::string ppc::core::Perf::get_perf_record(const std::shared_ptr<PerfResults>& perfResults,
+                                             const std::string& task_path, PerfOutputFormat format) {
+  static const std::string cpu_model = get_cpu_model();
+
+  // tasks/<backend>/<name>, backend is empty for modules
+  std::string backend;
+  if (task_path.rfind("tasks/", 0) == 0) {
+    backend = task_path.substr(6, task_path.find('/', 6) - 6);
+  }
+  auto timestamp =
+      std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+  std::stringstream samples;
+  samples << std::setprecision(10);
+  for (size_t i = 0; i < perfResults->samples.size(); i++) {
+    samples << (i > 0 ? (format == PerfOutputFormat::JSON ? "," : ";") : "") << perfResults->samples[i];
+  }
+
+  const auto& hw = perfResults->hw_counters;
+  const auto& stages = perfResults->stage_mean;
+  std::stringstream record;
+  record << std::setprecision(10);
+  if (format == PerfOutputFormat::JSON) {
+    record << "{\"task\":\"" << escape_json(task_path) << "\",\"backend\":\"" << escape_json(backend)
+           << "\",\"type\":\"" << get_type_test_name(perfResults->type_of_running)
+           << "\",\"num_threads\":" << perfResults->num_threads << ",\"problem_size\":" << perfResults->problem_size
+           << ",\"num_running\":" << perfResults->samples.size() << ",\"time_sec\":" << perfResults->time_sec
+           << ",\"min_sec\":" << perfResults->min_sec << ",\"median_sec\":" << perfResults->median_sec
+           << ",\"mean_sec\":" << perfResults->mean_sec << ",\"p90_sec\":" << perfResults->p90_sec
+           << ",\"p99_sec\":" << perfResults->p99_sec << ",\"max_sec\":" << perfResults->max_sec
+           << ",\"stddev_sec\":" << perfResults->stddev_sec << ",\"samples\":[" << samples.str()
+           << "],\"hw_counters\":{\"available\":" << (hw.available ? "true" : "false") << ",\"cycles\":" << hw.cycles
+           << ",\"instructions\":" << hw.instructions << ",\"llc_misses\":" << hw.llc_misses
+           << ",\"branch_misses\":" << hw.branch_misses << ",\"task_clock_sec\":" << hw.task_clock_sec
+           << ",\"ipc\":" << hw.ipc << ",\"bytes_per_op\":" << hw.bytes_per_op << "},\"stages\":{\"validation_sec\":"
+           << stages.validation << ",\"pre_processing_sec\":" << stages.pre_processing << ",\"run_sec\":" << stages.run
+           << ",\"post_processing_sec\":" << stages.post_processing << "},\"items_per_sec\":"
+           << perfResults->items_per_sec << ",\"scratch_bytes_per_run\":" << perfResults->scratch_bytes_per_run
+           << ",\"pinning\":\"" << get_pinning_policy_name(perfResults->pinning) << "\",\"compiler\":\""
+           << escape_json(get_compiler()) << "\",\"cxx_flags\":\"" << escape_json(PPC_CXX_FLAGS)
+           << "\",\"cpu_model\":\"" << escape_json(cpu_model) << "\",\"timestamp\":" << timestamp << "}";
+  } else {
+    record << escape_csv(task_path) << "," << escape_csv(backend) << ","
+           << get_type_test_name(perfResults->type_of_running) << "," << perfResults->num_threads << ","
+           << perfResults->problem_size << "," << perfResults->samples.size() << "," << perfResults->time_sec << ","
+           << perfResults->min_sec << "," << perfResults->median_sec << "," << perfResults->mean_sec << ","
+           << perfResults->p90_sec << "," << perfResults->p99_sec << "," << perfResults->max_sec << ","
+           << perfResults->stddev_sec << "," << escape_csv(samples.str()) << "," << (hw.available ? 1 : 0) << ","
+           << hw.cycles << "," << hw.instructions << "," << hw.llc_misses << "," << hw.branch_misses << ","
+           << hw.task_clock_sec << "," << hw.ipc << "," << hw.bytes_per_op << "," << stages.validation << ","
+           << stages.pre_processing << "," << stages.run << "," << stages.post_processing << ","
+           << perfResults->items_per_sec << "," << perfResults->scratch_bytes_per_run << ","
+           << get_pinning_policy_name(perfResults->pinning) << ","
+           << escape_csv(get_compiler()) << "," << escape_csv(PPC_CXX_FLAGS) << ","
+           << escape_csv(cpu_model) << "," << timestamp;
+  }
+  return record.str();
+}
+
+void ppc::core::Perf::print_scaling_statistic(const std::shared_ptr<ScalingResults>& scalingResults) {
+  auto relative_path = get_relative_path();
+  std::string scaling_name = scalingResults->weak_scaling ? "weak_scaling" : "strong_scaling";
+
+  // one line per point: path:type:num_threads:median_time:speedup:efficiency
+  for (const auto& point : scalingResults->points) {
+    std::cout << relative_path << ":" << get_type_test_name(point.perf_results.type_of_running) << "_"
+              << scaling_name << ":" << point.num_threads << ":" << std::fixed << std::setprecision(10)
+              << point.perf_results.median_sec << ":" << point.speedup << ":" << point.efficiency << std::endl;
+  }
+}
+
+void ppc::core::Perf::print_sweep_statistic(const std::shared_ptr<SweepResults>& sweepResults) {
+  auto relative_path = get_relative_path();
+  const auto& roofline = sweepResults->roofline;
+  if (roofline.peak_gflops > 0.0) {
+    std::cout << relative_path << ":roofline:" << std::fixed << std::setprecision(10) << roofline.peak_gflops << ":"
+              << roofline.bandwidth_gbs << std::endl;
+  }
+
+  // one line per point: path:type_sweep:size:median_time:gflops:gbytes_per_sec:intensity:attainable_gflops
+  for (const auto& point : sweepResults->points) {
+    std::cout << relative_path << ":" << get_type_test_name(point.perf_results.type_of_running) << "_sweep:"
+              << point.size << ":" << std::fixed << std::setprecision(10) << point.perf_results.median_sec << ":"
+              << point.gflops << ":" << point.gbytes_per_sec << ":" << point.intensity << ":"
+              << point.attainable_gflops << std::endl;
+  }
 }
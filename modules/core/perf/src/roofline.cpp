@@ -0,0 +1,123 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/roofline.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "core/perf/src/roofline_isa.hpp"
+#include "core/threads/include/simd.hpp"
+#include "core/threads/include/thread_pool.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace {
+
+double current_time() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// keeps results of probes alive for the optimizer
+std::atomic<double> probe_sink{0.0};
+
+// Chains of the baseline instruction set, enough of them to hide latency of
+// the units and to be vectorized by the compiler
+constexpr size_t kScalarChains = 32;
+
+double run_scalar_chains(size_t iterations, double seed) {
+  std::array<double, kScalarChains> acc;
+  for (size_t j = 0; j < kScalarChains; j++) {
+    acc[j] = static_cast<double>(j) + seed;
+  }
+  const double multiplier = 0.999999;
+  const double addend = 1e-6;
+  for (size_t i = 0; i < iterations; i++) {
+    for (size_t j = 0; j < kScalarChains; j++) {
+      acc[j] = acc[j] * multiplier + addend;
+    }
+  }
+  double sum = 0.0;
+  for (auto value : acc) {
+    sum += value;
+  }
+  return sum;
+}
+
+const ppc::core::roofline_detail::PeakProbe scalar_probe = {2 * kScalarChains, &run_scalar_chains};
+
+// Probe of the SIMD level, so the peak is the one of the widest registers
+// with FMA rather than of the baseline the library is compiled for
+const ppc::core::roofline_detail::PeakProbe& get_peak_probe() {
+  using ppc::core::SimdLevel;
+  namespace detail = ppc::core::roofline_detail;
+  auto level = ppc::core::get_simd_level();
+  for (const auto* probe : {level >= SimdLevel::AVX512 ? detail::get_avx512_peak_probe() : nullptr,
+                            level >= SimdLevel::AVX2 ? detail::get_avx2_peak_probe() : nullptr}) {
+    if (probe != nullptr) return *probe;
+  }
+  return scalar_probe;
+}
+
+}  // namespace
+
+ppc::core::Roofline ppc::core::Roofline::measure(size_t stream_bytes, int repetitions) {
+  Roofline roofline;
+  roofline.bandwidth_gbs = measure_bandwidth_gbs(stream_bytes, repetitions);
+  roofline.peak_gflops = measure_peak_gflops(repetitions);
+  return roofline;
+}
+
+double ppc::core::Roofline::measure_bandwidth_gbs(size_t stream_bytes, int repetitions) {
+  auto size = std::max<size_t>(stream_bytes / (3 * sizeof(double)), 1);
+  // arrays are not value-initialized, pages are first touched by the threads
+  // which use them in the triad
+  std::unique_ptr<double[]> a(new double[size]);
+  std::unique_ptr<double[]> b(new double[size]);
+  std::unique_ptr<double[]> c(new double[size]);
+  parallel_for<size_t>(0, size, [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      a[i] = 0.0;
+      b[i] = 1.0;
+      c[i] = 2.0;
+    }
+  });
+
+  const double scalar = 3.0;
+  double best_time = 0.0;
+  for (int repetition = 0; repetition < std::max(repetitions, 1); repetition++) {
+    auto start = current_time();
+    parallel_for<size_t>(0, size, [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; i++) {
+        a[i] = b[i] + scalar * c[i];
+      }
+    });
+    auto time = current_time() - start;
+    if (repetition == 0 || time < best_time) best_time = time;
+  }
+  probe_sink.store(a[size / 2]);
+
+  // STREAM convention: two loads and one store per element
+  return best_time > 0.0 ? static_cast<double>(3 * sizeof(double) * size) / best_time * 1e-9 : 0.0;
+}
+
+double ppc::core::Roofline::measure_peak_gflops(int repetitions) {
+  constexpr size_t kIterations = size_t{1} << 20;
+  const auto& probe = get_peak_probe();
+  auto num_threads = static_cast<size_t>(get_num_threads());
+
+  double best_time = 0.0;
+  for (int repetition = 0; repetition < std::max(repetitions, 1); repetition++) {
+    auto start = current_time();
+    parallel_for<size_t>(0, num_threads, [&](size_t begin, size_t end) {
+      for (auto thread = begin; thread < end; thread++) {
+        probe_sink.store(probe.run(kIterations, static_cast<double>(thread)));
+      }
+    });
+    auto time = current_time() - start;
+    if (repetition == 0 || time < best_time) best_time = time;
+  }
+
+  auto flops = static_cast<double>(probe.flops_per_iteration * kIterations * num_threads);
+  return best_time > 0.0 ? flops / best_time * 1e-9 : 0.0;
+}
@@ -0,0 +1,60 @@
+// Copyright 2024 Nesterov Alexander
+#include <cstddef>
+#include <utility>
+
+#include "core/perf/src/roofline_isa.hpp"
+
+#ifdef PPC_ROOFLINE_X86
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+namespace {
+
+// latency of FMA times two FMA ports, within 32 registers
+constexpr size_t CHAINS = 16;
+constexpr size_t WIDTH = 8;
+
+template <size_t... J>
+double run_chains(size_t iterations, double seed, std::index_sequence<J...> /*chains*/) {
+  __m512d acc[CHAINS] = {_mm512_set1_pd(seed + static_cast<double>(J))...};
+  const auto multiplier = _mm512_set1_pd(0.999999);
+  const auto addend = _mm512_set1_pd(1e-6);
+  for (size_t i = 0; i < iterations; i++) {
+    ((acc[J] = _mm512_fmadd_pd(acc[J], multiplier, addend)), ...);
+  }
+  auto sum = _mm512_add_pd(acc[0], acc[1]);
+  for (size_t j = 2; j < CHAINS; j++) sum = _mm512_add_pd(sum, acc[j]);
+  alignas(64) double lanes[WIDTH];
+  _mm512_store_pd(lanes, sum);
+  double total = 0.0;
+  for (auto lane : lanes) total += lane;
+  return total;
+}
+
+double run(size_t iterations, double seed) {
+  return run_chains(iterations, seed, std::make_index_sequence<CHAINS>());
+}
+
+const ppc::core::roofline_detail::PeakProbe probe = {2 * CHAINS * WIDTH, &run};
+
+}  // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+const ppc::core::roofline_detail::PeakProbe* ppc::core::roofline_detail::get_avx512_peak_probe() { return &probe; }
+
+#else
+
+const ppc::core::roofline_detail::PeakProbe* ppc::core::roofline_detail::get_avx512_peak_probe() { return nullptr; }
+
+#endif  // PPC_ROOFLINE_X86
@@ -0,0 +1,29 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_PERF_SRC_ROOFLINE_ISA_HPP_
+#define MODULES_CORE_PERF_SRC_ROOFLINE_ISA_HPP_
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PPC_ROOFLINE_X86
+#endif
+
+namespace ppc::core::roofline_detail {
+
+// Peak FLOP/s probe of one instruction set: independent multiply-add chains
+// in vector registers, run for iterations steps from seed. Returns the sum
+// of the chains so the optimizer keeps them
+struct PeakProbe {
+  size_t flops_per_iteration;
+  double (*run)(size_t iterations, double seed);
+};
+
+// Each probe is defined in its own translation unit compiled for the
+// instruction set, nullptr when the target isn't x86
+const PeakProbe* get_avx2_peak_probe();
+const PeakProbe* get_avx512_peak_probe();
+
+}  // namespace ppc::core::roofline_detail
+
+#endif  // MODULES_CORE_PERF_SRC_ROOFLINE_ISA_HPP_
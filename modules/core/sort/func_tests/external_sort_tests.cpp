@@ -0,0 +1,209 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/sort/include/external_sort.hpp"
+
+namespace {
+
+class external_sort_tests : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // parallel runs of the tests don't share the directory
+    auto name = "ppc_external_sort_tests_" + std::to_string(std::random_device()());
+    directory = std::filesystem::temp_directory_path() / name;
+    std::filesystem::create_directories(directory);
+  }
+  void TearDown() override { std::filesystem::remove_all(directory); }
+
+  [[nodiscard]] std::string get_path(const std::string& name) const { return (directory / name).string(); }
+
+  std::filesystem::path directory;
+};
+
+template <class T>
+void write_file(const std::string& path, const std::vector<T>& data) {
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(T)));
+}
+
+template <class T>
+std::vector<T> read_file(const std::string& path) {
+  std::vector<T> data(std::filesystem::file_size(path) / sizeof(T));
+  std::ifstream file(path, std::ios::binary);
+  file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(T)));
+  return data;
+}
+
+template <class T>
+std::vector<T> make_random_vector(size_t size, uint32_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<T> data(size);
+  if constexpr (std::is_floating_point_v<T>) {
+    std::uniform_real_distribution<T> dist(-1e6, 1e6);
+    for (auto& value : data) value = dist(gen);
+  } else {
+    std::uniform_int_distribution<T> dist(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+    for (auto& value : data) value = dist(gen);
+  }
+  return data;
+}
+
+// Sort of a file as a task, for sweeps of Perf
+class ExternalSortTask : public ppc::core::Task {
+ public:
+  ExternalSortTask(std::string input_, std::string output_, ppc::core::ExternalSortAttr attr_)
+      : Task(std::make_shared<ppc::core::TaskData>()),
+        input(std::move(input_)),
+        output(std::move(output_)),
+        attr(std::move(attr_)) {}
+  bool validation() override {
+    internal_order_test();
+    return std::filesystem::exists(input);
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    stats = ppc::core::external_sort<double>(input, output, attr);
+    return stats.get_gbytes_per_sec() > 0.0;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  std::string input;
+  std::string output;
+  ppc::core::ExternalSortAttr attr;
+  ppc::core::ExternalSortStats stats;
+};
+
+struct Record {
+  uint64_t key;
+  uint32_t index;
+  uint32_t padding;
+};
+
+}  // namespace
+
+TEST_F(external_sort_tests, check_loser_tree) {
+  std::vector<std::vector<int>> sources = {{1, 4, 9}, {}, {2, 3, 10, 11}, {0}, {5, 6, 7, 8}};
+  std::vector<size_t> positions(sources.size());
+  auto less = [&](size_t i, size_t j) {
+    if (positions[i] == sources[i].size()) return false;
+    if (positions[j] == sources[j].size()) return true;
+    return sources[i][positions[i]] < sources[j][positions[j]];
+  };
+  ppc::core::external_sort_detail::LoserTree<decltype(less)> tree(sources.size(), less);
+  for (int expected = 0; expected <= 11; expected++) {
+    auto winner = tree.get_winner();
+    ASSERT_EQ(sources[winner][positions[winner]], expected);
+    positions[winner]++;
+    tree.replay();
+  }
+}
+
+TEST_F(external_sort_tests, check_many_runs) {
+  ppc::core::ExternalSortAttr attr;
+  attr.temp_directory = directory.string();
+  // runs of 1000 elements and blocks of 37 ones
+  attr.memory_bytes = 3000 * sizeof(int32_t);
+  attr.block_bytes = 37 * sizeof(int32_t);
+  for (size_t size : {size_t{1}, size_t{999}, size_t{1000}, size_t{25001}}) {
+    auto data = make_random_vector<int32_t>(size, static_cast<uint32_t>(size));
+    write_file(get_path("input"), data);
+    auto stats = ppc::core::external_sort<int32_t>(get_path("input"), get_path("output"), attr);
+    EXPECT_EQ(stats.num_runs, (size + 999) / 1000);
+    EXPECT_EQ(stats.bytes, size * sizeof(int32_t));
+    std::sort(data.begin(), data.end());
+    EXPECT_EQ(read_file<int32_t>(get_path("output")), data) << "size " << size;
+  }
+  // temporary file of runs is removed
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 2);
+}
+
+TEST_F(external_sort_tests, check_doubles_and_records) {
+  ppc::core::ExternalSortAttr attr;
+  attr.temp_directory = directory.string();
+  attr.memory_bytes = 3 * 4096 * sizeof(double);
+  auto doubles = make_random_vector<double>(100000, 1);
+  doubles[5] = -0.0;
+  doubles[6] = std::numeric_limits<double>::infinity();
+  write_file(get_path("doubles"), doubles);
+  ppc::core::external_sort<double>(get_path("doubles"), get_path("sorted_doubles"), attr);
+  std::sort(doubles.begin(), doubles.end());
+  EXPECT_EQ(read_file<double>(get_path("sorted_doubles")), doubles);
+
+  auto keys = make_random_vector<uint64_t>(50000, 2);
+  std::vector<Record> records(keys.size());
+  for (size_t i = 0; i < records.size(); i++) records[i] = Record{keys[i] % 1000, static_cast<uint32_t>(i), 0};
+  write_file(get_path("records"), records);
+  ppc::core::external_sort<Record>(get_path("records"), get_path("sorted_records"), attr, &Record::key);
+  auto sorted = read_file<Record>(get_path("sorted_records"));
+  ASSERT_EQ(sorted.size(), records.size());
+  std::vector<bool> seen(records.size());
+  for (size_t i = 0; i < sorted.size(); i++) {
+    if (i > 0) {
+      ASSERT_LE(sorted[i - 1].key, sorted[i].key);
+    }
+    ASSERT_EQ(sorted[i].key, records[sorted[i].index].key);
+    seen[sorted[i].index] = true;
+  }
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), false), 0);
+}
+
+TEST_F(external_sort_tests, check_invalid_input) {
+  write_file(get_path("empty"), std::vector<int64_t>());
+  auto stats = ppc::core::external_sort<int64_t>(get_path("empty"), get_path("output"));
+  EXPECT_EQ(stats.num_runs, 0U);
+  EXPECT_EQ(std::filesystem::file_size(get_path("output")), 0U);
+
+  write_file(get_path("odd"), std::vector<uint8_t>(13));
+  EXPECT_THROW(ppc::core::external_sort<int32_t>(get_path("odd"), get_path("output")), std::invalid_argument);
+  EXPECT_THROW(ppc::core::external_sort<int32_t>(get_path("missing"), get_path("output")), std::runtime_error);
+}
+
+// End to end throughput on local disk, with memory for a quarter of the
+// data. The sweep prints GB/s of the input of every size as perf records
+TEST_F(external_sort_tests, check_throughput) {
+  auto sweepAttr = std::make_shared<ppc::core::SweepAttr>();
+  sweepAttr->sizes = ppc::core::SweepAttr::geometric_sizes(size_t{1} << 20, size_t{1} << 22, 4.0);
+  sweepAttr->make_task = [&](uint64_t size) {
+    write_file(get_path("input"), make_random_vector<double>(size, static_cast<uint32_t>(size)));
+    ppc::core::ExternalSortAttr attr;
+    attr.temp_directory = directory.string();
+    attr.memory_bytes = size * sizeof(double) / 4;
+    return std::make_shared<ExternalSortTask>(get_path("input"), get_path("output"), attr);
+  };
+  sweepAttr->bytes = [](uint64_t size) { return static_cast<double>(size * sizeof(double)); };
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->current_timer = [] {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  };
+  auto sweepResults = std::make_shared<ppc::core::SweepResults>();
+  ppc::core::Perf::sweep_run(perfAttr, sweepAttr, sweepResults, ppc::core::PerfResults::TypeOfRunning::TASK_RUN);
+  ppc::core::Perf::print_sweep_statistic(sweepResults);
+  ASSERT_EQ(sweepResults->points.size(), sweepAttr->sizes.size());
+  for (const auto& point : sweepResults->points) EXPECT_GT(point.gbytes_per_sec, 0.0);
+
+  auto sorted = read_file<double>(get_path("output"));
+  EXPECT_EQ(sorted.size(), sweepAttr->sizes.back());
+  EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+}
@@ -0,0 +1,321 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "core/sort/include/simd_sort.hpp"
+#include "core/sort/include/sort.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace {
+
+template <class T>
+std::vector<T> make_random_vector(size_t size, uint32_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<T> data(size);
+  if constexpr (std::is_floating_point_v<T>) {
+    std::uniform_real_distribution<T> dist(-1e6, 1e6);
+    for (auto& value : data) value = dist(gen);
+  } else {
+    std::uniform_int_distribution<T> dist(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+    for (auto& value : data) value = dist(gen);
+  }
+  return data;
+}
+
+struct Record {
+  double key;
+  uint32_t index;
+};
+
+// Threads are set to more than one to split data into several chunks on any machine
+class sort_tests : public ::testing::Test {
+ protected:
+  void SetUp() override { ppc::core::set_num_threads(4); }
+  void TearDown() override { ppc::core::set_num_threads(0); }
+};
+
+template <class T, class Backend>
+void check_all_sorts(std::vector<T> data, const Backend& backend) {
+  auto expected = data;
+  std::sort(expected.begin(), expected.end());
+
+  auto lsd = data;
+  ppc::core::radix_sort(std::span<T>(lsd), std::identity(), backend);
+  EXPECT_EQ(lsd, expected);
+
+  auto msd = data;
+  ppc::core::msd_radix_sort(std::span<T>(msd), std::identity(), backend);
+  EXPECT_EQ(msd, expected);
+
+  auto sample = data;
+  ppc::core::sample_sort(std::span<T>(sample), std::less<>(), backend);
+  EXPECT_EQ(sample, expected);
+
+  auto inplace = data;
+  ppc::core::inplace_radix_sort(std::span<T>(inplace), std::identity(), backend);
+  EXPECT_EQ(inplace, expected);
+
+  ppc::core::parallel_sort(std::span<T>(data), std::identity(), backend);
+  EXPECT_EQ(data, expected);
+}
+
+// Run check with every SIMD level the CPU supports
+template <class Check>
+void for_each_simd_level(const Check& check) {
+  auto saved = ppc::core::get_simd_level();
+  for (auto level : {ppc::core::SimdLevel::SCALAR, ppc::core::SimdLevel::SSE4_1, ppc::core::SimdLevel::AVX2,
+                     ppc::core::SimdLevel::AVX512}) {
+    if (level > ppc::core::get_cpu_simd_level()) break;
+    ppc::core::set_simd_level(level);
+    SCOPED_TRACE(ppc::core::get_simd_level_name(level));
+    check();
+  }
+  ppc::core::set_simd_level(saved);
+}
+
+}  // namespace
+
+TEST_F(sort_tests, check_radix_key_order) {
+  std::vector<double> values = {-std::numeric_limits<double>::infinity(), -1e300, -1.0, -1e-300, -0.0, 0.0, 1e-300,
+                                1.0, 1e300, std::numeric_limits<double>::infinity()};
+  for (size_t i = 1; i < values.size(); i++) {
+    EXPECT_LT(ppc::core::RadixKey<double>::to_bits(values[i - 1]), ppc::core::RadixKey<double>::to_bits(values[i]));
+  }
+  EXPECT_LT(ppc::core::RadixKey<int32_t>::to_bits(-1), ppc::core::RadixKey<int32_t>::to_bits(0));
+  EXPECT_LT(ppc::core::RadixKey<int64_t>::to_bits(std::numeric_limits<int64_t>::min()),
+            ppc::core::RadixKey<int64_t>::to_bits(-1));
+  EXPECT_LT(ppc::core::RadixKey<float>::to_bits(-2.5F), ppc::core::RadixKey<float>::to_bits(-2.0F));
+}
+
+TEST_F(sort_tests, check_network_sort) {
+  for (size_t size = 0; size <= 40; size++) {
+    auto data = make_random_vector<int32_t>(size, static_cast<uint32_t>(size));
+    auto expected = data;
+    std::sort(expected.begin(), expected.end());
+    ppc::core::network_sort(data.data(), data.size(), std::less<>());
+    EXPECT_EQ(data, expected) << "size " << size;
+  }
+}
+
+TEST_F(sort_tests, check_seq_backend) {
+  check_all_sorts(make_random_vector<int32_t>(100000, 1), ppc::core::SeqSortBackend());
+  check_all_sorts(make_random_vector<double>(100000, 2), ppc::core::SeqSortBackend());
+}
+
+TEST_F(sort_tests, check_omp_backend) {
+  check_all_sorts(make_random_vector<uint32_t>(100000, 3), ppc::core::OmpSortBackend());
+  check_all_sorts(make_random_vector<int64_t>(100000, 4), ppc::core::OmpSortBackend());
+}
+
+TEST_F(sort_tests, check_stl_backend) {
+  check_all_sorts(make_random_vector<float>(100000, 5), ppc::core::StlSortBackend());
+  check_all_sorts(make_random_vector<double>(200000, 6), ppc::core::StlSortBackend());
+  check_all_sorts(make_random_vector<uint64_t>(200000, 7), ppc::core::StlSortBackend());
+}
+
+TEST_F(sort_tests, check_small_and_special_inputs) {
+  ppc::core::StlSortBackend backend;
+  for (size_t size : {0, 1, 2, 31, 32, 33, 1000, 1025}) {
+    check_all_sorts(make_random_vector<int32_t>(size, static_cast<uint32_t>(size)), backend);
+  }
+  // equal keys, few distinct keys, already sorted and reversed data
+  check_all_sorts(std::vector<int32_t>(100000, 42), backend);
+  auto few = make_random_vector<uint32_t>(100000, 8);
+  for (auto& value : few) value %= 3;
+  check_all_sorts(few, backend);
+  auto sorted = make_random_vector<double>(100000, 9);
+  std::sort(sorted.begin(), sorted.end());
+  check_all_sorts(sorted, backend);
+  std::reverse(sorted.begin(), sorted.end());
+  check_all_sorts(sorted, backend);
+  check_all_sorts(std::vector<double>({3.0, -0.0, 0.0, -7.5, std::numeric_limits<double>::infinity(), -1e-310}),
+                  backend);
+}
+
+TEST_F(sort_tests, check_key_extractor_is_stable) {
+  auto keys = make_random_vector<uint32_t>(100000, 10);
+  std::vector<Record> records(keys.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i] = Record{static_cast<double>(keys[i] % 100) - 50.0, static_cast<uint32_t>(i)};
+  }
+
+  ppc::core::radix_sort(std::span<Record>(records), &Record::key);
+  for (size_t i = 1; i < records.size(); i++) {
+    ASSERT_LE(records[i - 1].key, records[i].key);
+    if (records[i - 1].key == records[i].key) {
+      ASSERT_LT(records[i - 1].index, records[i].index);
+    }
+  }
+
+  auto by_index = [](const Record& a, const Record& b) { return a.index < b.index; };
+  ppc::core::sample_sort(std::span<Record>(records), by_index);
+  for (size_t i = 0; i < records.size(); i++) ASSERT_EQ(records[i].index, i);
+
+  ppc::core::msd_radix_sort(std::span<Record>(records), [](const Record& record) { return -record.key; });
+  EXPECT_TRUE(std::is_sorted(records.begin(), records.end(),
+                             [](const Record& a, const Record& b) { return a.key > b.key; }));
+}
+
+TEST_F(sort_tests, check_inplace_radix_sort_skewed) {
+  // most elements in one bucket of the top digit make stripes of threads
+  // unbalanced, so the permutation takes several rounds
+  auto data = make_random_vector<double>(1 << 20, 13);
+  for (size_t i = 0; i < data.size(); i++) {
+    if (i % 10 != 0) data[i] = 1.0 + data[i] * 1e-7;
+  }
+  auto expected = data;
+  std::sort(expected.begin(), expected.end());
+  auto omp = data;
+  ppc::core::inplace_radix_sort(std::span<double>(omp), std::identity(), ppc::core::OmpSortBackend());
+  EXPECT_EQ(omp, expected);
+
+  std::vector<Record> records(300000);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i] = Record{static_cast<double>((i * 7919) % 1000) - 500.0, static_cast<uint32_t>(i)};
+  }
+  ppc::core::inplace_radix_sort(std::span<Record>(records), &Record::key);
+  EXPECT_TRUE(std::is_sorted(records.begin(), records.end(),
+                             [](const Record& a, const Record& b) { return a.key < b.key; }));
+}
+
+TEST_F(sort_tests, check_radix_sort_pairs) {
+  for (size_t size : {0, 5, 1000, 100000}) {
+    auto keys = make_random_vector<double>(size, 11);
+    // few distinct keys, without -0.0 which is ordered before +0.0
+    for (auto& key : keys) key = std::round(key / 1e4) + 0.0;
+    std::vector<uint64_t> values(size);
+    for (size_t i = 0; i < size; i++) values[i] = i;
+    auto source_keys = keys;
+
+    ppc::core::radix_sort_pairs(std::span<double>(keys), std::span<uint64_t>(values));
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    for (size_t i = 0; i < size; i++) {
+      ASSERT_EQ(keys[i], source_keys[values[i]]);
+      // equal keys keep their order
+      if (i > 0 && keys[i - 1] == keys[i]) {
+        ASSERT_LT(values[i - 1], values[i]);
+      }
+    }
+  }
+
+  std::vector<int32_t> keys(10);
+  std::vector<uint32_t> values(9);
+  EXPECT_THROW(ppc::core::radix_sort_pairs(std::span<int32_t>(keys), std::span<uint32_t>(values)),
+               std::invalid_argument);
+}
+
+TEST_F(sort_tests, check_argsort) {
+  auto data = make_random_vector<int64_t>(100000, 12);
+  auto order = ppc::core::argsort(std::span<const int64_t>(data), std::identity(), ppc::core::OmpSortBackend());
+  ASSERT_EQ(order.size(), data.size());
+  auto expected = data;
+  std::sort(expected.begin(), expected.end());
+  for (size_t i = 0; i < order.size(); i++) ASSERT_EQ(data[order[i]], expected[i]);
+
+  // permutation of records by a field, with 64-bit indices
+  std::vector<Record> records(1000);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i] = Record{static_cast<double>((i * 7919) % 1000), static_cast<uint32_t>(i)};
+  }
+  auto permutation = ppc::core::argsort<uint64_t>(std::span<const Record>(records), &Record::key);
+  for (size_t i = 0; i < permutation.size(); i++) ASSERT_EQ(records[permutation[i]].key, static_cast<double>(i));
+
+  std::vector<uint8_t> too_many(300);
+  EXPECT_THROW(ppc::core::argsort<uint8_t>(std::span<const uint8_t>(too_many)), std::invalid_argument);
+}
+
+TEST_F(sort_tests, check_simd_sort_block_size) {
+  std::vector<int32_t> block(ppc::core::SIMD_SORT_BLOCK_SIZE + 1);
+  EXPECT_THROW(ppc::core::simd_sort_block(block.data(), block.size()), std::invalid_argument);
+}
+
+TEST_F(sort_tests, check_simd_sort_block) {
+  for_each_simd_level([] {
+    for (size_t size = 0; size <= ppc::core::SIMD_SORT_BLOCK_SIZE; size++) {
+      auto ints = make_random_vector<int32_t>(size, static_cast<uint32_t>(size));
+      // duplicates and the largest value, which is also the padding
+      if (size > 2) ints[1] = ints[0];
+      if (size > 3) ints[2] = std::numeric_limits<int32_t>::max();
+      auto expected_ints = ints;
+      std::sort(expected_ints.begin(), expected_ints.end());
+      ppc::core::simd_sort_block(ints.data(), ints.size());
+      EXPECT_EQ(ints, expected_ints) << "size " << size;
+
+      auto doubles = make_random_vector<double>(size, static_cast<uint32_t>(size));
+      if (size > 3) doubles[3] = -std::numeric_limits<double>::infinity();
+      auto expected_doubles = doubles;
+      std::sort(expected_doubles.begin(), expected_doubles.end());
+      ppc::core::simd_sort_block(doubles.data(), doubles.size());
+      EXPECT_EQ(doubles, expected_doubles) << "size " << size;
+    }
+  });
+}
+
+TEST_F(sort_tests, check_simd_nan_keeps_elements) {
+  // min and max of registers would return the other operand for a NaN
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  auto count_nans = [](const std::vector<double>& data) {
+    return std::count_if(data.begin(), data.end(), [](double value) { return std::isnan(value); });
+  };
+  auto without_nans = [](std::vector<double> data) {
+    data.erase(std::remove_if(data.begin(), data.end(), [](double value) { return std::isnan(value); }), data.end());
+    std::sort(data.begin(), data.end());
+    return data;
+  };
+  for_each_simd_level([&] {
+    auto block = make_random_vector<double>(ppc::core::SIMD_SORT_BLOCK_SIZE, 1);
+    block[0] = block[17] = block[40] = nan;
+    auto expected = without_nans(block);
+    ppc::core::simd_sort_block(block.data(), block.size());
+    EXPECT_EQ(count_nans(block), 3);
+    EXPECT_EQ(without_nans(block), expected);
+
+    auto a = make_random_vector<double>(100, 2);
+    auto b = make_random_vector<double>(37, 3);
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    a[50] = nan;
+    b.back() = nan;
+    std::vector<double> merged(a.size() + b.size());
+    ppc::core::simd_merge(a.data(), a.size(), b.data(), b.size(), merged.data());
+    auto inputs = a;
+    inputs.insert(inputs.end(), b.begin(), b.end());
+    EXPECT_EQ(count_nans(merged), 2);
+    EXPECT_EQ(without_nans(merged), without_nans(inputs));
+  });
+}
+
+TEST_F(sort_tests, check_simd_merge) {
+  for_each_simd_level([] {
+    for (auto [a_size, b_size] : {std::pair<size_t, size_t>{0, 0}, {0, 5}, {7, 0}, {1, 1}, {3, 100}, {64, 64},
+                                  {1000, 17}, {4093, 4099}}) {
+      auto a = make_random_vector<int32_t>(a_size, static_cast<uint32_t>(a_size));
+      auto b = make_random_vector<int32_t>(b_size, static_cast<uint32_t>(b_size + 1));
+      // few distinct values give many equal heads
+      for (auto& value : b) value %= 10;
+      std::sort(a.begin(), a.end());
+      std::sort(b.begin(), b.end());
+      std::vector<int32_t> expected(a_size + b_size);
+      std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+      std::vector<int32_t> merged(a_size + b_size);
+      ppc::core::simd_merge(a.data(), a_size, b.data(), b_size, merged.data());
+      EXPECT_EQ(merged, expected) << a_size << " + " << b_size;
+
+      auto c = make_random_vector<double>(b_size, static_cast<uint32_t>(b_size));
+      auto d = make_random_vector<double>(a_size, static_cast<uint32_t>(a_size + 2));
+      std::sort(c.begin(), c.end());
+      std::sort(d.begin(), d.end());
+      std::vector<double> expected_doubles(a_size + b_size);
+      std::merge(c.begin(), c.end(), d.begin(), d.end(), expected_doubles.begin());
+      std::vector<double> merged_doubles(a_size + b_size);
+      ppc::core::simd_merge(c.data(), b_size, d.data(), a_size, merged_doubles.data());
+      EXPECT_EQ(merged_doubles, expected_doubles) << b_size << " + " << a_size;
+    }
+  });
+}
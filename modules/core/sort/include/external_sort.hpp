@@ -0,0 +1,365 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SORT_INCLUDE_EXTERNAL_SORT_HPP_
+#define MODULES_CORE_SORT_INCLUDE_EXTERNAL_SORT_HPP_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <cstdio>
+#include <mutex>
+#endif
+
+#include "core/sort/include/sort.hpp"
+#include "core/stream/include/bounded_queue.hpp"
+
+namespace ppc::core {
+
+struct ExternalSortAttr {
+  // memory for sorting: run generation holds three runs (read ahead, sorted,
+  // written behind), the merge holds two blocks for every run and the output
+  size_t memory_bytes = size_t{768} << 20;
+  // size of one read or write request of the merge, lowered to fit memory
+  size_t block_bytes = size_t{4} << 20;
+  // directory of the temporary file of runs, system temporary directory if empty
+  std::string temp_directory;
+};
+
+struct ExternalSortStats {
+  uint64_t bytes = 0;
+  size_t num_runs = 0;
+  double run_seconds = 0.0;
+  double merge_seconds = 0.0;
+
+  [[nodiscard]] double get_seconds() const { return run_seconds + merge_seconds; }
+  // end to end throughput: bytes of the input per second of both phases
+  [[nodiscard]] double get_gbytes_per_sec() const {
+    return get_seconds() > 0.0 ? static_cast<double>(bytes) / get_seconds() / 1e9 : 0.0;
+  }
+};
+
+namespace external_sort_detail {
+
+// File of raw bytes with positional reads and writes, which may be issued
+// from several threads at once. Errors and short reads throw std::runtime_error
+class BinaryFile {
+ public:
+  // CREATE creates or truncates the file and opens it for reading and writing
+  enum class Mode { READ, CREATE };
+
+  BinaryFile(std::string path_, Mode mode);
+  ~BinaryFile();
+  BinaryFile(const BinaryFile&) = delete;
+  BinaryFile& operator=(const BinaryFile&) = delete;
+
+  [[nodiscard]] uint64_t size() const;
+  void read_at(void* data, size_t bytes, uint64_t offset) const;
+  void write_at(const void* data, size_t bytes, uint64_t offset);
+
+ private:
+  std::string path;
+#ifdef _WIN32
+  // no positional I/O in the C runtime, seek and transfer under the lock
+  std::FILE* file = nullptr;
+  mutable std::mutex mutex;
+#else
+  int fd = -1;
+#endif
+};
+
+// Thread doing file requests in order of submission, so reads ahead and
+// writes behind overlap sorting and merging on the calling thread
+class IoWorker {
+ public:
+  IoWorker();
+  // requests submitted before are finished
+  ~IoWorker();
+  IoWorker(const IoWorker&) = delete;
+  IoWorker& operator=(const IoWorker&) = delete;
+
+  // the future rethrows an exception of the request
+  std::future<void> submit(std::function<void()> request);
+
+ private:
+  BoundedQueue<std::packaged_task<void()>> queue;
+  std::thread thread;
+};
+
+// Path of a new file in the directory (the system temporary one if empty),
+// the file is removed by the destructor
+class TempFile {
+ public:
+  explicit TempFile(const std::string& directory);
+  ~TempFile();
+  TempFile(const TempFile&) = delete;
+  TempFile& operator=(const TempFile&) = delete;
+
+  [[nodiscard]] const std::string& get_path() const { return path; }
+
+ private:
+  std::string path;
+};
+
+// Sorted run read by blocks, the next block is read ahead
+template <class T>
+class RunReader {
+ public:
+  RunReader(const BinaryFile& file_, uint64_t offset_, size_t size, size_t block_size_, IoWorker& io_)
+      : file(file_), io(io_), offset(offset_), remaining(size), block_size(block_size_) {
+    request();
+    load();
+  }
+  RunReader(RunReader&&) = default;
+  ~RunReader() {
+    if (pending.valid()) pending.wait();
+  }
+
+  [[nodiscard]] bool empty() const { return position == current.size(); }
+  [[nodiscard]] const T& front() const { return current[position]; }
+  void pop() {
+    if (++position == current.size()) load();
+  }
+
+ private:
+  void request() {
+    auto count = std::min(block_size, remaining);
+    next.resize(count);
+    pending = io.submit([this_file = &file, data = next.data(), bytes = count * sizeof(T), at = offset] {
+      this_file->read_at(data, bytes, at);
+    });
+    offset += count * sizeof(T);
+    remaining -= count;
+  }
+
+  void load() {
+    position = 0;
+    if (!pending.valid()) {
+      current.clear();
+      return;
+    }
+    pending.get();
+    std::swap(current, next);
+    if (remaining > 0) request();
+  }
+
+  const BinaryFile& file;
+  IoWorker& io;
+  uint64_t offset;
+  size_t remaining;
+  size_t block_size;
+  std::vector<T> current;
+  std::vector<T> next;
+  size_t position = 0;
+  std::future<void> pending;
+};
+
+// Output written by blocks, a full block is written behind while the next
+// one is filled
+template <class T>
+class BlockWriter {
+ public:
+  BlockWriter(BinaryFile& file_, size_t block_size_, IoWorker& io_) : file(file_), io(io_), block_size(block_size_) {
+    filling.reserve(block_size);
+    writing.reserve(block_size);
+  }
+  ~BlockWriter() {
+    if (pending.valid()) pending.wait();
+  }
+  BlockWriter(const BlockWriter&) = delete;
+  BlockWriter& operator=(const BlockWriter&) = delete;
+
+  void push(const T& value) {
+    filling.push_back(value);
+    if (filling.size() == block_size) flush();
+  }
+
+  // write the rest and wait for all writes
+  void finish() {
+    flush();
+    if (pending.valid()) pending.get();
+  }
+
+ private:
+  void flush() {
+    if (filling.empty()) return;
+    if (pending.valid()) pending.get();
+    std::swap(filling, writing);
+    filling.clear();
+    pending = io.submit([this_file = &file, data = writing.data(), bytes = writing.size() * sizeof(T), at = offset] {
+      this_file->write_at(data, bytes, at);
+    });
+    offset += writing.size() * sizeof(T);
+  }
+
+  BinaryFile& file;
+  IoWorker& io;
+  size_t block_size;
+  uint64_t offset = 0;
+  std::vector<T> filling;
+  std::vector<T> writing;
+  std::future<void> pending;
+};
+
+// Tournament tree of k sources for the k-way merge: an internal node keeps
+// the loser of the match of its subtrees, so replacing the winner replays
+// only log(k) matches on its path to the root. less(i, j) compares current
+// elements of sources i and j
+template <class Less>
+class LoserTree {
+ public:
+  LoserTree(size_t size_, Less less_) : size(size_), less(std::move(less_)), losers(size_) {
+    if (size > 0) winner = build(1);
+  }
+
+  [[nodiscard]] size_t get_winner() const { return winner; }
+
+  // current element of the winner has changed
+  void replay() {
+    for (auto node = (winner + size) / 2; node > 0; node /= 2) {
+      if (less(losers[node], winner)) std::swap(losers[node], winner);
+    }
+  }
+
+ private:
+  // leaves of the sources are nodes size..2 * size - 1
+  size_t build(size_t node) {
+    if (node >= size) return node - size;
+    auto left = build(2 * node);
+    auto right = build(2 * node + 1);
+    if (less(right, left)) std::swap(left, right);
+    losers[node] = right;
+    return left;
+  }
+
+  size_t size;
+  Less less;
+  std::vector<size_t> losers;
+  size_t winner = 0;
+};
+
+}  // namespace external_sort_detail
+
+// Sort a binary file of elements of T by key(element) into another file,
+// with memory of attr.memory_bytes for inputs larger than RAM. Runs of a
+// third of the memory are sorted by inplace_radix_sort, which needs no
+// buffer of the size of a run, while the next run is read and the previous
+// one is written, then runs are merged by a loser tree with reads ahead and
+// writes behind on an I/O thread. The output file may not be
+// the input one. Throws std::invalid_argument if the size of the input isn't
+// a multiple of sizeof(T) and std::runtime_error on I/O errors
+template <class T, class Key = std::identity, class Backend = StlSortBackend>
+  requires RadixSortable<T, Key>
+ExternalSortStats external_sort(const std::string& input_path, const std::string& output_path,
+                                const ExternalSortAttr& attr = {}, const Key& key = {}, const Backend& backend = {}) {
+  using external_sort_detail::BinaryFile;
+  using Clock = std::chrono::steady_clock;
+  auto start = Clock::now();
+
+  BinaryFile input(input_path, BinaryFile::Mode::READ);
+  ExternalSortStats stats;
+  stats.bytes = input.size();
+  if (stats.bytes % sizeof(T) != 0) {
+    throw std::invalid_argument("Size of " + input_path + " isn't a multiple of the element size");
+  }
+  auto size = static_cast<size_t>(stats.bytes / sizeof(T));
+  auto run_size = std::max<size_t>(1, attr.memory_bytes / 3 / sizeof(T));
+  stats.num_runs = (size + run_size - 1) / run_size;
+
+  BinaryFile output(output_path, BinaryFile::Mode::CREATE);
+  // a single run is written to the output at once
+  std::unique_ptr<external_sort_detail::TempFile> temp;
+  std::unique_ptr<BinaryFile> runs_file;
+  if (stats.num_runs > 1) {
+    temp = std::make_unique<external_sort_detail::TempFile>(attr.temp_directory);
+    runs_file = std::make_unique<BinaryFile>(temp->get_path(), BinaryFile::Mode::CREATE);
+  }
+  BinaryFile& runs = stats.num_runs > 1 ? *runs_file : output;
+
+  // buffers outlive requests of the I/O thread, which are finished by its destructor
+  std::array<std::vector<T>, 3> buffers;
+  {
+    external_sort_detail::IoWorker io;
+    auto read_run = [&](size_t run) {
+      auto& buffer = buffers[run % 3];
+      buffer.resize(std::min(run_size, size - run * run_size));
+      auto bytes = buffer.size() * sizeof(T);
+      return io.submit([&input, data = buffer.data(), bytes, at = run * run_size * sizeof(T)] {
+        input.read_at(data, bytes, at);
+      });
+    };
+    std::future<void> reading;
+    std::future<void> writing;
+    if (stats.num_runs > 0) reading = read_run(0);
+    for (size_t run = 0; run < stats.num_runs; run++) {
+      reading.get();
+      // buffer of the run after the next one was written two runs ago
+      if (run + 1 < stats.num_runs) reading = read_run(run + 1);
+      auto& buffer = buffers[run % 3];
+      inplace_radix_sort(std::span<T>(buffer), key, backend);
+      if (writing.valid()) writing.get();
+      auto bytes = buffer.size() * sizeof(T);
+      writing = io.submit([&runs, data = buffer.data(), bytes, at = run * run_size * sizeof(T)] {
+        runs.write_at(data, bytes, at);
+      });
+    }
+    if (writing.valid()) writing.get();
+  }
+  for (auto& buffer : buffers) std::vector<T>().swap(buffer);
+  auto merge_start = Clock::now();
+  stats.run_seconds = std::chrono::duration<double>(merge_start - start).count();
+  if (stats.num_runs <= 1) return stats;
+
+  auto block_size = std::max<size_t>(1, std::min(attr.block_bytes, attr.memory_bytes / (2 * (stats.num_runs + 1))) /
+                                            sizeof(T));
+  external_sort_detail::IoWorker io;
+  std::vector<external_sort_detail::RunReader<T>> readers;
+  readers.reserve(stats.num_runs);
+  for (size_t run = 0; run < stats.num_runs; run++) {
+    readers.emplace_back(runs, run * run_size * sizeof(T), std::min(run_size, size - run * run_size), block_size, io);
+  }
+  // keys of the heads of runs, exhausted runs lose to all others and equal
+  // keys are taken from earlier runs
+  using Radix = RadixKey<sort_key_t<T, Key>>;
+  std::vector<typename Radix::Bits> heads(readers.size());
+  std::vector<char> exhausted(readers.size());
+  for (size_t run = 0; run < readers.size(); run++) heads[run] = Radix::to_bits(std::invoke(key, readers[run].front()));
+  auto less = [&heads, &exhausted](size_t i, size_t j) {
+    if (exhausted[i] != 0) return false;
+    if (exhausted[j] != 0) return true;
+    return heads[i] < heads[j] || (heads[i] == heads[j] && i < j);
+  };
+  external_sort_detail::LoserTree<decltype(less)> tree(readers.size(), less);
+  external_sort_detail::BlockWriter<T> writer(output, block_size, io);
+  for (size_t i = 0; i < size; i++) {
+    auto run = tree.get_winner();
+    auto& reader = readers[run];
+    writer.push(reader.front());
+    reader.pop();
+    if (reader.empty()) {
+      exhausted[run] = 1;
+    } else {
+      heads[run] = Radix::to_bits(std::invoke(key, reader.front()));
+    }
+    tree.replay();
+  }
+  writer.finish();
+  stats.merge_seconds = std::chrono::duration<double>(Clock::now() - merge_start).count();
+  return stats;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SORT_INCLUDE_EXTERNAL_SORT_HPP_
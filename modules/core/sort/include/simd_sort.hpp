@@ -0,0 +1,31 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SORT_INCLUDE_SIMD_SORT_HPP_
+#define MODULES_CORE_SORT_INCLUDE_SIMD_SORT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/threads/include/simd.hpp"
+
+namespace ppc::core {
+
+// Blocks up to this size are sorted in registers by simd_sort_block
+constexpr size_t SIMD_SORT_BLOCK_SIZE = 64;
+
+// Sort a block of at most SIMD_SORT_BLOCK_SIZE elements with a bitonic
+// network over vector registers, throws std::invalid_argument for larger
+// blocks. Blocks with NaNs are sorted by scalar code: the result is a
+// permutation of them, but NaNs don't compare, so its order is unspecified
+void simd_sort_block(int32_t* data, size_t size);
+void simd_sort_block(double* data, size_t size);
+
+// Merge sorted a and b into out, which must not overlap them. Each step
+// merges two registers by a bitonic network instead of a branch per element.
+// Inputs with NaNs are merged by std::merge, like blocks of simd_sort_block
+void simd_merge(const int32_t* a, size_t a_size, const int32_t* b, size_t b_size, int32_t* out);
+void simd_merge(const double* a, size_t a_size, const double* b, size_t b_size, double* out);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SORT_INCLUDE_SIMD_SORT_HPP_
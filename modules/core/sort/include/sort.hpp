@@ -0,0 +1,593 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SORT_INCLUDE_SORT_HPP_
+#define MODULES_CORE_SORT_INCLUDE_SORT_HPP_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sort/include/sorting_network.hpp"
+
+namespace ppc::core {
+
+// Unsigned integer of the same size whose order is the order of keys:
+// sign bit of signed integers is flipped, negative IEEE-754 numbers are
+// inverted and positive ones get the sign bit. -0.0 goes before +0.0, NaNs
+// go to the ends by their sign
+template <class K>
+struct RadixKey;
+
+template <class K>
+  requires(std::is_integral_v<K> && !std::is_same_v<K, bool>)
+struct RadixKey<K> {
+  using Bits = std::make_unsigned_t<K>;
+  static Bits to_bits(K key) {
+    auto bits = static_cast<Bits>(key);
+    if constexpr (std::is_signed_v<K>) bits ^= Bits{1} << (sizeof(K) * 8 - 1);
+    return bits;
+  }
+};
+
+template <class K>
+  requires(std::is_floating_point_v<K> && (sizeof(K) == 4 || sizeof(K) == 8))
+struct RadixKey<K> {
+  using Bits = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+  static Bits to_bits(K key) {
+    auto bits = std::bit_cast<Bits>(key);
+    constexpr auto sign = Bits{1} << (sizeof(K) * 8 - 1);
+    Bits mask = (bits & sign) != 0 ? ~Bits{0} : sign;
+    return bits ^ mask;
+  }
+};
+
+// Key extractor returns an integer or floating point key of an element
+template <class T, class Key>
+using sort_key_t = std::remove_cvref_t<std::invoke_result_t<const Key&, const T&>>;
+
+template <class T, class Key>
+concept RadixSortable =
+    std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && requires(const Key& key, const T& item) {
+      RadixKey<sort_key_t<T, Key>>::to_bits(std::invoke(key, item));
+    };
+
+namespace sort_detail {
+
+constexpr size_t RADIX_SIZE = 256;
+// parallel passes split data into chunks of at least this size
+constexpr size_t MIN_CHUNK_SIZE = size_t{1} << 14;
+// smaller parts are sorted by comparisons
+constexpr size_t SMALL_SORT_SIZE = 1024;
+
+template <class T, class Key>
+auto get_bits(const Key& key, const T& item) {
+  return RadixKey<sort_key_t<T, Key>>::to_bits(std::invoke(key, item));
+}
+
+template <class T, class Key>
+size_t get_digit(const Key& key, const T& item, int shift) {
+  return static_cast<size_t>((get_bits(key, item) >> shift) & (RADIX_SIZE - 1));
+}
+
+template <class Backend>
+size_t get_num_chunks(const Backend& backend, size_t size) {
+  return std::clamp<size_t>(size / MIN_CHUNK_SIZE, 1, static_cast<size_t>(std::max(1, backend.get_num_threads())));
+}
+
+inline size_t get_chunk_begin(size_t chunk, size_t num_chunks, size_t size) { return chunk * size / num_chunks; }
+
+template <class T, class Key>
+void insertion_sort(T* data, size_t size, const Key& key) {
+  for (size_t i = 1; i < size; i++) {
+    T item = data[i];
+    auto bits = get_bits(key, item);
+    auto j = i;
+    for (; j > 0 && bits < get_bits(key, data[j - 1]); j--) data[j] = data[j - 1];
+    data[j] = item;
+  }
+}
+
+// Not stable, for buckets of MSD and sample sorts
+template <class T, class Key>
+void small_sort(T* data, size_t size, const Key& key) {
+  auto less = [&key](const T& a, const T& b) { return get_bits(key, a) < get_bits(key, b); };
+  if (size <= SORTING_NETWORK_MAX_SIZE) {
+    network_sort(data, size, less);
+  } else {
+    std::sort(data, data + size, less);
+  }
+}
+
+// Payload type of sorts which move only elements
+struct NoPayload {};
+
+template <class V>
+constexpr bool has_payload = !std::is_same_v<V, NoPayload>;
+
+// Stable LSD passes over bytes [0, num_bytes) from one array to another,
+// payload (if any) is moved in the same passes. Passes where all keys have
+// the same digit are skipped. Returns true if the result is in `to` arrays
+template <class T, class V, class Key>
+bool lsd_passes(T* from, T* to, V* from_values, V* to_values, size_t size, const Key& key, int num_bytes) {
+  // counts of all passes are taken in one read, they don't depend on order
+  std::vector<std::array<size_t, RADIX_SIZE>> byte_counts(static_cast<size_t>(num_bytes));
+  for (size_t i = 0; i < size; i++) {
+    auto bits = get_bits(key, from[i]);
+    for (int byte = 0; byte < num_bytes; byte++) {
+      byte_counts[byte][static_cast<size_t>((bits >> (byte * 8)) & (RADIX_SIZE - 1))]++;
+    }
+  }
+
+  bool swapped = false;
+  for (int byte = 0; byte < num_bytes; byte++) {
+    auto& counts = byte_counts[byte];
+    if (std::find(counts.begin(), counts.end(), size) != counts.end()) continue;
+
+    size_t offset = 0;
+    for (auto& count : counts) {
+      auto current = count;
+      count = offset;
+      offset += current;
+    }
+    for (size_t i = 0; i < size; i++) {
+      auto position = counts[get_digit(key, from[i], byte * 8)]++;
+      to[position] = from[i];
+      if constexpr (has_payload<V>) to_values[position] = from_values[i];
+    }
+    std::swap(from, to);
+    std::swap(from_values, to_values);
+    swapped = !swapped;
+  }
+  return swapped;
+}
+
+// Per-chunk digit counts of one pass, turned into scatter offsets in place:
+// digit-major order over chunks keeps the pass stable. Returns false if all
+// keys have the same digit and the pass may be skipped
+template <class T, class Key, class Backend>
+bool count_digits(const T* data, size_t size, const Key& key, int shift, size_t num_chunks,
+                  std::vector<size_t>& counts, const Backend& backend) {
+  counts.assign(num_chunks * RADIX_SIZE, 0);
+  backend.for_each(num_chunks, [&](size_t chunk) {
+    auto* chunk_counts = counts.data() + chunk * RADIX_SIZE;
+    auto end = get_chunk_begin(chunk + 1, num_chunks, size);
+    for (auto i = get_chunk_begin(chunk, num_chunks, size); i < end; i++) {
+      chunk_counts[get_digit(key, data[i], shift)]++;
+    }
+  });
+
+  size_t offset = 0;
+  for (size_t digit = 0; digit < RADIX_SIZE; digit++) {
+    auto digit_begin = offset;
+    for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+      auto current = counts[chunk * RADIX_SIZE + digit];
+      counts[chunk * RADIX_SIZE + digit] = offset;
+      offset += current;
+    }
+    if (offset - digit_begin == size) return false;
+  }
+  return true;
+}
+
+template <class T, class V, class Key, class Backend>
+void scatter_digits(const T* from, T* to, const V* from_values, V* to_values, size_t size, const Key& key, int shift,
+                    size_t num_chunks, std::vector<size_t>& offsets, const Backend& backend) {
+  backend.for_each(num_chunks, [&](size_t chunk) {
+    auto* chunk_offsets = offsets.data() + chunk * RADIX_SIZE;
+    auto end = get_chunk_begin(chunk + 1, num_chunks, size);
+    for (auto i = get_chunk_begin(chunk, num_chunks, size); i < end; i++) {
+      auto position = chunk_offsets[get_digit(key, from[i], shift)]++;
+      to[position] = from[i];
+      if constexpr (has_payload<V>) to_values[position] = from_values[i];
+    }
+  });
+}
+
+template <class T, class Backend>
+void parallel_copy(const T* from, T* to, size_t size, const Backend& backend) {
+  auto num_chunks = get_num_chunks(backend, size);
+  backend.for_each(num_chunks, [&](size_t chunk) {
+    std::copy(from + get_chunk_begin(chunk, num_chunks, size), from + get_chunk_begin(chunk + 1, num_chunks, size),
+              to + get_chunk_begin(chunk, num_chunks, size));
+  });
+}
+
+}  // namespace sort_detail
+
+namespace sort_detail {
+
+// LSD radix sort of elements and their payload: per-chunk histograms and
+// scatter of every pass run in parallel on the backend
+template <class T, class V, class Key, class Backend>
+void lsd_sort(T* data, V* values, size_t size, const Key& key, const Backend& backend) {
+  constexpr int num_bytes = sizeof(typename RadixKey<sort_key_t<T, Key>>::Bits);
+  auto buffer = std::make_unique_for_overwrite<T[]>(size);
+  std::unique_ptr<V[]> values_buffer;
+  if constexpr (has_payload<V>) values_buffer = std::make_unique_for_overwrite<V[]>(size);
+
+  auto num_chunks = get_num_chunks(backend, size);
+  if (num_chunks == 1) {
+    if (lsd_passes(data, buffer.get(), values, values_buffer.get(), size, key, num_bytes)) {
+      std::copy(buffer.get(), buffer.get() + size, data);
+      if constexpr (has_payload<V>) std::copy(values_buffer.get(), values_buffer.get() + size, values);
+    }
+    return;
+  }
+
+  T* from = data;
+  T* to = buffer.get();
+  V* from_values = values;
+  V* to_values = values_buffer.get();
+  std::vector<size_t> offsets;
+  for (int byte = 0; byte < num_bytes; byte++) {
+    if (!count_digits(from, size, key, byte * 8, num_chunks, offsets, backend)) continue;
+    scatter_digits(from, to, from_values, to_values, size, key, byte * 8, num_chunks, offsets, backend);
+    std::swap(from, to);
+    std::swap(from_values, to_values);
+  }
+  if (from != data) {
+    parallel_copy(from, data, size, backend);
+    if constexpr (has_payload<V>) parallel_copy(from_values, values, size, backend);
+  }
+}
+
+// Sequential in-place MSD radix sort (American flag sort) from the byte
+// down: elements are swapped along cycles into their buckets, then buckets
+// are sorted by the lower bytes. Bytes where all keys are equal are skipped
+template <class T, class Key>
+void american_flag_sort(T* data, size_t size, const Key& key, int byte) {
+  if (size <= SMALL_SORT_SIZE) {
+    small_sort(data, size, key);
+    return;
+  }
+  std::array<size_t, RADIX_SIZE> heads;
+  std::array<size_t, RADIX_SIZE> ends;
+  while (true) {
+    ends.fill(0);
+    for (size_t i = 0; i < size; i++) ends[get_digit(key, data[i], byte * 8)]++;
+    if (std::find(ends.begin(), ends.end(), size) == ends.end()) break;
+    if (byte-- == 0) return;
+  }
+  size_t offset = 0;
+  for (size_t digit = 0; digit < RADIX_SIZE; digit++) {
+    heads[digit] = offset;
+    offset += ends[digit];
+    ends[digit] = offset;
+  }
+
+  for (size_t digit = 0; digit < RADIX_SIZE; digit++) {
+    while (heads[digit] < ends[digit]) {
+      T item = data[heads[digit]];
+      auto target = get_digit(key, item, byte * 8);
+      while (target != digit) {
+        std::swap(item, data[heads[target]++]);
+        target = get_digit(key, item, byte * 8);
+      }
+      data[heads[digit]++] = item;
+    }
+  }
+  if (byte == 0) return;
+  size_t begin = 0;
+  for (auto end : ends) {
+    american_flag_sort(data + begin, end - begin, key, byte - 1);
+    begin = end;
+  }
+}
+
+// Bucket digit after a round of the cooperative permutation: in every
+// stripe [heads, limits) holds elements which didn't fit, the rest of the
+// stripe is in place. Misplaced elements are swapped with placed ones from
+// the end of the bucket, returns the begin of the misplaced part
+template <class T, class Key>
+size_t repair_bucket(T* data, const Key& key, int shift, size_t digit, size_t end,
+                     const std::vector<std::array<size_t, RADIX_SIZE>>& heads,
+                     const std::vector<std::array<size_t, RADIX_SIZE>>& limits) {
+  auto tail = end;
+  for (size_t stripe = 0; stripe < heads.size(); stripe++) {
+    for (auto i = heads[stripe][digit]; i < limits[stripe][digit] && i < tail; i++) {
+      do {
+        tail--;
+      } while (tail > i && get_digit(key, data[tail], shift) != digit);
+      if (tail == i) return tail;
+      std::swap(data[i], data[tail]);
+    }
+  }
+  return tail;
+}
+
+// Move elements into buckets [heads, ends) of the digit in place, in the
+// rounds of PARADIS (Cho et al., VLDB 2015): remaining part of every bucket
+// is split into stripes, one per thread, and each thread swaps elements
+// along cycles within its stripes only, so threads don't synchronize. Then
+// buckets are repaired in parallel and the next round permutes the rest. A
+// round of one stripe places everything, it is taken for small rests or
+// when a round makes no progress
+template <class T, class Key, class Backend>
+void cooperative_permutation(T* data, const Key& key, int shift, std::array<size_t, RADIX_SIZE> heads,
+                             const std::array<size_t, RADIX_SIZE>& ends, const Backend& backend) {
+  auto num_threads = static_cast<size_t>(std::max(1, backend.get_num_threads()));
+  auto get_remaining = [&] {
+    size_t remaining = 0;
+    for (size_t digit = 0; digit < RADIX_SIZE; digit++) remaining += ends[digit] - heads[digit];
+    return remaining;
+  };
+  std::vector<std::array<size_t, RADIX_SIZE>> stripe_heads;
+  std::vector<std::array<size_t, RADIX_SIZE>> stripe_ends;
+  std::vector<std::array<size_t, RADIX_SIZE>> stripe_limits;
+  auto remaining = get_remaining();
+  bool progress = true;
+  while (remaining > 0) {
+    auto num_stripes = progress && remaining >= MIN_CHUNK_SIZE ? num_threads : 1;
+    stripe_heads.resize(num_stripes);
+    stripe_ends.resize(num_stripes);
+    for (size_t stripe = 0; stripe < num_stripes; stripe++) {
+      for (size_t digit = 0; digit < RADIX_SIZE; digit++) {
+        auto size = ends[digit] - heads[digit];
+        stripe_heads[stripe][digit] = heads[digit] + get_chunk_begin(stripe, num_stripes, size);
+        stripe_ends[stripe][digit] = heads[digit] + get_chunk_begin(stripe + 1, num_stripes, size);
+      }
+    }
+    stripe_limits = stripe_ends;
+
+    backend.for_each(num_stripes, [&](size_t stripe) {
+      auto& own_heads = stripe_heads[stripe];
+      auto& own_ends = stripe_ends[stripe];
+      for (size_t digit = 0; digit < RADIX_SIZE; digit++) {
+        while (own_heads[digit] < own_ends[digit]) {
+          T item = data[own_heads[digit]];
+          auto target = get_digit(key, item, shift);
+          while (target != digit && own_heads[target] < own_ends[target]) {
+            std::swap(item, data[own_heads[target]++]);
+            target = get_digit(key, item, shift);
+          }
+          if (target == digit) {
+            data[own_heads[digit]++] = item;
+            continue;
+          }
+          // no place for the item in own stripes, it goes to the end of the
+          // stripe and an unseen element of the end takes its place
+          auto last = --own_ends[digit];
+          if (last != own_heads[digit]) data[own_heads[digit]] = data[last];
+          data[last] = item;
+        }
+      }
+    });
+
+    backend.for_each(RADIX_SIZE, [&](size_t digit) {
+      heads[digit] = repair_bucket(data, key, shift, digit, ends[digit], stripe_heads, stripe_limits);
+    });
+    auto rest = get_remaining();
+    progress = rest < remaining;
+    remaining = rest;
+  }
+}
+
+// In-place MSD radix sort from the byte down: the top differing digit is
+// counted by per-chunk histograms and permuted cooperatively, buckets
+// larger than a share of a thread are sorted by the same parallel steps,
+// others in parallel by sequential American flag sort
+template <class T, class Key, class Backend>
+void inplace_msd_sort(T* data, size_t size, const Key& key, int byte, const Backend& backend) {
+  auto num_chunks = get_num_chunks(backend, size);
+  if (num_chunks == 1) {
+    american_flag_sort(data, size, key, byte);
+    return;
+  }
+  std::vector<size_t> offsets;
+  while (!count_digits(data, size, key, byte * 8, num_chunks, offsets, backend)) {
+    // all keys are equal
+    if (byte-- == 0) return;
+  }
+  // offsets of the first chunk are the begins of buckets
+  std::array<size_t, RADIX_SIZE> begins;
+  std::array<size_t, RADIX_SIZE> ends;
+  std::copy(offsets.begin(), offsets.begin() + RADIX_SIZE, begins.begin());
+  std::copy(begins.begin() + 1, begins.end(), ends.begin());
+  ends[RADIX_SIZE - 1] = size;
+  cooperative_permutation(data, key, byte * 8, begins, ends, backend);
+  if (byte == 0) return;
+
+  auto large_size = size / num_chunks;
+  for (size_t digit = 0; digit < RADIX_SIZE; digit++) {
+    if (ends[digit] - begins[digit] > large_size) {
+      inplace_msd_sort(data + begins[digit], ends[digit] - begins[digit], key, byte - 1, backend);
+    }
+  }
+  backend.for_each(RADIX_SIZE, [&](size_t digit) {
+    auto bucket_size = ends[digit] - begins[digit];
+    if (bucket_size <= large_size) american_flag_sort(data + begins[digit], bucket_size, key, byte - 1);
+  });
+}
+
+}  // namespace sort_detail
+
+// Stable LSD radix sort by 8-bit digits of key(element)
+template <class T, class Key = std::identity, class Backend = StlSortBackend>
+  requires RadixSortable<T, Key>
+void radix_sort(std::span<T> data, const Key& key = {}, const Backend& backend = {}) {
+  if (data.size() <= SORTING_NETWORK_MAX_SIZE) {
+    sort_detail::insertion_sort(data.data(), data.size(), key);
+    return;
+  }
+  sort_detail::lsd_sort(data.data(), static_cast<sort_detail::NoPayload*>(nullptr), data.size(), key, backend);
+}
+
+// Stable LSD radix sort of keys with payload in separate arrays (struct of
+// arrays): values[i] is moved with keys[i] in the same scatter passes, and
+// only keys are read to build histograms
+template <class K, class V, class Backend = StlSortBackend>
+  requires RadixSortable<K, std::identity> && std::is_trivially_copyable_v<V> && std::is_default_constructible_v<V>
+void radix_sort_pairs(std::span<K> keys, std::span<V> values, const Backend& backend = {}) {
+  if (keys.size() != values.size()) throw std::invalid_argument("radix_sort_pairs: sizes of keys and values differ");
+  sort_detail::lsd_sort(keys.data(), values.data(), keys.size(), std::identity(), backend);
+}
+
+// Permutation which sorts data by key(element) stably: data[result[i]] is
+// the i-th element in sorted order. Keys are extracted once and sorted with
+// indices as payload
+template <class Index = uint32_t, class T, class Key = std::identity, class Backend = StlSortBackend>
+  requires RadixSortable<T, Key> && std::is_unsigned_v<Index>
+std::vector<Index> argsort(std::span<const T> data, const Key& key = {}, const Backend& backend = {}) {
+  if (data.size() > static_cast<size_t>(std::numeric_limits<Index>::max())) {
+    throw std::invalid_argument("argsort: too many elements for the index type");
+  }
+  auto size = data.size();
+  auto keys = std::make_unique_for_overwrite<sort_key_t<T, Key>[]>(size);
+  std::vector<Index> indices(size);
+  auto num_chunks = sort_detail::get_num_chunks(backend, size);
+  backend.for_each(num_chunks, [&](size_t chunk) {
+    auto end = sort_detail::get_chunk_begin(chunk + 1, num_chunks, size);
+    for (auto i = sort_detail::get_chunk_begin(chunk, num_chunks, size); i < end; i++) {
+      keys[i] = std::invoke(key, data[i]);
+      indices[i] = static_cast<Index>(i);
+    }
+  });
+  radix_sort_pairs(std::span(keys.get(), size), std::span<Index>(indices), backend);
+  return indices;
+}
+
+// MSD radix sort, not stable: the highest digit which differs is scattered
+// in parallel, then buckets are sorted in parallel by LSD passes over the
+// lower digits, small buckets by the sorting network or comparisons
+template <class T, class Key = std::identity, class Backend = StlSortBackend>
+  requires RadixSortable<T, Key>
+void msd_radix_sort(std::span<T> data, const Key& key = {}, const Backend& backend = {}) {
+  auto size = data.size();
+  if (size <= sort_detail::SMALL_SORT_SIZE) {
+    sort_detail::small_sort(data.data(), size, key);
+    return;
+  }
+  constexpr int num_bytes = sizeof(typename RadixKey<sort_key_t<T, Key>>::Bits);
+  auto num_chunks = sort_detail::get_num_chunks(backend, size);
+
+  std::vector<size_t> offsets;
+  auto byte = num_bytes - 1;
+  while (!sort_detail::count_digits(data.data(), size, key, byte * 8, num_chunks, offsets, backend)) {
+    // all keys are equal
+    if (byte-- == 0) return;
+  }
+  auto buffer = std::make_unique_for_overwrite<T[]>(size);
+  auto* no_payload = static_cast<sort_detail::NoPayload*>(nullptr);
+  sort_detail::scatter_digits(data.data(), buffer.get(), no_payload, no_payload, size, key, byte * 8, num_chunks,
+                              offsets, backend);
+
+  // after the scatter offsets of the last chunk are the ends of buckets
+  const auto* bucket_ends = offsets.data() + (num_chunks - 1) * sort_detail::RADIX_SIZE;
+  backend.for_each(sort_detail::RADIX_SIZE, [&](size_t digit) {
+    auto begin = digit == 0 ? 0 : bucket_ends[digit - 1];
+    auto bucket_size = bucket_ends[digit] - begin;
+    auto* bucket = buffer.get() + begin;
+    auto* result = data.data() + begin;
+    if (bucket_size <= sort_detail::SMALL_SORT_SIZE || byte == 0) {
+      std::copy(bucket, bucket + bucket_size, result);
+      if (byte > 0) sort_detail::small_sort(result, bucket_size, key);
+      return;
+    }
+    if (!sort_detail::lsd_passes(bucket, result, no_payload, no_payload, bucket_size, key, byte)) {
+      std::copy(bucket, bucket + bucket_size, result);
+    }
+  });
+}
+
+// In-place MSD radix sort, not stable: needs no buffer of the size of data
+// unlike radix_sort and msd_radix_sort, so arrays near the memory limit can
+// be sorted, and passes only over the digits which differ. Small buckets are
+// sorted by the sorting network or comparisons
+template <class T, class Key = std::identity, class Backend = StlSortBackend>
+  requires RadixSortable<T, Key>
+void inplace_radix_sort(std::span<T> data, const Key& key = {}, const Backend& backend = {}) {
+  constexpr int num_bytes = sizeof(typename RadixKey<sort_key_t<T, Key>>::Bits);
+  sort_detail::inplace_msd_sort(data.data(), data.size(), key, num_bytes - 1, backend);
+}
+
+// Comparison sample sort for keys without radix order: splitters from a
+// regular sample split data into buckets (several per thread for balance),
+// which are scattered and sorted in parallel. Not stable
+template <class T, class Less = std::less<>, class Backend = StlSortBackend>
+  requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+void sample_sort(std::span<T> data, const Less& less = {}, const Backend& backend = {}) {
+  constexpr size_t BUCKETS_PER_THREAD = 4;
+  constexpr size_t OVERSAMPLING = 16;
+  auto size = data.size();
+  auto num_chunks = sort_detail::get_num_chunks(backend, size);
+  if (num_chunks == 1) {
+    std::sort(data.begin(), data.end(), less);
+    return;
+  }
+
+  auto num_buckets = static_cast<size_t>(backend.get_num_threads()) * BUCKETS_PER_THREAD;
+  std::vector<T> sample(num_buckets * OVERSAMPLING);
+  for (size_t i = 0; i < sample.size(); i++) sample[i] = data[i * size / sample.size()];
+  std::sort(sample.begin(), sample.end(), less);
+  std::vector<T> splitters(num_buckets - 1);
+  for (size_t i = 0; i < splitters.size(); i++) splitters[i] = sample[(i + 1) * OVERSAMPLING];
+  auto get_bucket = [&](const T& item) {
+    return static_cast<size_t>(std::upper_bound(splitters.begin(), splitters.end(), item, less) - splitters.begin());
+  };
+
+  std::vector<size_t> offsets(num_chunks * num_buckets, 0);
+  backend.for_each(num_chunks, [&](size_t chunk) {
+    auto end = sort_detail::get_chunk_begin(chunk + 1, num_chunks, size);
+    for (auto i = sort_detail::get_chunk_begin(chunk, num_chunks, size); i < end; i++) {
+      offsets[chunk * num_buckets + get_bucket(data[i])]++;
+    }
+  });
+  std::vector<size_t> bucket_begins(num_buckets + 1, 0);
+  for (size_t bucket = 0, offset = 0; bucket < num_buckets; bucket++) {
+    bucket_begins[bucket] = offset;
+    for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+      auto current = offsets[chunk * num_buckets + bucket];
+      offsets[chunk * num_buckets + bucket] = offset;
+      offset += current;
+    }
+  }
+  bucket_begins[num_buckets] = size;
+
+  auto buffer = std::make_unique_for_overwrite<T[]>(size);
+  backend.for_each(num_chunks, [&](size_t chunk) {
+    auto* chunk_offsets = offsets.data() + chunk * num_buckets;
+    auto end = sort_detail::get_chunk_begin(chunk + 1, num_chunks, size);
+    for (auto i = sort_detail::get_chunk_begin(chunk, num_chunks, size); i < end; i++) {
+      buffer[chunk_offsets[get_bucket(data[i])]++] = data[i];
+    }
+  });
+
+  backend.for_each(num_buckets, [&](size_t bucket) {
+    auto* begin = buffer.get() + bucket_begins[bucket];
+    auto* end = buffer.get() + bucket_begins[bucket + 1];
+    if (static_cast<size_t>(end - begin) <= SORTING_NETWORK_MAX_SIZE) {
+      network_sort(begin, static_cast<size_t>(end - begin), less);
+    } else {
+      std::sort(begin, end, less);
+    }
+    std::copy(begin, end, data.data() + bucket_begins[bucket]);
+  });
+}
+
+// Sort by key(element) with the fastest algorithm for the size: MSD radix
+// for large arrays of 64-bit keys, where the parallel first pass leaves
+// cache-sized buckets, stable LSD radix otherwise. Not stable
+template <class T, class Key = std::identity, class Backend = StlSortBackend>
+  requires RadixSortable<T, Key>
+void parallel_sort(std::span<T> data, const Key& key = {}, const Backend& backend = {}) {
+  constexpr size_t MSD_MIN_SIZE = size_t{1} << 16;
+  if (sizeof(typename RadixKey<sort_key_t<T, Key>>::Bits) >= 8 && data.size() >= MSD_MIN_SIZE) {
+    msd_radix_sort(data, key, backend);
+  } else {
+    radix_sort(data, key, backend);
+  }
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SORT_INCLUDE_SORT_HPP_
@@ -0,0 +1,60 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SORT_INCLUDE_SORT_BACKEND_HPP_
+#define MODULES_CORE_SORT_INCLUDE_SORT_BACKEND_HPP_
+
+#include <cstddef>
+
+#include "core/threads/include/thread_pool.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace ppc::core {
+
+// Backends of parallel sorts: get_num_threads() is a number of workers and
+// for_each(count, body) calls body(index) for every index of [0, count),
+// indices are independent coarse jobs (chunks of data, buckets). TBB backend
+// is in sort_tbb.hpp, so the core library doesn't depend on TBB
+
+struct SeqSortBackend {
+  [[nodiscard]] int get_num_threads() const { return 1; }
+
+  template <class Body>
+  void for_each(size_t count, const Body& body) const {
+    for (size_t index = 0; index < count; index++) body(index);
+  }
+};
+
+struct OmpSortBackend {
+  [[nodiscard]] int get_num_threads() const { return ppc::core::get_num_threads(); }
+
+  template <class Body>
+  void for_each(size_t count, const Body& body) const {
+#ifdef _OPENMP
+    auto size = static_cast<int>(count);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int index = 0; index < size; index++) body(static_cast<size_t>(index));
+#else
+    SeqSortBackend().for_each(count, body);
+#endif
+  }
+};
+
+// Jobs on the shared ThreadPool of the core, for STL tasks
+struct StlSortBackend {
+  [[nodiscard]] int get_num_threads() const { return ppc::core::get_num_threads(); }
+
+  template <class Body>
+  void for_each(size_t count, const Body& body) const {
+    if (count == 0) return;
+    TaskGroup group;
+    for (size_t index = 1; index < count; index++) {
+      group.run([&body, index] { body(index); });
+    }
+    body(0);
+    group.wait();
+  }
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SORT_INCLUDE_SORT_BACKEND_HPP_
@@ -0,0 +1,27 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SORT_INCLUDE_SORT_TBB_HPP_
+#define MODULES_CORE_SORT_INCLUDE_SORT_TBB_HPP_
+
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_arena.h>
+
+#include <cstddef>
+
+#include "core/sort/include/sort.hpp"
+
+namespace ppc::core {
+
+// Backend of parallel sorts for TBB tasks, header-only like TbbPinningObserver
+struct TbbSortBackend {
+  [[nodiscard]] int get_num_threads() const { return oneapi::tbb::this_task_arena::max_concurrency(); }
+
+  template <class Body>
+  void for_each(size_t count, const Body& body) const {
+    oneapi::tbb::parallel_for(size_t{0}, count, [&](size_t index) { body(index); });
+  }
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SORT_INCLUDE_SORT_TBB_HPP_
@@ -0,0 +1,49 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SORT_INCLUDE_SORTING_NETWORK_HPP_
+#define MODULES_CORE_SORT_INCLUDE_SORTING_NETWORK_HPP_
+
+#include <bit>
+#include <cstddef>
+
+namespace ppc::core {
+
+// Blocks up to this size are sorted by the network inside parallel sorts
+constexpr size_t SORTING_NETWORK_MAX_SIZE = 32;
+
+// Order two elements without a branch on the result of comparison
+template <class T, class Less>
+inline void compare_exchange(T& a, T& b, const Less& less) {
+  T x = a;
+  T y = b;
+  bool swap = less(y, x);
+  a = swap ? y : x;
+  b = swap ? x : y;
+}
+
+// Batcher's odd-even merge exchange network for any size (Knuth, TAOCP
+// vol. 3, 5.2.2, algorithm M). Sequence of comparisons doesn't depend on the
+// data, so small blocks are sorted without mispredicted branches; not stable
+template <class T, class Less>
+void network_sort(T* data, size_t size, const Less& less) {
+  if (size < 2) return;
+  auto top = size_t{1} << (std::bit_width(size - 1) - 1);
+  for (auto p = top; p > 0; p >>= 1) {
+    auto q = top;
+    size_t r = 0;
+    auto d = p;
+    while (true) {
+      for (size_t i = 0; i + d < size; i++) {
+        if ((i & p) == r) compare_exchange(data[i], data[i + d], less);
+      }
+      if (q == p) break;
+      d = q - p;
+      q >>= 1;
+      r = p;
+    }
+  }
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SORT_INCLUDE_SORTING_NETWORK_HPP_
@@ -0,0 +1,128 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sort/include/external_sort.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+[[noreturn]] void throw_io_error(const std::string& what, const std::string& path) {
+  throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+ppc::core::external_sort_detail::BinaryFile::BinaryFile(std::string path_, Mode mode) : path(std::move(path_)) {
+#ifdef _WIN32
+  file = std::fopen(path.c_str(), mode == Mode::READ ? "rb" : "w+b");
+  if (file == nullptr) throw_io_error("Can't open", path);
+#else
+  fd = mode == Mode::READ ? ::open(path.c_str(), O_RDONLY) : ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) throw_io_error("Can't open", path);
+#endif
+}
+
+ppc::core::external_sort_detail::BinaryFile::~BinaryFile() {
+#ifdef _WIN32
+  std::fclose(file);
+#else
+  ::close(fd);
+#endif
+}
+
+uint64_t ppc::core::external_sort_detail::BinaryFile::size() const {
+#ifdef _WIN32
+  std::lock_guard<std::mutex> lock(mutex);
+  if (_fseeki64(file, 0, SEEK_END) != 0) throw_io_error("Can't seek in", path);
+  return static_cast<uint64_t>(_ftelli64(file));
+#else
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) throw_io_error("Can't stat", path);
+  return static_cast<uint64_t>(info.st_size);
+#endif
+}
+
+void ppc::core::external_sort_detail::BinaryFile::read_at(void* data, size_t bytes, uint64_t offset) const {
+  auto* out = static_cast<char*>(data);
+#ifdef _WIN32
+  std::lock_guard<std::mutex> lock(mutex);
+  if (_fseeki64(file, static_cast<int64_t>(offset), SEEK_SET) != 0) throw_io_error("Can't seek in", path);
+  if (std::fread(out, 1, bytes, file) != bytes) throw_io_error("Can't read", path);
+#else
+  // pread may transfer less than asked for large requests
+  while (bytes > 0) {
+    auto done = ::pread(fd, out, bytes, static_cast<off_t>(offset));
+    if (done < 0 && errno == EINTR) continue;
+    if (done <= 0) {
+      if (done == 0) errno = EIO;
+      throw_io_error("Can't read", path);
+    }
+    out += done;
+    bytes -= static_cast<size_t>(done);
+    offset += static_cast<uint64_t>(done);
+  }
+#endif
+}
+
+void ppc::core::external_sort_detail::BinaryFile::write_at(const void* data, size_t bytes, uint64_t offset) {
+  const auto* in = static_cast<const char*>(data);
+#ifdef _WIN32
+  std::lock_guard<std::mutex> lock(mutex);
+  if (_fseeki64(file, static_cast<int64_t>(offset), SEEK_SET) != 0) throw_io_error("Can't seek in", path);
+  if (std::fwrite(in, 1, bytes, file) != bytes) throw_io_error("Can't write", path);
+#else
+  while (bytes > 0) {
+    auto done = ::pwrite(fd, in, bytes, static_cast<off_t>(offset));
+    if (done < 0 && errno == EINTR) continue;
+    if (done < 0) throw_io_error("Can't write", path);
+    in += done;
+    bytes -= static_cast<size_t>(done);
+    offset += static_cast<uint64_t>(done);
+  }
+#endif
+}
+
+// Invalid task is the request to stop
+ppc::core::external_sort_detail::IoWorker::IoWorker() : queue(16) {
+  thread = std::thread([this] {
+    while (true) {
+      auto request = queue.pop();
+      if (!request || !request->valid()) break;
+      (*request)();
+    }
+  });
+}
+
+ppc::core::external_sort_detail::IoWorker::~IoWorker() {
+  queue.push(std::packaged_task<void()>());
+  thread.join();
+}
+
+std::future<void> ppc::core::external_sort_detail::IoWorker::submit(std::function<void()> request) {
+  std::packaged_task<void()> task(std::move(request));
+  auto future = task.get_future();
+  queue.push(std::move(task));
+  return future;
+}
+
+ppc::core::external_sort_detail::TempFile::TempFile(const std::string& directory) {
+  static std::atomic<uint64_t> counter{0};
+  auto root = directory.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(directory);
+  auto name = "ppc_external_sort_" + std::to_string(std::random_device()()) + "_" + std::to_string(counter++) + ".runs";
+  path = (root / name).string();
+}
+
+ppc::core::external_sort_detail::TempFile::~TempFile() {
+  std::error_code error;
+  std::filesystem::remove(path, error);
+}
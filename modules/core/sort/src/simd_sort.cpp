@@ -0,0 +1,78 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sort/include/simd_sort.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "core/sort/include/sorting_network.hpp"
+#include "core/sort/src/simd_sort_isa.hpp"
+
+namespace {
+
+// Kernels of the current level, nullptr for scalar code
+const ppc::core::simd_sort_detail::KernelTable* get_kernels() {
+  switch (ppc::core::get_simd_level()) {
+    case ppc::core::SimdLevel::AVX512:
+      return ppc::core::simd_sort_detail::get_avx512_kernels();
+    case ppc::core::SimdLevel::AVX2:
+      return ppc::core::simd_sort_detail::get_avx2_kernels();
+    case ppc::core::SimdLevel::SSE4_1:
+      return ppc::core::simd_sort_detail::get_sse41_kernels();
+    default:
+      return nullptr;
+  }
+}
+
+void check_block_size(size_t size) {
+  if (size > ppc::core::SIMD_SORT_BLOCK_SIZE) {
+    throw std::invalid_argument("Block of " + std::to_string(size) + " elements is too large for simd_sort_block");
+  }
+}
+
+// Min and max of vector registers return the second operand for a NaN, so
+// the kernels would duplicate or drop elements around it; such input goes
+// to the scalar code. No early exit keeps the scan vectorized
+bool has_nan(const double* data, size_t size) {
+  bool found = false;
+  for (size_t i = 0; i < size; i++) found |= data[i] != data[i];
+  return found;
+}
+
+}  // namespace
+
+void ppc::core::simd_sort_block(int32_t* data, size_t size) {
+  check_block_size(size);
+  if (const auto* kernels = get_kernels()) {
+    kernels->sort_block_int32(data, size);
+  } else {
+    network_sort(data, size, std::less<>());
+  }
+}
+
+void ppc::core::simd_sort_block(double* data, size_t size) {
+  check_block_size(size);
+  const auto* kernels = get_kernels();
+  if (kernels != nullptr && !has_nan(data, size)) {
+    kernels->sort_block_double(data, size);
+  } else {
+    network_sort(data, size, std::less<>());
+  }
+}
+
+void ppc::core::simd_merge(const int32_t* a, size_t a_size, const int32_t* b, size_t b_size, int32_t* out) {
+  if (const auto* kernels = get_kernels()) {
+    kernels->merge_int32(a, a_size, b, b_size, out);
+  } else {
+    std::merge(a, a + a_size, b, b + b_size, out);
+  }
+}
+
+void ppc::core::simd_merge(const double* a, size_t a_size, const double* b, size_t b_size, double* out) {
+  const auto* kernels = get_kernels();
+  if (kernels != nullptr && !has_nan(a, a_size) && !has_nan(b, b_size)) {
+    kernels->merge_double(a, a_size, b, b_size, out);
+  } else {
+    std::merge(a, a + a_size, b, b + b_size, out);
+  }
+}
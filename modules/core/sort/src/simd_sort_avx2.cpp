@@ -0,0 +1,98 @@
+// Copyright 2024 Nesterov Alexander
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "core/sort/include/simd_sort.hpp"
+#include "core/sort/src/simd_sort_isa.hpp"
+
+#ifdef PPC_SIMD_SORT_X86
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "core/sort/src/simd_sort_kernels.hpp"
+
+namespace {
+
+struct Avx2Int32 {
+  using value_type = int32_t;
+  using vector = __m256i;
+  static constexpr size_t WIDTH = 8;
+
+  static vector loadu(const int32_t* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+  static void storeu(int32_t* data, vector v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), v); }
+  static vector min(vector a, vector b) { return _mm256_min_epi32(a, b); }
+  static vector max(vector a, vector b) { return _mm256_max_epi32(a, b); }
+  static vector reverse(vector v) { return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+
+  // shuffles inside 128-bit lanes are cheaper than the cross-lane ones
+  template <size_t J>
+  static vector permute_xor(vector v) {
+    if constexpr (J < 4) {
+      constexpr int IMM = ppc::core::simd_sort_detail::xor_shuffle_imm(J);
+      return _mm256_shuffle_epi32(v, IMM);
+    } else {
+      return _mm256_permute2x128_si256(v, v, 1);
+    }
+  }
+
+  template <unsigned Mask>
+  static vector blend(vector a, vector b) {
+    return _mm256_blend_epi32(a, b, Mask);
+  }
+};
+
+struct Avx2Double {
+  using value_type = double;
+  using vector = __m256d;
+  static constexpr size_t WIDTH = 4;
+
+  static vector loadu(const double* data) { return _mm256_loadu_pd(data); }
+  static void storeu(double* data, vector v) { _mm256_storeu_pd(data, v); }
+  static vector min(vector a, vector b) { return _mm256_min_pd(a, b); }
+  static vector max(vector a, vector b) { return _mm256_max_pd(a, b); }
+  static vector reverse(vector v) { return _mm256_permute4x64_pd(v, 0x1B); }
+
+  template <size_t J>
+  static vector permute_xor(vector v) {
+    if constexpr (J == 1) {
+      return _mm256_permute_pd(v, 0x5);
+    } else {
+      return _mm256_permute2f128_pd(v, v, 1);
+    }
+  }
+
+  template <unsigned Mask>
+  static vector blend(vector a, vector b) {
+    return _mm256_blend_pd(a, b, Mask);
+  }
+};
+
+using Int32Kernels = ppc::core::simd_sort_detail::Kernels<Avx2Int32>;
+using DoubleKernels = ppc::core::simd_sort_detail::Kernels<Avx2Double>;
+
+const ppc::core::simd_sort_detail::KernelTable kernels = {&Int32Kernels::sort_block, &DoubleKernels::sort_block,
+                                                           &Int32Kernels::merge, &DoubleKernels::merge};
+
+}  // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+const ppc::core::simd_sort_detail::KernelTable* ppc::core::simd_sort_detail::get_avx2_kernels() { return &kernels; }
+
+#else
+
+const ppc::core::simd_sort_detail::KernelTable* ppc::core::simd_sort_detail::get_avx2_kernels() { return nullptr; }
+
+#endif  // PPC_SIMD_SORT_X86
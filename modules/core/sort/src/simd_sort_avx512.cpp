@@ -0,0 +1,108 @@
+// Copyright 2024 Nesterov Alexander
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "core/sort/include/simd_sort.hpp"
+#include "core/sort/src/simd_sort_isa.hpp"
+
+#ifdef PPC_SIMD_SORT_X86
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+#include "core/sort/src/simd_sort_kernels.hpp"
+
+namespace {
+
+// Unmasked forms of most intrinsics take _mm512_undefined_*() in GCC, a
+// self-initialized value reported by -Wuninitialized, so operations use the
+// zeroing forms selecting all lanes
+struct Avx512Int32 {
+  using value_type = int32_t;
+  using vector = __m512i;
+  static constexpr size_t WIDTH = 16;
+
+  static vector loadu(const int32_t* data) { return _mm512_loadu_si512(data); }
+  static void storeu(int32_t* data, vector v) { _mm512_storeu_si512(data, v); }
+  static vector min(vector a, vector b) { return _mm512_maskz_min_epi32(0xFFFF, a, b); }
+  static vector max(vector a, vector b) { return _mm512_maskz_max_epi32(0xFFFF, a, b); }
+  static vector reverse(vector v) {
+    auto reversed = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm512_maskz_permutexvar_epi32(0xFFFF, reversed, v);
+  }
+
+  // shuffles of elements inside 128-bit lanes or of whole lanes
+  template <size_t J>
+  static vector permute_xor(vector v) {
+    if constexpr (J < 4) {
+      constexpr int IMM = ppc::core::simd_sort_detail::xor_shuffle_imm(J);
+      return _mm512_maskz_shuffle_epi32(0xFFFF, v, static_cast<_MM_PERM_ENUM>(IMM));
+    } else {
+      constexpr int IMM = ppc::core::simd_sort_detail::xor_shuffle_imm(J / 4);
+      return _mm512_maskz_shuffle_i32x4(0xFFFF, v, v, IMM);
+    }
+  }
+
+  template <unsigned Mask>
+  static vector blend(vector a, vector b) {
+    return _mm512_mask_blend_epi32(static_cast<__mmask16>(Mask), a, b);
+  }
+};
+
+struct Avx512Double {
+  using value_type = double;
+  using vector = __m512d;
+  static constexpr size_t WIDTH = 8;
+
+  static vector loadu(const double* data) { return _mm512_loadu_pd(data); }
+  static void storeu(double* data, vector v) { _mm512_storeu_pd(data, v); }
+  static vector min(vector a, vector b) { return _mm512_maskz_min_pd(0xFF, a, b); }
+  static vector max(vector a, vector b) { return _mm512_maskz_max_pd(0xFF, a, b); }
+  static vector reverse(vector v) {
+    return _mm512_maskz_permutexvar_pd(0xFF, _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7), v);
+  }
+
+  template <size_t J>
+  static vector permute_xor(vector v) {
+    if constexpr (J == 1) {
+      return _mm512_maskz_permute_pd(0xFF, v, 0x55);
+    } else {
+      constexpr int IMM = ppc::core::simd_sort_detail::xor_shuffle_imm(J / 2);
+      return _mm512_maskz_shuffle_f64x2(0xFF, v, v, IMM);
+    }
+  }
+
+  template <unsigned Mask>
+  static vector blend(vector a, vector b) {
+    return _mm512_mask_blend_pd(static_cast<__mmask8>(Mask), a, b);
+  }
+};
+
+using Int32Kernels = ppc::core::simd_sort_detail::Kernels<Avx512Int32>;
+using DoubleKernels = ppc::core::simd_sort_detail::Kernels<Avx512Double>;
+
+const ppc::core::simd_sort_detail::KernelTable kernels = {&Int32Kernels::sort_block, &DoubleKernels::sort_block,
+                                                           &Int32Kernels::merge, &DoubleKernels::merge};
+
+}  // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+const ppc::core::simd_sort_detail::KernelTable* ppc::core::simd_sort_detail::get_avx512_kernels() { return &kernels; }
+
+#else
+
+const ppc::core::simd_sort_detail::KernelTable* ppc::core::simd_sort_detail::get_avx512_kernels() { return nullptr; }
+
+#endif  // PPC_SIMD_SORT_X86
@@ -0,0 +1,31 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SORT_SRC_SIMD_SORT_ISA_HPP_
+#define MODULES_CORE_SORT_SRC_SIMD_SORT_ISA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PPC_SIMD_SORT_X86
+#endif
+
+namespace ppc::core::simd_sort_detail {
+
+// Entry points of the kernels of one instruction set
+struct KernelTable {
+  void (*sort_block_int32)(int32_t* data, size_t size);
+  void (*sort_block_double)(double* data, size_t size);
+  void (*merge_int32)(const int32_t* a, size_t a_size, const int32_t* b, size_t b_size, int32_t* out);
+  void (*merge_double)(const double* a, size_t a_size, const double* b, size_t b_size, double* out);
+};
+
+// Each table is defined in its own translation unit compiled for the
+// instruction set, nullptr when the target isn't x86
+const KernelTable* get_sse41_kernels();
+const KernelTable* get_avx2_kernels();
+const KernelTable* get_avx512_kernels();
+
+}  // namespace ppc::core::simd_sort_detail
+
+#endif  // MODULES_CORE_SORT_SRC_SIMD_SORT_ISA_HPP_
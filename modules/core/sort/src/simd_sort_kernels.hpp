@@ -0,0 +1,184 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SORT_SRC_SIMD_SORT_KERNELS_HPP_
+#define MODULES_CORE_SORT_SRC_SIMD_SORT_KERNELS_HPP_
+
+// Included by the kernels translation units inside the region compiled for
+// their instruction set. The standard headers below must be included by the
+// unit before the region, so that the library code isn't compiled for it
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "core/sort/include/simd_sort.hpp"
+
+namespace ppc::core::simd_sort_detail {
+
+// Immediate of 4-element shuffles where element i takes element i ^ x
+constexpr int xor_shuffle_imm(int x) {
+  int imm = 0;
+  for (int i = 0; i < 4; i++) imm |= (i ^ x) << (2 * i);
+  return imm;
+}
+
+// Bitonic sorting kernels over registers of Isa. Isa has value_type, vector
+// and WIDTH (power of two) lanes, loadu/storeu, lane-wise min/max, reverse,
+// permute_xor<J> (lane i takes lane i ^ J) and blend<Mask> (lanes of set
+// bits take the second argument). Isa must be local to the translation unit,
+// so the kernels of different instruction sets are never mixed by the linker
+template <class Isa>
+struct Kernels {
+  using T = typename Isa::value_type;
+  using V = typename Isa::vector;
+  static constexpr size_t W = Isa::WIDTH;
+  // padding sorted after all elements
+  static constexpr T SENTINEL =
+      std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+
+  // Lanes taking the larger element at step J of stage K: upper lanes of
+  // the pairs in ascending blocks of K lanes, lower ones in descending
+  static constexpr unsigned get_max_lanes(size_t k, size_t j) {
+    unsigned mask = 0;
+    for (size_t lane = 0; lane < W; lane++) {
+      if (((lane & j) != 0) != ((lane & k) != 0)) mask |= 1U << lane;
+    }
+    return mask;
+  }
+
+  template <size_t K, size_t J>
+  static V compare_exchange(V v) {
+    V other = Isa::template permute_xor<J>(v);
+    return Isa::template blend<get_max_lanes(K, J)>(Isa::min(v, other), Isa::max(v, other));
+  }
+
+  template <size_t K, size_t J>
+  static V sort_steps(V v) {
+    v = compare_exchange<K, J>(v);
+    if constexpr (J > 1) {
+      return sort_steps<K, J / 2>(v);
+    } else if constexpr (K < W) {
+      return sort_steps<K * 2, K>(v);
+    } else {
+      return v;
+    }
+  }
+
+  // Sort a bitonic register, the block of 2W lanes is ascending
+  template <size_t J>
+  static V merge_steps(V v) {
+    v = compare_exchange<2 * W, J>(v);
+    if constexpr (J > 1) {
+      return merge_steps<J / 2>(v);
+    } else {
+      return v;
+    }
+  }
+
+  // Two sorted registers become W smallest and W largest elements
+  static void merge_registers(V& lo, V& hi) {
+    V reversed = Isa::reverse(hi);
+    V min = Isa::min(lo, reversed);
+    V max = Isa::max(lo, reversed);
+    lo = merge_steps<W / 2>(min);
+    hi = merge_steps<W / 2>(max);
+  }
+
+  // Sorted input read by registers, the last one padded by sentinels
+  struct Stream {
+    Stream(const T* input, size_t size) : data(input), num_full(size / W), num_registers((size + W - 1) / W) {
+      auto rest = size % W;
+      if (rest == 0) return;
+      std::memcpy(tail, input + num_full * W, rest * sizeof(T));
+      for (auto i = rest; i < W; i++) tail[i] = SENTINEL;
+    }
+
+    [[nodiscard]] const T* get(size_t index) const { return index < num_full ? data + index * W : tail; }
+
+    const T* data;
+    size_t num_full;
+    size_t num_registers;
+    alignas(64) T tail[W]{};
+  };
+
+  // Store a register of the output, the part after its end is dropped
+  static void store(T* out, size_t size, size_t& position, V v) {
+    if (position + W <= size) {
+      Isa::storeu(out + position, v);
+    } else if (position < size) {
+      alignas(64) T buffer[W];
+      Isa::storeu(buffer, v);
+      std::memcpy(out + position, buffer, (size - position) * sizeof(T));
+    }
+    position += W;
+  }
+
+  // Merge keeping W largest elements seen in a register: the next register
+  // is taken from the input with smaller head and merged with it, W
+  // smallest elements go to the output
+  static void merge(const T* a, size_t a_size, const T* b, size_t b_size, T* out) {
+    if (a_size == 0 || b_size == 0) {
+      if (a_size != 0) std::memcpy(out, a, a_size * sizeof(T));
+      if (b_size != 0) std::memcpy(out, b, b_size * sizeof(T));
+      return;
+    }
+    Stream first(a, a_size);
+    Stream second(b, b_size);
+    auto size = a_size + b_size;
+    size_t position = 0;
+    V lo = Isa::loadu(first.get(0));
+    V hi = Isa::loadu(second.get(0));
+    merge_registers(lo, hi);
+    store(out, size, position, lo);
+    size_t i = 1;
+    size_t j = 1;
+    while (i < first.num_registers || j < second.num_registers) {
+      if (j == second.num_registers || (i < first.num_registers && *first.get(i) <= *second.get(j))) {
+        lo = Isa::loadu(first.get(i++));
+      } else {
+        lo = Isa::loadu(second.get(j++));
+      }
+      merge_registers(lo, hi);
+      store(out, size, position, lo);
+    }
+    store(out, size, position, hi);
+  }
+
+  // Registers are sorted one by one, then sorted runs are merged pairwise
+  static void sort_block(T* data, size_t size) {
+    if (size < 2) return;
+    size_t padded = W;
+    while (padded < size) padded *= 2;
+    alignas(64) T first[SIMD_SORT_BLOCK_SIZE > W ? SIMD_SORT_BLOCK_SIZE : W];
+    alignas(64) T second[SIMD_SORT_BLOCK_SIZE > W ? SIMD_SORT_BLOCK_SIZE : W];
+    std::memcpy(first, data, size * sizeof(T));
+    for (auto i = size; i < padded; i++) first[i] = SENTINEL;
+    for (size_t i = 0; i < padded; i += W) {
+      Isa::storeu(first + i, sort_steps<2, 1>(Isa::loadu(first + i)));
+    }
+    T* from = first;
+    T* to = second;
+    for (auto run = W; run < padded; run *= 2) {
+      for (size_t i = 0; i < padded; i += 2 * run) {
+        if (run == W) {
+          V lo = Isa::loadu(from + i);
+          V hi = Isa::loadu(from + i + W);
+          merge_registers(lo, hi);
+          Isa::storeu(to + i, lo);
+          Isa::storeu(to + i + W, hi);
+        } else {
+          merge(from + i, run, from + i + run, run, to + i);
+        }
+      }
+      T* swap = from;
+      from = to;
+      to = swap;
+    }
+    std::memcpy(data, from, size * sizeof(T));
+  }
+};
+
+}  // namespace ppc::core::simd_sort_detail
+
+#endif  // MODULES_CORE_SORT_SRC_SIMD_SORT_KERNELS_HPP_
@@ -0,0 +1,91 @@
+// Copyright 2024 Nesterov Alexander
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "core/sort/include/simd_sort.hpp"
+#include "core/sort/src/simd_sort_isa.hpp"
+
+#ifdef PPC_SIMD_SORT_X86
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse4.1"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+#endif
+
+#include "core/sort/src/simd_sort_kernels.hpp"
+
+namespace {
+
+struct Sse41Int32 {
+  using value_type = int32_t;
+  using vector = __m128i;
+  static constexpr size_t WIDTH = 4;
+
+  static vector loadu(const int32_t* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+  static void storeu(int32_t* data, vector v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(data), v); }
+  static vector min(vector a, vector b) { return _mm_min_epi32(a, b); }
+  static vector max(vector a, vector b) { return _mm_max_epi32(a, b); }
+  static vector reverse(vector v) { return _mm_shuffle_epi32(v, 0x1B); }
+
+  template <size_t J>
+  static vector permute_xor(vector v) {
+    constexpr int IMM = ppc::core::simd_sort_detail::xor_shuffle_imm(J);
+    return _mm_shuffle_epi32(v, IMM);
+  }
+
+  // 16-bit blend, every lane is two words
+  template <unsigned Mask>
+  static vector blend(vector a, vector b) {
+    constexpr int WORDS = ((Mask & 1U) * 0x3) | ((Mask & 2U) * 0x6) | ((Mask & 4U) * 0xC) | ((Mask & 8U) * 0x18);
+    return _mm_blend_epi16(a, b, WORDS);
+  }
+};
+
+struct Sse41Double {
+  using value_type = double;
+  using vector = __m128d;
+  static constexpr size_t WIDTH = 2;
+
+  static vector loadu(const double* data) { return _mm_loadu_pd(data); }
+  static void storeu(double* data, vector v) { _mm_storeu_pd(data, v); }
+  static vector min(vector a, vector b) { return _mm_min_pd(a, b); }
+  static vector max(vector a, vector b) { return _mm_max_pd(a, b); }
+  static vector reverse(vector v) { return _mm_shuffle_pd(v, v, 1); }
+
+  template <size_t J>
+  static vector permute_xor(vector v) {
+    return reverse(v);
+  }
+
+  template <unsigned Mask>
+  static vector blend(vector a, vector b) {
+    return _mm_blend_pd(a, b, Mask);
+  }
+};
+
+using Int32Kernels = ppc::core::simd_sort_detail::Kernels<Sse41Int32>;
+using DoubleKernels = ppc::core::simd_sort_detail::Kernels<Sse41Double>;
+
+const ppc::core::simd_sort_detail::KernelTable kernels = {&Int32Kernels::sort_block, &DoubleKernels::sort_block,
+                                                           &Int32Kernels::merge, &DoubleKernels::merge};
+
+}  // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+const ppc::core::simd_sort_detail::KernelTable* ppc::core::simd_sort_detail::get_sse41_kernels() { return &kernels; }
+
+#else
+
+const ppc::core::simd_sort_detail::KernelTable* ppc::core::simd_sort_detail::get_sse41_kernels() { return nullptr; }
+
+#endif  // PPC_SIMD_SORT_X86
@@ -0,0 +1,169 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
+#include "core/sparse/include/sparse_io.hpp"
+#include "core/sparse/include/spgemm.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace {
+
+std::string get_temp_path(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / ("ppc_sparse_io_tests_" + name)).string();
+}
+
+std::string write_text(const std::string& name, const std::string& text) {
+  auto path = get_temp_path(name);
+  std::ofstream(path, std::ios::binary) << text;
+  return path;
+}
+
+ppc::core::CrsMatrix<double> make_random_matrix(int rows, int cols, size_t nnz, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> row(0, rows - 1);
+  std::uniform_int_distribution<int> col(0, cols - 1);
+  std::uniform_real_distribution<double> value(-1e3, 1e3);
+  std::vector<ppc::core::SparseEntry<double>> entries(nnz);
+  for (auto& entry : entries) entry = {row(gen), col(gen), value(gen)};
+  return ppc::core::from_entries<ppc::core::CrsMatrix<double>>(rows, cols, entries);
+}
+
+// Threads are set to more than one to split files into several chunks on any machine
+class sparse_io_tests : public ::testing::Test {
+ protected:
+  void SetUp() override { ppc::core::set_num_threads(4); }
+  void TearDown() override { ppc::core::set_num_threads(0); }
+};
+
+}  // namespace
+
+TEST_F(sparse_io_tests, check_header) {
+  auto header = ppc::core::parse_matrix_market_header(
+      "%%MatrixMarket matrix coordinate Complex Hermitian\n% comment\n\n  3 3 4\n1 1 1 0\n");
+  EXPECT_EQ(header.field, ppc::core::MatrixMarketHeader::COMPLEX);
+  EXPECT_EQ(header.symmetry, ppc::core::MatrixMarketHeader::HERMITIAN);
+  EXPECT_EQ(header.rows, 3);
+  EXPECT_EQ(header.nnz, 4);
+  EXPECT_EQ(header.body_offset, 70U);
+
+  EXPECT_THROW(ppc::core::parse_matrix_market_header("3 3 4\n"), std::runtime_error);
+  EXPECT_THROW(ppc::core::parse_matrix_market_header("%%MatrixMarket matrix array real general\n3 3\n"),
+               std::runtime_error);
+  EXPECT_THROW(ppc::core::parse_matrix_market_header("%%MatrixMarket matrix coordinate real symmetric\n3 4 1\n"),
+               std::runtime_error);
+  EXPECT_THROW(ppc::core::parse_matrix_market_header("%%MatrixMarket matrix coordinate real general\n3 3\n"),
+               std::runtime_error);
+}
+
+TEST_F(sparse_io_tests, check_symmetry_and_pattern) {
+  auto symmetric = write_text("symmetric.mtx",
+                              "%%MatrixMarket matrix coordinate real symmetric\n"
+                              "3 3 3\n1 1 2.5\n3 1 -1e2\n% comment between entries\n\n3 2 +4\n");
+  auto matrix = ppc::core::read_matrix_market<ppc::core::CrsMatrix<double>>(symmetric);
+  EXPECT_EQ(ppc::core::to_dense(matrix), (std::vector<double>{2.5, 0, -100, 0, 0, 4, -100, 4, 0}));
+
+  auto skew = write_text("skew.mtx", "%%MatrixMarket matrix coordinate integer skew-symmetric\n2 2 1\n2 1 3\n");
+  auto skew_matrix = ppc::core::read_matrix_market<ppc::core::CcsMatrix<int64_t>>(skew);
+  EXPECT_EQ(ppc::core::to_dense(skew_matrix), (std::vector<int64_t>{0, -3, 3, 0}));
+
+  auto hermitian = write_text("hermitian.mtx", "%%MatrixMarket matrix coordinate complex hermitian\n2 2 2\n"
+                                               "1 1 1 0\n2 1 2 3\n");
+  auto hermitian_matrix = ppc::core::read_matrix_market<ppc::core::CrsMatrix<std::complex<double>>>(hermitian);
+  EXPECT_EQ(ppc::core::to_dense(hermitian_matrix),
+            (std::vector<std::complex<double>>{{1, 0}, {2, -3}, {2, 3}, {0, 0}}));
+  EXPECT_THROW(ppc::core::read_matrix_market<ppc::core::CrsMatrix<double>>(hermitian), std::runtime_error);
+
+  auto pattern = write_text("pattern.mtx", "%%MatrixMarket matrix coordinate pattern general\n2 3 2\n1 3\n2 1\n");
+  auto pattern_matrix = ppc::core::read_matrix_market<ppc::core::CrsMatrix<float>>(pattern);
+  EXPECT_EQ(ppc::core::to_dense(pattern_matrix), (std::vector<float>{0, 0, 1, 1, 0, 0}));
+}
+
+TEST_F(sparse_io_tests, check_malformed_files) {
+  auto header = std::string("%%MatrixMarket matrix coordinate real general\n2 2 2\n");
+  auto few = write_text("few.mtx", header + "1 1 1\n");
+  EXPECT_THROW(ppc::core::read_matrix_market<ppc::core::CrsMatrix<double>>(few), std::runtime_error);
+  auto out_of_range = write_text("out_of_range.mtx", header + "1 1 1\n3 1 1\n");
+  EXPECT_THROW(ppc::core::read_matrix_market<ppc::core::CrsMatrix<double>>(out_of_range), std::runtime_error);
+  auto bad_number = write_text("bad_number.mtx", header + "1 1 1\n2 1 x\n");
+  EXPECT_THROW(ppc::core::read_matrix_market<ppc::core::CrsMatrix<double>>(bad_number), std::runtime_error);
+  auto trailing = write_text("trailing.mtx", header + "1 1 1\n2 1 1 1\n");
+  EXPECT_THROW(ppc::core::read_matrix_market<ppc::core::CrsMatrix<double>>(trailing), std::runtime_error);
+  auto wide = write_text("wide.mtx", "%%MatrixMarket matrix coordinate real general\n40000 2 0\n");
+  EXPECT_THROW((ppc::core::read_matrix_market<ppc::core::CrsMatrix<double, int16_t>>(wide)), std::overflow_error);
+  EXPECT_THROW(ppc::core::read_matrix_market<ppc::core::CrsMatrix<double>>(get_temp_path("missing.mtx")),
+               std::runtime_error);
+}
+
+TEST_F(sparse_io_tests, check_matrix_market_round_trip) {
+  // a few MB of text, so the body is parsed in several chunks
+  auto matrix = make_random_matrix(5000, 7000, 200000, 1);
+  auto path = get_temp_path("round_trip.mtx");
+  ppc::core::write_matrix_market(path, matrix.get_view());
+  EXPECT_GT(std::filesystem::file_size(path), 4U << 20);
+  EXPECT_EQ(ppc::core::read_matrix_market<ppc::core::CrsMatrix<double>>(path, ppc::core::SeqSortBackend()), matrix);
+  EXPECT_EQ(ppc::core::read_matrix_market<ppc::core::CrsMatrix<double>>(path, ppc::core::OmpSortBackend()), matrix);
+  auto wide_ccs = ppc::core::read_matrix_market<ppc::core::CcsMatrix<double, int64_t>>(path);
+  auto ccs = ppc::core::to_ccs(matrix);
+  EXPECT_TRUE(std::equal(wide_ccs.ptr.begin(), wide_ccs.ptr.end(), ccs.ptr.begin(), ccs.ptr.end()));
+  EXPECT_TRUE(std::equal(wide_ccs.index.begin(), wide_ccs.index.end(), ccs.index.begin(), ccs.index.end()));
+  EXPECT_EQ(wide_ccs.values, ccs.values);
+
+  ppc::core::CcsMatrix<std::complex<double>> complex(2, 2);
+  complex.ptr = {0, 1, 2};
+  complex.index = {1, 0};
+  complex.values = {{0.1, -2.5e-300}, {3, 4}};
+  auto complex_path = get_temp_path("complex.mtx");
+  ppc::core::write_matrix_market(complex_path, complex.get_view());
+  EXPECT_EQ(ppc::core::read_matrix_market<ppc::core::CcsMatrix<std::complex<double>>>(complex_path), complex);
+}
+
+TEST_F(sparse_io_tests, check_mapped_binary) {
+  auto matrix = make_random_matrix(300, 200, 3000, 2);
+  auto path = get_temp_path("matrix.bin");
+  ppc::core::write_sparse_binary(path, matrix.get_view());
+  {
+    ppc::core::MappedSparseMatrix<double> mapped(path);
+    const auto& view = mapped.get_view();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view.values.data()) % 64, 0U);
+    EXPECT_NO_THROW(ppc::core::validate(view));
+    EXPECT_EQ(ppc::core::to_matrix(view), matrix);
+    auto transposed = ppc::core::transpose(matrix);
+    EXPECT_EQ(ppc::core::spgemm(view, transposed.get_view()), ppc::core::spgemm(matrix, transposed));
+  }
+
+  EXPECT_THROW(ppc::core::MappedSparseMatrix<float> wrong_value(path), std::runtime_error);
+  using WideIndex = ppc::core::MappedSparseMatrix<double, int64_t>;
+  EXPECT_THROW(WideIndex wrong_index(path), std::runtime_error);
+  using OtherLayout = ppc::core::MappedSparseMatrix<double, int32_t, ppc::core::SparseLayout::CCS>;
+  EXPECT_THROW(OtherLayout wrong_layout(path), std::runtime_error);
+  {
+    // offset of line 1 far beyond the entries, the file is untrusted input
+    ppc::core::sparse_io_detail::BinaryHeader header{};
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    int32_t wild_offset = 1 << 30;
+    file.seekp(static_cast<std::streamoff>(header.ptr_offset + sizeof(int32_t)));
+    file.write(reinterpret_cast<const char*>(&wild_offset), sizeof(wild_offset));
+  }
+  EXPECT_THROW(ppc::core::MappedSparseMatrix<double> corrupted(path), std::runtime_error);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+  EXPECT_THROW(ppc::core::MappedSparseMatrix<double> truncated(path), std::runtime_error);
+  auto text = write_text("not_binary.bin", "%%MatrixMarket matrix coordinate real general\n1 1 0\n");
+  EXPECT_THROW(ppc::core::MappedSparseMatrix<double> not_binary(text), std::runtime_error);
+
+  ppc::core::CcsMatrix<std::complex<float>, int64_t> empty(0, 5);
+  ppc::core::write_sparse_binary(path, empty.get_view());
+  ppc::core::MappedSparseMatrix<std::complex<float>, int64_t, ppc::core::SparseLayout::CCS> mapped_empty(path);
+  EXPECT_EQ(ppc::core::to_matrix(mapped_empty.get_view()), empty);
+}
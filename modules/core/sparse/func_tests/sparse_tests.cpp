@@ -0,0 +1,244 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
+#include "core/sparse/include/spgemm.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace {
+
+// Row-major dense matrix with about density * rows * cols nonzeros
+template <class T>
+std::vector<T> make_random_dense(int rows, int cols, double density, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::bernoulli_distribution nonzero(density);
+  std::vector<T> dense(static_cast<size_t>(rows) * cols);
+  for (auto& value : dense) {
+    if (!nonzero(gen)) continue;
+    if constexpr (std::is_same_v<T, std::complex<double>>) {
+      value = {dist(gen), dist(gen)};
+    } else {
+      value = static_cast<T>(dist(gen));
+    }
+  }
+  return dense;
+}
+
+template <class T>
+std::vector<T> multiply_dense(const std::vector<T>& a, const std::vector<T>& b, int rows, int inner, int cols) {
+  std::vector<T> c(static_cast<size_t>(rows) * cols);
+  for (int i = 0; i < rows; i++) {
+    for (int k = 0; k < inner; k++) {
+      for (int j = 0; j < cols; j++) c[i * cols + j] += a[i * inner + k] * b[k * cols + j];
+    }
+  }
+  return c;
+}
+
+template <class T>
+void expect_near(const std::vector<T>& actual, const std::vector<T>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); i++) EXPECT_NEAR(std::abs(actual[i] - expected[i]), 0.0, 1e-12) << i;
+}
+
+// Threads are set to more than one to split rows into several chunks on any machine
+class sparse_tests : public ::testing::Test {
+ protected:
+  void SetUp() override { ppc::core::set_num_threads(4); }
+  void TearDown() override { ppc::core::set_num_threads(0); }
+};
+
+}  // namespace
+
+TEST_F(sparse_tests, check_from_entries) {
+  std::vector<ppc::core::SparseEntry<double>> entries = {{2, 1, 1.0}, {0, 2, 2.0}, {0, 0, 3.0}, {2, 1, 4.0}};
+  auto crs = ppc::core::from_entries<ppc::core::CrsMatrix<double>>(3, 3, entries);
+  EXPECT_EQ(crs.ptr, (std::vector<int32_t>{0, 2, 2, 3}));
+  EXPECT_EQ(crs.index, (std::vector<int32_t>{0, 2, 1}));
+  EXPECT_EQ(crs.values, (std::vector<double>{3.0, 2.0, 5.0}));
+  EXPECT_NO_THROW(ppc::core::validate(crs));
+
+  auto ccs = ppc::core::from_entries<ppc::core::CcsMatrix<double>>(3, 3, entries);
+  EXPECT_EQ(ccs.ptr, (std::vector<int32_t>{0, 1, 2, 3}));
+  EXPECT_EQ(ccs.index, (std::vector<int32_t>{0, 2, 0}));
+  EXPECT_EQ(ppc::core::to_dense(ccs), ppc::core::to_dense(crs));
+
+  entries.push_back({3, 0, 1.0});
+  EXPECT_THROW(ppc::core::from_entries<ppc::core::CrsMatrix<double>>(3, 3, entries), std::invalid_argument);
+}
+
+TEST_F(sparse_tests, check_validate) {
+  auto matrix = ppc::core::from_entries<ppc::core::CrsMatrix<double>>(
+      2, 3, std::vector<ppc::core::SparseEntry<double>>{{0, 0, 1.0}, {0, 2, 1.0}, {1, 1, 1.0}});
+  auto unsorted = matrix;
+  std::swap(unsorted.index[0], unsorted.index[1]);
+  EXPECT_THROW(ppc::core::validate(unsorted), std::invalid_argument);
+  EXPECT_NO_THROW(ppc::core::validate(unsorted, false));
+  auto repeated = unsorted;
+  repeated.index[1] = 2;
+  EXPECT_THROW(ppc::core::validate(repeated, false), std::invalid_argument);
+  auto out_of_range = matrix;
+  out_of_range.index[2] = 3;
+  EXPECT_THROW(ppc::core::validate(out_of_range), std::invalid_argument);
+  auto short_ptr = matrix;
+  short_ptr.ptr.pop_back();
+  EXPECT_THROW(ppc::core::validate(short_ptr), std::invalid_argument);
+  // line 0 would be walked to entry 99 of 3 before the decrease is found
+  auto wild_ptr = matrix;
+  wild_ptr.ptr = {0, 100, 3};
+  EXPECT_THROW(ppc::core::validate(wild_ptr), std::invalid_argument);
+}
+
+TEST_F(sparse_tests, check_prefix_view) {
+  // arrays of a task with spare capacity behind the 2 x 3 matrix
+  std::vector<int32_t> ptr = {0, 2, 3, 7};
+  std::vector<int32_t> index = {2, 0, 1, 5, 5};
+  std::vector<double> values = {1.0, 2.0, 3.0, 4.0};
+  auto view = ppc::core::make_prefix_view<ppc::core::SparseLayout::CRS, double>(2, 3, ptr, index, values);
+  EXPECT_EQ(view.ptr.size(), 3U);
+  EXPECT_EQ(view.get_nnz(), 3U);
+  EXPECT_EQ(view.index.size(), 3U);
+  EXPECT_TRUE(ppc::core::is_valid(view, false));
+  EXPECT_FALSE(ppc::core::is_valid(view));
+
+  auto short_ptr = ppc::core::make_prefix_view<ppc::core::SparseLayout::CCS, double>(2, 3, ptr, index, values);
+  EXPECT_FALSE(ppc::core::is_valid(short_ptr));
+  ptr[2] = 5;
+  auto short_values = ppc::core::make_prefix_view<ppc::core::SparseLayout::CRS, double>(2, 3, ptr, index, values);
+  EXPECT_FALSE(ppc::core::is_valid(short_values, false));
+  auto negative = ppc::core::make_prefix_view<ppc::core::SparseLayout::CRS, double>(-1, 3, ptr, index, values);
+  EXPECT_FALSE(ppc::core::is_valid(negative));
+}
+
+TEST_F(sparse_tests, check_cost_prefix) {
+  auto line_cost = [](size_t i) { return i % 7 == 3 ? 100 : i % 3; };
+  for (size_t num_lines : {0, 1, 5, 1000}) {
+    std::vector<size_t> expected(num_lines + 1, 0);
+    for (size_t i = 0; i < num_lines; i++) expected[i + 1] = expected[i] + line_cost(i);
+    EXPECT_EQ(ppc::core::make_cost_prefix(num_lines, line_cost, ppc::core::SeqSortBackend()), expected);
+    EXPECT_EQ(ppc::core::make_cost_prefix(num_lines, line_cost, ppc::core::OmpSortBackend()), expected);
+    EXPECT_EQ(ppc::core::make_cost_prefix(num_lines, line_cost, ppc::core::StlSortBackend()), expected);
+  }
+}
+
+TEST_F(sparse_tests, check_layouts_and_transpose) {
+  const int rows = 37;
+  const int cols = 53;
+  auto dense = make_random_dense<double>(rows, cols, 0.2, 1);
+  auto crs = ppc::core::from_dense<ppc::core::CrsMatrix<double>>(dense.data(), rows, cols);
+  auto ccs = ppc::core::from_dense<ppc::core::CcsMatrix<double>>(dense.data(), rows, cols);
+  EXPECT_NO_THROW(ppc::core::validate(crs));
+  EXPECT_NO_THROW(ppc::core::validate(ccs));
+  EXPECT_EQ(ppc::core::to_dense(crs), dense);
+  EXPECT_EQ(ppc::core::to_ccs(crs), ccs);
+  EXPECT_EQ(ppc::core::to_crs(ccs), crs);
+
+  auto transposed = ppc::core::to_dense(ppc::core::transpose(crs));
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) EXPECT_EQ(transposed[j * rows + i], dense[i * cols + j]);
+  }
+  EXPECT_EQ(ppc::core::transpose(ppc::core::transpose(ccs)), ccs);
+}
+
+TEST_F(sparse_tests, check_spgemm_accumulators_and_backends) {
+  const int rows = 61;
+  const int inner = 47;
+  const int cols = 83;
+  auto a = make_random_dense<double>(rows, inner, 0.1, 2);
+  auto b = make_random_dense<double>(inner, cols, 0.1, 3);
+  auto expected = multiply_dense(a, b, rows, inner, cols);
+  auto lhs = ppc::core::from_dense<ppc::core::CrsMatrix<double>>(a.data(), rows, inner);
+  auto rhs = ppc::core::from_dense<ppc::core::CrsMatrix<double>>(b.data(), inner, cols);
+
+  auto check = [&](const auto& backend, ppc::core::SpgemmAttr::Accumulator accumulator) {
+    ppc::core::SpgemmAttr attr;
+    attr.accumulator = accumulator;
+    auto c = ppc::core::spgemm(lhs, rhs, backend, attr);
+    EXPECT_NO_THROW(ppc::core::validate(c));
+    expect_near(ppc::core::to_dense(c), expected);
+
+    attr.sorted = false;
+    auto unsorted = ppc::core::spgemm(lhs, rhs, backend, attr);
+    EXPECT_NO_THROW(ppc::core::validate(unsorted, false));
+    EXPECT_EQ(unsorted.ptr, c.ptr);
+    expect_near(ppc::core::to_dense(unsorted), expected);
+  };
+  for (auto accumulator : {ppc::core::SpgemmAttr::AUTO, ppc::core::SpgemmAttr::DENSE, ppc::core::SpgemmAttr::HASH}) {
+    SCOPED_TRACE(accumulator);
+    check(ppc::core::SeqSortBackend(), accumulator);
+    check(ppc::core::OmpSortBackend(), accumulator);
+    check(ppc::core::StlSortBackend(), accumulator);
+  }
+}
+
+TEST_F(sparse_tests, check_spgemm_skewed_rows) {
+  // two dense rows hold most of the work, so chunks around them are empty
+  const int rows = 200;
+  const int inner = 90;
+  const int cols = 70;
+  auto a = make_random_dense<double>(rows, inner, 0.01, 4);
+  for (int k = 0; k < inner; k++) a[37 * inner + k] = a[38 * inner + k] = 1.0 + k;
+  auto b = make_random_dense<double>(inner, cols, 0.2, 5);
+  auto expected = multiply_dense(a, b, rows, inner, cols);
+  auto lhs = ppc::core::from_dense<ppc::core::CrsMatrix<double>>(a.data(), rows, inner);
+  auto rhs = ppc::core::from_dense<ppc::core::CrsMatrix<double>>(b.data(), inner, cols);
+  auto c = ppc::core::spgemm(lhs, rhs, ppc::core::OmpSortBackend());
+  EXPECT_NO_THROW(ppc::core::validate(c));
+  expect_near(ppc::core::to_dense(c), expected);
+  EXPECT_EQ(ppc::core::spgemm(lhs, rhs, ppc::core::SeqSortBackend()), c);
+}
+
+TEST_F(sparse_tests, check_spgemm_keeps_cancelled_entries) {
+  std::vector<ppc::core::SparseEntry<double>> a_entries = {{0, 0, 1.0}, {0, 1, 1.0}};
+  std::vector<ppc::core::SparseEntry<double>> b_entries = {{0, 0, 1.0}, {1, 0, -1.0}, {1, 1, 2.0}};
+  auto a = ppc::core::from_entries<ppc::core::CrsMatrix<double>>(1, 2, a_entries);
+  auto b = ppc::core::from_entries<ppc::core::CrsMatrix<double>>(2, 2, b_entries);
+  auto c = ppc::core::spgemm(a, b);
+  EXPECT_EQ(c.index, (std::vector<int32_t>{0, 1}));
+  EXPECT_EQ(c.values, (std::vector<double>{0.0, 2.0}));
+}
+
+TEST_F(sparse_tests, check_spgemm_complex_ccs) {
+  const int rows = 29;
+  const int inner = 31;
+  const int cols = 23;
+  auto a = make_random_dense<std::complex<double>>(rows, inner, 0.15, 4);
+  auto b = make_random_dense<std::complex<double>>(inner, cols, 0.15, 5);
+  auto lhs = ppc::core::from_dense<ppc::core::CcsMatrix<std::complex<double>, int64_t>>(a.data(), rows, inner);
+  auto rhs = ppc::core::from_dense<ppc::core::CcsMatrix<std::complex<double>, int64_t>>(b.data(), inner, cols);
+  auto c = ppc::core::spgemm(lhs, rhs, ppc::core::OmpSortBackend());
+  EXPECT_EQ(c.rows, rows);
+  EXPECT_EQ(c.cols, cols);
+  EXPECT_NO_THROW(ppc::core::validate(c));
+  expect_near(ppc::core::to_dense(c), multiply_dense(a, b, rows, inner, cols));
+  EXPECT_EQ(ppc::core::to_crs(c), ppc::core::spgemm(ppc::core::to_crs(lhs), ppc::core::to_crs(rhs)));
+}
+
+TEST_F(sparse_tests, check_spgemm_invalid_input) {
+  ppc::core::CrsMatrix<double> a(3, 4);
+  ppc::core::CrsMatrix<double> b(3, 4);
+  EXPECT_THROW(ppc::core::spgemm(a, b), std::invalid_argument);
+
+  // outer product of 200 ones has 40000 nonzeros
+  std::vector<ppc::core::SparseEntry<double, int16_t>> column;
+  std::vector<ppc::core::SparseEntry<double, int16_t>> row;
+  for (int16_t i = 0; i < 200; i++) {
+    column.push_back({i, 0, 1.0});
+    row.push_back({0, i, 1.0});
+  }
+  auto lhs = ppc::core::from_entries<ppc::core::CrsMatrix<double, int16_t>>(200, 1, column);
+  auto rhs = ppc::core::from_entries<ppc::core::CrsMatrix<double, int16_t>>(1, 200, row);
+  EXPECT_THROW(ppc::core::spgemm(lhs, rhs), std::overflow_error);
+
+  auto empty = ppc::core::spgemm(ppc::core::CrsMatrix<double>(0, 3), ppc::core::CrsMatrix<double>(3, 5));
+  EXPECT_EQ(empty.ptr, (std::vector<int32_t>{0}));
+  EXPECT_EQ(empty.get_nnz(), 0U);
+}
@@ -0,0 +1,120 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
+#include "core/sparse/include/spgemm.hpp"
+#include "core/sparse/include/split_complex.hpp"
+#include "core/threads/include/simd.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace {
+
+// Band of the given half width with holes. Rows of the product of narrow
+// bands are accumulated by a scan of their span, of sparse wide bands they
+// are stamped
+template <ppc::core::SparseLayout Layout = ppc::core::SparseLayout::CRS>
+ppc::core::SparseMatrix<std::complex<double>, int32_t, Layout> make_banded_matrix(int size, int width, double density,
+                                                                                  uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::bernoulli_distribution nonzero(density);
+  std::vector<ppc::core::SparseEntry<std::complex<double>>> entries;
+  for (int i = 0; i < size; i++) {
+    for (int j = std::max(0, i - width); j <= std::min(size - 1, i + width); j++) {
+      if (nonzero(gen)) entries.push_back({i, j, {value(gen), value(gen)}});
+    }
+  }
+  return ppc::core::from_entries<ppc::core::SparseMatrix<std::complex<double>, int32_t, Layout>>(size, size, entries);
+}
+
+// Threads are set to more than one to split rows into several chunks on any machine
+class split_complex_tests : public ::testing::Test {
+ protected:
+  void SetUp() override { ppc::core::set_num_threads(4); }
+  void TearDown() override {
+    ppc::core::set_num_threads(0);
+    ppc::core::set_simd_level(ppc::core::get_cpu_simd_level());
+  }
+};
+
+}  // namespace
+
+TEST_F(split_complex_tests, check_conversions) {
+  auto a = make_banded_matrix(50, 3, 0.5, 1);
+  auto split = ppc::core::to_split_complex(a);
+  EXPECT_EQ(split.ptr, a.ptr);
+  EXPECT_EQ(split.index, a.index);
+  ASSERT_EQ(split.get_nnz(), a.get_nnz());
+  for (size_t k = 0; k < a.get_nnz(); k++) {
+    EXPECT_EQ(split.real[k], a.values[k].real());
+    EXPECT_EQ(split.imag[k], a.values[k].imag());
+  }
+  EXPECT_EQ(ppc::core::to_interleaved(split), a);
+  EXPECT_NO_THROW(ppc::core::validate(split));
+
+  split.imag.pop_back();
+  EXPECT_THROW(ppc::core::validate(split), std::invalid_argument);
+  split = ppc::core::to_split_complex(a);
+  std::swap(split.index[0], split.index[1]);
+  EXPECT_THROW(ppc::core::validate(split), std::invalid_argument);
+  EXPECT_NO_THROW(ppc::core::validate(split, false));
+}
+
+TEST_F(split_complex_tests, check_spgemm_simd_levels) {
+  for (auto [width, density] : {std::pair{4, 0.4}, std::pair{300, 0.01}}) {
+    auto a = make_banded_matrix(700, width, density, 2);
+    auto b = make_banded_matrix(700, width, density, 3);
+    auto expected = ppc::core::spgemm(a, b);
+    auto lhs = ppc::core::to_split_complex(a);
+    auto rhs = ppc::core::to_split_complex(b);
+    for (auto level : {ppc::core::SimdLevel::SCALAR, ppc::core::SimdLevel::AVX512}) {
+      SCOPED_TRACE(ppc::core::get_simd_level_name(level) + " width=" + std::to_string(width));
+      ppc::core::set_simd_level(level);
+      auto c = ppc::core::spgemm(lhs, rhs, ppc::core::OmpSortBackend());
+      EXPECT_NO_THROW(ppc::core::validate(c));
+      // parts are multiplied in the same order as std::complex values
+      EXPECT_EQ(ppc::core::to_interleaved(c), expected);
+      EXPECT_EQ(ppc::core::spgemm(lhs, rhs, ppc::core::SeqSortBackend()), c);
+
+      auto unsorted = ppc::core::spgemm(lhs, rhs, ppc::core::StlSortBackend(), {.sorted = false});
+      EXPECT_NO_THROW(ppc::core::validate(unsorted, false));
+      EXPECT_EQ(ppc::core::to_crs(ppc::core::to_ccs(ppc::core::to_interleaved(unsorted))), expected);
+    }
+  }
+}
+
+TEST_F(split_complex_tests, check_spgemm_ccs) {
+  auto a = make_banded_matrix<ppc::core::SparseLayout::CCS>(300, 20, 0.3, 4);
+  auto b = make_banded_matrix<ppc::core::SparseLayout::CCS>(300, 20, 0.3, 5);
+  auto c = ppc::core::spgemm(ppc::core::to_split_complex(a), ppc::core::to_split_complex(b));
+  EXPECT_EQ(c.rows, 300);
+  EXPECT_EQ(c.cols, 300);
+  EXPECT_EQ(ppc::core::to_interleaved(c), ppc::core::spgemm(a, b));
+  EXPECT_THROW(ppc::core::spgemm(ppc::core::SplitCrsMatrix<double>(3, 4), ppc::core::SplitCrsMatrix<double>(3, 4)),
+               std::invalid_argument);
+}
+
+TEST_F(split_complex_tests, check_spgemm_keeps_cancelled_entries) {
+  // i * i + 1 * 1 at column 0 cancels, the span of the row is found by a scan
+  std::vector<ppc::core::SparseEntry<std::complex<double>>> a_entries = {{0, 0, {0.0, 1.0}}, {0, 1, {1.0, 0.0}}};
+  std::vector<ppc::core::SparseEntry<std::complex<double>>> b_entries = {
+      {0, 0, {0.0, 1.0}}, {1, 0, {1.0, 0.0}}, {1, 1, {2.0, 0.0}}};
+  auto a = ppc::core::from_entries<ppc::core::CrsMatrix<std::complex<double>>>(1, 2, a_entries);
+  auto b = ppc::core::from_entries<ppc::core::CrsMatrix<std::complex<double>>>(2, 2, b_entries);
+  for (auto level : {ppc::core::SimdLevel::SCALAR, ppc::core::SimdLevel::AVX512}) {
+    ppc::core::set_simd_level(level);
+    auto c = ppc::core::spgemm(ppc::core::to_split_complex(a), ppc::core::to_split_complex(b));
+    EXPECT_EQ(c.index, (std::vector<int32_t>{0, 1}));
+    EXPECT_EQ(c.real, (std::vector<double>{0.0, 2.0}));
+    EXPECT_EQ(c.imag, (std::vector<double>{0.0, 0.0}));
+  }
+}
@@ -0,0 +1,201 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
+#include "core/sparse/include/spmv.hpp"
+#include "core/threads/include/simd.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace {
+
+// Row lengths follow a power law, so a few rows hold most of the entries,
+// and every 7th row is empty
+template <class T, class Index = int32_t>
+ppc::core::CrsMatrix<T, Index> make_power_law_matrix(int rows, int cols, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> col(0, cols - 1);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::vector<ppc::core::SparseEntry<T, Index>> entries;
+  for (int i = 0; i < rows; i++) {
+    if (i % 7 == 3) continue;
+    auto length = std::min(cols, static_cast<int>(2.0 / std::pow(1.0 - uniform(gen), 1.0 / 1.5)));
+    for (int k = 0; k < length; k++) {
+      entries.push_back({static_cast<Index>(i), static_cast<Index>(col(gen)), static_cast<T>(value(gen))});
+    }
+  }
+  return ppc::core::from_entries<ppc::core::CrsMatrix<T, Index>>(static_cast<Index>(rows), static_cast<Index>(cols),
+                                                                  entries);
+}
+
+template <class T>
+std::vector<T> make_random_vector(int size, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::vector<T> x(size);
+  for (auto& element : x) element = static_cast<T>(value(gen));
+  return x;
+}
+
+template <class T, class Index>
+std::vector<T> multiply_dense(const ppc::core::CrsMatrix<T, Index>& a, const std::vector<T>& x) {
+  auto dense = ppc::core::to_dense(a);
+  std::vector<T> y(a.rows);
+  for (Index i = 0; i < a.rows; i++) {
+    for (Index j = 0; j < a.cols; j++) y[i] += dense[static_cast<size_t>(i) * a.cols + j] * x[j];
+  }
+  return y;
+}
+
+template <class T>
+void expect_near(const std::vector<T>& actual, const std::vector<T>& expected, double tolerance) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); i++) EXPECT_NEAR(actual[i], expected[i], tolerance) << i;
+}
+
+// Threads are set to more than one to split rows into several parts on any machine
+class spmv_tests : public ::testing::Test {
+ protected:
+  void SetUp() override { ppc::core::set_num_threads(4); }
+  void TearDown() override {
+    ppc::core::set_num_threads(0);
+    ppc::core::set_simd_level(ppc::core::get_cpu_simd_level());
+  }
+};
+
+}  // namespace
+
+TEST_F(spmv_tests, check_split_by_cost) {
+  std::vector<size_t> prefix = {0, 1, 2, 102, 103, 104, 105, 106};
+  auto bounds = ppc::core::split_by_cost(7, 4, [&](size_t i) { return prefix[i]; });
+  EXPECT_EQ(bounds, (std::vector<size_t>{0, 3, 3, 3, 7}));
+  bounds = ppc::core::split_by_cost(6, 3, [](size_t i) { return i; });
+  EXPECT_EQ(bounds, (std::vector<size_t>{0, 2, 4, 6}));
+  bounds = ppc::core::split_by_cost(0, 2, [](size_t i) { return i; });
+  EXPECT_EQ(bounds, (std::vector<size_t>{0, 0, 0}));
+}
+
+TEST_F(spmv_tests, check_crs_backends) {
+  auto a = make_power_law_matrix<double>(3000, 500, 1);
+  auto x = make_random_vector<double>(a.cols, 2);
+  auto expected = multiply_dense(a, x);
+  auto check = [&](const auto& backend) {
+    std::vector<double> y(a.rows, std::numeric_limits<double>::quiet_NaN());
+    ppc::core::spmv(a, x, y, backend);
+    expect_near(y, expected, 1e-12);
+  };
+  check(ppc::core::SeqSortBackend());
+  check(ppc::core::OmpSortBackend());
+  check(ppc::core::StlSortBackend());
+
+  std::vector<double> y(a.rows);
+  std::vector<double> short_x(a.cols - 1);
+  EXPECT_THROW(ppc::core::spmv(a, short_x, y), std::invalid_argument);
+}
+
+TEST_F(spmv_tests, check_sell_layout) {
+  // row lengths 1, 3, 0, 2, 2
+  std::vector<ppc::core::SparseEntry<double>> entries = {{0, 0, 1.0}, {1, 0, 2.0}, {1, 1, 3.0}, {1, 2, 4.0},
+                                                         {3, 1, 5.0}, {3, 2, 6.0}, {4, 0, 7.0}, {4, 2, 8.0}};
+  auto a = ppc::core::from_entries<ppc::core::CrsMatrix<double>>(5, 3, entries);
+  auto sell = ppc::core::to_sell(a, 2, 4);
+  EXPECT_EQ(sell.row_order, (std::vector<int32_t>{1, 3, 0, 2, 4}));
+  EXPECT_EQ(sell.lengths, (std::vector<int32_t>{3, 2, 1, 0, 2, 0}));
+  EXPECT_EQ(sell.slice_ptr, (std::vector<int32_t>{0, 6, 8, 12}));
+  EXPECT_EQ(sell.index, (std::vector<int32_t>{0, 1, 1, 2, 2, 0, 0, 0, 0, 0, 2, 0}));
+  EXPECT_EQ(sell.values, (std::vector<double>{2, 5, 3, 6, 4, 0, 1, 0, 7, 0, 8, 0}));
+  EXPECT_EQ(sell.get_nnz(), 8U);
+  EXPECT_EQ(sell.get_padded_nnz(), 12U);
+
+  EXPECT_EQ(sell.get_overflow_nnz(), 0U);
+  EXPECT_EQ(ppc::core::to_sell(a, 2, 1).row_order, (std::vector<int32_t>{0, 1, 2, 3, 4}));
+
+  // padding the slice to 9 would store 36 entries for 12 nonzeros
+  entries = {{0, 0, 1.0}, {1, 1, 2.0}, {2, 2, 3.0}};
+  for (int32_t j = 0; j < 9; j++) entries.push_back({3, j, 4.0 + j});
+  auto skewed = ppc::core::to_sell(ppc::core::from_entries<ppc::core::CrsMatrix<double>>(4, 9, entries), 4, 4);
+  EXPECT_EQ(skewed.lengths, (std::vector<int32_t>{1, 1, 1, 1}));
+  EXPECT_EQ(skewed.get_padded_nnz(), 4U);
+  EXPECT_EQ(skewed.overflow_rows, (std::vector<int32_t>{3}));
+  EXPECT_EQ(skewed.overflow_ptr, (std::vector<int32_t>{0, 8}));
+  EXPECT_EQ(skewed.overflow_index, (std::vector<int32_t>{1, 2, 3, 4, 5, 6, 7, 8}));
+  std::vector<double> x(9, 1.0);
+  std::vector<double> y(4);
+  ppc::core::spmv(skewed, x, y);
+  EXPECT_EQ(y, (std::vector<double>{1.0, 2.0, 3.0, 72.0}));
+  EXPECT_THROW(ppc::core::to_sell(a, 0, 1), std::invalid_argument);
+  EXPECT_THROW(ppc::core::to_sell(a, 4, 6), std::invalid_argument);
+}
+
+TEST_F(spmv_tests, check_sell_kernels) {
+  auto a = make_power_law_matrix<double>(2021, 700, 3);
+  auto x = make_random_vector<double>(a.cols, 4);
+  auto expected = multiply_dense(a, x);
+  // kernels of every level add the same products in the same order
+  std::map<std::pair<size_t, size_t>, std::vector<double>> scalar_results;
+  for (auto level : {ppc::core::SimdLevel::SCALAR, ppc::core::SimdLevel::AVX2, ppc::core::SimdLevel::AVX512}) {
+    ppc::core::set_simd_level(level);
+    for (size_t height : {1, 4, 8, 16}) {
+      for (size_t scope : {size_t{1}, height * 8}) {
+        SCOPED_TRACE(ppc::core::get_simd_level_name(level) + " C=" + std::to_string(height) +
+                     " sigma=" + std::to_string(scope));
+        auto sell = ppc::core::to_sell(a, height, scope);
+        std::vector<double> y(a.rows, std::numeric_limits<double>::quiet_NaN());
+        ppc::core::spmv(sell, x, y, ppc::core::OmpSortBackend());
+        expect_near(y, expected, 1e-12);
+        auto scalar = scalar_results.emplace(std::make_pair(height, scope), y).first;
+        EXPECT_EQ(y, scalar->second);
+      }
+    }
+  }
+}
+
+TEST_F(spmv_tests, check_sell_padding_isnt_read) {
+  // 0 * inf of a padded entry at column 0 would make rows without it NaN
+  std::vector<ppc::core::SparseEntry<double>> entries;
+  for (int32_t i = 0; i < 20; i++) {
+    for (int32_t k = 0; k <= i % 5; k++) entries.push_back({i, k + 1, 1.0});
+  }
+  entries.push_back({19, 0, 1.0});
+  auto a = ppc::core::from_entries<ppc::core::CrsMatrix<double>>(20, 6, entries);
+  std::vector<double> x = {std::numeric_limits<double>::infinity(), 1, 1, 1, 1, 1};
+  for (auto level : {ppc::core::SimdLevel::SCALAR, ppc::core::SimdLevel::AVX2, ppc::core::SimdLevel::AVX512}) {
+    ppc::core::set_simd_level(level);
+    auto sell = ppc::core::to_sell(a, 8, 1);
+    std::vector<double> y(a.rows);
+    ppc::core::spmv(sell, x, y);
+    for (int32_t i = 0; i < 19; i++) EXPECT_EQ(y[i], i % 5 + 1) << i;
+    EXPECT_TRUE(std::isinf(y[19]));
+  }
+}
+
+TEST_F(spmv_tests, check_sell_other_types) {
+  auto a = make_power_law_matrix<float, int64_t>(500, 300, 5);
+  auto x = make_random_vector<float>(300, 6);
+  auto expected = multiply_dense(a, x);
+  auto sell = ppc::core::to_sell(a);
+  std::vector<float> y(500);
+  ppc::core::spmv(sell, x, y, ppc::core::StlSortBackend());
+  expect_near(y, expected, 1e-4);
+  std::vector<float> crs_y(500);
+  ppc::core::spmv(a, x, crs_y, ppc::core::SeqSortBackend());
+  EXPECT_EQ(crs_y, y);
+
+  ppc::core::CrsMatrix<double> empty(0, 4);
+  auto empty_sell = ppc::core::to_sell(empty);
+  std::vector<double> empty_x(4);
+  std::vector<double> empty_y;
+  EXPECT_NO_THROW(ppc::core::spmv(empty_sell, empty_x, empty_y));
+  EXPECT_EQ(empty_sell.get_num_slices(), 0U);
+}
@@ -0,0 +1,409 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SPARSE_INCLUDE_SPARSE_HPP_
+#define MODULES_CORE_SPARSE_INCLUDE_SPARSE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ppc::core {
+
+// CRS stores the matrix by rows, CCS by columns
+enum class SparseLayout { CRS, CCS };
+
+// Arrays of a compressed matrix owned elsewhere, e.g. by a memory mapped
+// file. Same meaning as the members of SparseMatrix below
+template <class T, class Index = int32_t, SparseLayout Layout = SparseLayout::CRS>
+struct SparseView {
+  using value_type = T;
+  using index_type = Index;
+  static constexpr SparseLayout LAYOUT = Layout;
+
+  Index rows = 0;
+  Index cols = 0;
+  std::span<const Index> ptr;
+  std::span<const Index> index;
+  std::span<const T> values;
+
+  [[nodiscard]] Index get_num_lines() const { return Layout == SparseLayout::CRS ? rows : cols; }
+  [[nodiscard]] Index get_line_size() const { return Layout == SparseLayout::CRS ? cols : rows; }
+  [[nodiscard]] size_t get_nnz() const { return values.size(); }
+};
+
+// Compressed sparse matrix. Lines are rows for CRS and columns for CCS:
+// entries of line i are [ptr[i], ptr[i + 1]) of index (column numbers for
+// CRS, row numbers for CCS) and values. Index is the type of both numbers and
+// offsets, so it also bounds the number of nonzeros. Indices of a line are
+// sorted unless a function producing the matrix says otherwise
+template <class T, class Index = int32_t, SparseLayout Layout = SparseLayout::CRS>
+struct SparseMatrix {
+  static_assert(std::is_integral_v<Index>, "Index of a sparse matrix must be an integer");
+
+  using value_type = T;
+  using index_type = Index;
+  static constexpr SparseLayout LAYOUT = Layout;
+
+  Index rows = 0;
+  Index cols = 0;
+  std::vector<Index> ptr;
+  std::vector<Index> index;
+  std::vector<T> values;
+
+  SparseMatrix() : ptr(1) {}
+  SparseMatrix(Index rows_, Index cols_) : rows(rows_), cols(cols_), ptr(static_cast<size_t>(get_num_lines()) + 1) {}
+
+  [[nodiscard]] Index get_num_lines() const { return Layout == SparseLayout::CRS ? rows : cols; }
+  [[nodiscard]] Index get_line_size() const { return Layout == SparseLayout::CRS ? cols : rows; }
+  [[nodiscard]] size_t get_nnz() const { return values.size(); }
+  [[nodiscard]] SparseView<T, Index, Layout> get_view() const { return {rows, cols, ptr, index, values}; }
+
+  bool operator==(const SparseMatrix& other) const = default;
+};
+
+template <class T, class Index = int32_t>
+using CrsMatrix = SparseMatrix<T, Index, SparseLayout::CRS>;
+template <class T, class Index = int32_t>
+using CcsMatrix = SparseMatrix<T, Index, SparseLayout::CCS>;
+template <class T, class Index = int32_t>
+using CrsView = SparseView<T, Index, SparseLayout::CRS>;
+template <class T, class Index = int32_t>
+using CcsView = SparseView<T, Index, SparseLayout::CCS>;
+
+template <class T, class Index = int32_t>
+struct SparseEntry {
+  Index row;
+  Index col;
+  T value;
+};
+
+namespace sparse_detail {
+
+// Arrays of a compressed matrix without its layout: num_lines lines of
+// numbers below line_size. CCS of A and CRS of A^T have the same view
+template <class T, class Index>
+struct CompressedView {
+  Index num_lines;
+  Index line_size;
+  const Index* ptr;
+  const Index* index;
+  const T* values;
+};
+
+template <class T, class Index, SparseLayout Layout>
+CompressedView<T, Index> make_view(const SparseView<T, Index, Layout>& matrix) {
+  return {matrix.get_num_lines(), matrix.get_line_size(), matrix.ptr.data(), matrix.index.data(),
+          matrix.values.data()};
+}
+
+template <class T, class Index, SparseLayout Layout>
+CompressedView<T, Index> make_view(const SparseMatrix<T, Index, Layout>& matrix) {
+  return make_view(matrix.get_view());
+}
+
+template <class Index>
+Index check_nnz(size_t nnz) {
+  if (nnz > static_cast<size_t>(std::numeric_limits<Index>::max())) {
+    throw std::overflow_error(std::to_string(nnz) + " nonzeros don't fit index type of the sparse matrix");
+  }
+  return static_cast<Index>(nnz);
+}
+
+// Counting sort of entries by their numbers: line j of the result has
+// entries with number j ordered by their lines, i.e. the transposed matrix
+// with sorted indices
+template <class T, class Index>
+void transpose_compressed(const CompressedView<T, Index>& from, std::vector<Index>& ptr, std::vector<Index>& index,
+                          std::vector<T>& values) {
+  auto nnz = static_cast<size_t>(from.ptr[from.num_lines]);
+  ptr.assign(static_cast<size_t>(from.line_size) + 1, 0);
+  index.resize(nnz);
+  values.resize(nnz);
+  for (size_t k = 0; k < nnz; k++) ptr[static_cast<size_t>(from.index[k]) + 1]++;
+  for (Index j = 0; j < from.line_size; j++) ptr[j + 1] += ptr[j];
+  std::vector<Index> positions(ptr.begin(), ptr.end() - 1);
+  for (Index i = 0; i < from.num_lines; i++) {
+    for (auto k = from.ptr[i]; k < from.ptr[i + 1]; k++) {
+      auto position = positions[from.index[k]]++;
+      index[position] = i;
+      values[position] = from.values[k];
+    }
+  }
+}
+
+}  // namespace sparse_detail
+
+// Bounds of num_parts ranges of lines [0, num_lines) with about equal cost,
+// where cost_prefix(i) is the total cost of lines before i (e.g. ptr[i] + i
+// for nonzeros plus a line overhead, or a prefix sum of multiply-adds of rows
+// of a product). Part p is [bounds[p], bounds[p + 1]), a line heavier than a
+// part makes the parts around it empty
+template <class CostPrefix>
+std::vector<size_t> split_by_cost(size_t num_lines, size_t num_parts, const CostPrefix& cost_prefix) {
+  std::vector<size_t> bounds(num_parts + 1, num_lines);
+  bounds[0] = 0;
+  auto total = static_cast<size_t>(cost_prefix(num_lines));
+  for (size_t part = 1; part < num_parts; part++) {
+    auto target = static_cast<size_t>(static_cast<double>(total) * static_cast<double>(part) / num_parts);
+    // first line whose prefix reaches the target
+    size_t low = bounds[part - 1];
+    size_t high = num_lines;
+    while (low < high) {
+      auto middle = low + (high - low) / 2;
+      if (static_cast<size_t>(cost_prefix(middle)) < target) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    bounds[part] = low;
+  }
+  return bounds;
+}
+
+// Prefix sums of line costs for split_by_cost and CostRange: element i is the
+// total of line_cost(i') over lines i' < i. Blocks of lines are scanned by
+// jobs of the backend, then offsets of the blocks are added to them, so the
+// cost estimation pass isn't serial. TBB tasks get parallel_scan from the
+// overload in sparse_tbb.hpp
+template <class Backend, class LineCost>
+std::vector<size_t> make_cost_prefix(size_t num_lines, const LineCost& line_cost, const Backend& backend) {
+  std::vector<size_t> prefix(num_lines + 1, 0);
+  auto num_blocks = std::min(num_lines, static_cast<size_t>(std::max(backend.get_num_threads(), 1)) * 4);
+  auto block_begin = [&](size_t block) { return block * num_lines / num_blocks; };
+  backend.for_each(num_blocks, [&](size_t block) {
+    size_t sum = 0;
+    for (auto i = block_begin(block); i < block_begin(block + 1); i++) {
+      sum += static_cast<size_t>(line_cost(i));
+      prefix[i + 1] = sum;
+    }
+  });
+  // blocks aren't empty, so the last prefix of a block is its total
+  std::vector<size_t> offsets(num_blocks, 0);
+  for (size_t block = 1; block < num_blocks; block++) {
+    offsets[block] = offsets[block - 1] + prefix[block_begin(block)];
+  }
+  backend.for_each(num_blocks, [&](size_t block) {
+    for (auto i = block_begin(block); i < block_begin(block + 1); i++) prefix[i + 1] += offsets[block];
+  });
+  return prefix;
+}
+
+// Throws std::invalid_argument if the arrays don't describe a matrix of its
+// size: ptr must have a line more and be non-decreasing from 0 to nnz,
+// numbers must be below the line size and sorted within lines (unless
+// check_sorted is false, they must be unique within lines then)
+template <class T, class Index, SparseLayout Layout>
+void validate(const SparseView<T, Index, Layout>& matrix, bool check_sorted = true) {
+  auto fail = [](const std::string& what) { throw std::invalid_argument("Invalid sparse matrix: " + what); };
+  if (matrix.rows < 0 || matrix.cols < 0) fail("negative size");
+  auto num_lines = static_cast<size_t>(matrix.get_num_lines());
+  if (matrix.ptr.size() != num_lines + 1) fail("ptr has " + std::to_string(matrix.ptr.size()) + " offsets");
+  if (matrix.index.size() != matrix.values.size()) fail("index and values differ in size");
+  if (matrix.ptr[0] != 0 || static_cast<size_t>(matrix.ptr[num_lines]) != matrix.get_nnz()) {
+    fail("ptr doesn't span the entries");
+  }
+  // offsets are checked before any line is walked, so lines stay within the entries
+  for (size_t i = 0; i < num_lines; i++) {
+    if (matrix.ptr[i] > matrix.ptr[i + 1]) fail("ptr decreases at line " + std::to_string(i));
+  }
+  // line + 1 of the last entry with the number, for unsorted lines
+  std::vector<size_t> seen(check_sorted ? 0 : static_cast<size_t>(matrix.get_line_size()), 0);
+  for (size_t i = 0; i < num_lines; i++) {
+    for (auto k = matrix.ptr[i]; k < matrix.ptr[i + 1]; k++) {
+      if (matrix.index[k] < 0 || matrix.index[k] >= matrix.get_line_size()) {
+        fail("number out of range in line " + std::to_string(i));
+      }
+      if (check_sorted && k > matrix.ptr[i] && matrix.index[k - 1] >= matrix.index[k]) {
+        fail("numbers aren't sorted in line " + std::to_string(i));
+      }
+      if (!check_sorted && std::exchange(seen[matrix.index[k]], i + 1) == i + 1) {
+        fail("numbers repeat in line " + std::to_string(i));
+      }
+    }
+  }
+}
+
+template <class T, class Index, SparseLayout Layout>
+void validate(const SparseMatrix<T, Index, Layout>& matrix, bool check_sorted = true) {
+  validate(matrix.get_view(), check_sorted);
+}
+
+// validate() for checks which don't throw, e.g. validation() of tasks
+template <class T, class Index, SparseLayout Layout>
+bool is_valid(const SparseView<T, Index, Layout>& matrix, bool check_sorted = true) {
+  try {
+    validate(matrix, check_sorted);
+  } catch (const std::invalid_argument&) {
+    return false;
+  }
+  return true;
+}
+
+// View of arrays which may be longer than the matrix, like vectors of tasks
+// with spare capacity: ptr is cut to the lines and index and values to the
+// entries. Arrays too short for that are kept whole, so validate() and
+// is_valid() reject the view
+template <SparseLayout Layout, class T, class Index>
+SparseView<T, Index, Layout> make_prefix_view(Index rows, Index cols, std::type_identity_t<std::span<const Index>> ptr,
+                                              std::type_identity_t<std::span<const Index>> index,
+                                              std::type_identity_t<std::span<const T>> values) {
+  SparseView<T, Index, Layout> view{rows, cols, ptr, index, values};
+  auto num_lines = view.get_num_lines();
+  if (num_lines < 0 || ptr.size() <= static_cast<size_t>(num_lines)) return view;
+  view.ptr = ptr.first(static_cast<size_t>(num_lines) + 1);
+  auto nnz = view.ptr.back();
+  if (nnz >= 0 && static_cast<size_t>(nnz) <= std::min(index.size(), values.size())) {
+    view.index = index.first(static_cast<size_t>(nnz));
+    view.values = values.first(static_cast<size_t>(nnz));
+  }
+  return view;
+}
+
+// Copy of the viewed arrays
+template <class T, class Index, SparseLayout Layout>
+SparseMatrix<T, Index, Layout> to_matrix(const SparseView<T, Index, Layout>& view) {
+  SparseMatrix<T, Index, Layout> matrix(view.rows, view.cols);
+  matrix.ptr.assign(view.ptr.begin(), view.ptr.end());
+  matrix.index.assign(view.index.begin(), view.index.end());
+  matrix.values.assign(view.values.begin(), view.values.end());
+  return matrix;
+}
+
+// Matrix of the entries, values of duplicate positions are summed. Throws
+// std::invalid_argument for an entry out of the matrix
+template <class Matrix>
+Matrix from_entries(typename Matrix::index_type rows, typename Matrix::index_type cols,
+                    std::span<const SparseEntry<typename Matrix::value_type, typename Matrix::index_type>> entries) {
+  using T = typename Matrix::value_type;
+  using Index = typename Matrix::index_type;
+  // Bucket the entries by numbers, then transposing gives sorted lines
+  std::vector<Index> ptr;
+  std::vector<Index> index;
+  std::vector<T> values;
+  {
+    auto nnz = sparse_detail::check_nnz<Index>(entries.size());
+    auto num_lines = Matrix::LAYOUT == SparseLayout::CRS ? rows : cols;
+    auto num_numbers = Matrix::LAYOUT == SparseLayout::CRS ? cols : rows;
+    std::vector<Index> line_ptr(static_cast<size_t>(num_numbers) + 1, 0);
+    for (const auto& entry : entries) {
+      if (entry.row < 0 || entry.row >= rows || entry.col < 0 || entry.col >= cols) {
+        throw std::invalid_argument("Entry (" + std::to_string(entry.row) + ", " + std::to_string(entry.col) +
+                                    ") is out of the sparse matrix");
+      }
+      auto number = Matrix::LAYOUT == SparseLayout::CRS ? entry.col : entry.row;
+      line_ptr[static_cast<size_t>(number) + 1]++;
+    }
+    for (Index j = 0; j < num_numbers; j++) line_ptr[j + 1] += line_ptr[j];
+    std::vector<Index> line_index(static_cast<size_t>(nnz));
+    std::vector<T> line_values(static_cast<size_t>(nnz));
+    std::vector<Index> positions(line_ptr.begin(), line_ptr.end() - 1);
+    for (const auto& entry : entries) {
+      auto [line, number] = Matrix::LAYOUT == SparseLayout::CRS ? std::pair(entry.row, entry.col)
+                                                                  : std::pair(entry.col, entry.row);
+      auto position = positions[number]++;
+      line_index[position] = line;
+      line_values[position] = entry.value;
+    }
+    sparse_detail::CompressedView<T, Index> view{num_numbers, num_lines, line_ptr.data(), line_index.data(),
+                                                 line_values.data()};
+    sparse_detail::transpose_compressed(view, ptr, index, values);
+  }
+  // Duplicates are adjacent now
+  Matrix matrix(rows, cols);
+  size_t nnz = 0;
+  for (Index i = 0; i < matrix.get_num_lines(); i++) {
+    for (auto k = ptr[i]; k < ptr[i + 1]; k++) {
+      if (nnz > static_cast<size_t>(matrix.ptr[i]) && index[nnz - 1] == index[k]) {
+        values[nnz - 1] += values[k];
+      } else {
+        index[nnz] = index[k];
+        values[nnz] = values[k];
+        nnz++;
+      }
+    }
+    matrix.ptr[i + 1] = static_cast<Index>(nnz);
+  }
+  index.resize(nnz);
+  values.resize(nnz);
+  matrix.index = std::move(index);
+  matrix.values = std::move(values);
+  return matrix;
+}
+
+// Nonzeros of a row-major dense matrix
+template <class Matrix>
+Matrix from_dense(const typename Matrix::value_type* dense, typename Matrix::index_type rows,
+                  typename Matrix::index_type cols) {
+  using T = typename Matrix::value_type;
+  using Index = typename Matrix::index_type;
+  Matrix matrix(rows, cols);
+  auto at = [&](Index i, Index j) -> const T& {
+    return Matrix::LAYOUT == SparseLayout::CRS ? dense[static_cast<size_t>(i) * cols + j]
+                                               : dense[static_cast<size_t>(j) * cols + i];
+  };
+  for (Index i = 0; i < matrix.get_num_lines(); i++) {
+    for (Index j = 0; j < matrix.get_line_size(); j++) {
+      if (at(i, j) != T{}) {
+        matrix.index.push_back(j);
+        matrix.values.push_back(at(i, j));
+      }
+    }
+    matrix.ptr[i + 1] = sparse_detail::check_nnz<Index>(matrix.values.size());
+  }
+  return matrix;
+}
+
+// Row-major dense matrix, for tests and small outputs
+template <class T, class Index, SparseLayout Layout>
+std::vector<T> to_dense(const SparseMatrix<T, Index, Layout>& matrix) {
+  std::vector<T> dense(static_cast<size_t>(matrix.rows) * static_cast<size_t>(matrix.cols));
+  for (Index i = 0; i < matrix.get_num_lines(); i++) {
+    for (auto k = matrix.ptr[i]; k < matrix.ptr[i + 1]; k++) {
+      auto [row, col] = Layout == SparseLayout::CRS ? std::pair(i, matrix.index[k]) : std::pair(matrix.index[k], i);
+      dense[static_cast<size_t>(row) * static_cast<size_t>(matrix.cols) + col] += matrix.values[k];
+    }
+  }
+  return dense;
+}
+
+// The same matrix in the other layout, indices of the result are sorted
+template <SparseLayout To, class T, class Index, SparseLayout From>
+SparseMatrix<T, Index, To> convert_layout(const SparseMatrix<T, Index, From>& matrix) {
+  SparseMatrix<T, Index, To> result(matrix.rows, matrix.cols);
+  if constexpr (To == From) {
+    result = matrix;
+  } else {
+    sparse_detail::transpose_compressed(sparse_detail::make_view(matrix), result.ptr, result.index, result.values);
+  }
+  return result;
+}
+
+template <class T, class Index>
+CcsMatrix<T, Index> to_ccs(const CrsMatrix<T, Index>& matrix) {
+  return convert_layout<SparseLayout::CCS>(matrix);
+}
+
+template <class T, class Index>
+CrsMatrix<T, Index> to_crs(const CcsMatrix<T, Index>& matrix) {
+  return convert_layout<SparseLayout::CRS>(matrix);
+}
+
+// A^T in the same layout, indices of the result are sorted
+template <class T, class Index, SparseLayout Layout>
+SparseMatrix<T, Index, Layout> transpose(const SparseMatrix<T, Index, Layout>& matrix) {
+  SparseMatrix<T, Index, Layout> result(matrix.cols, matrix.rows);
+  sparse_detail::transpose_compressed(sparse_detail::make_view(matrix), result.ptr, result.index, result.values);
+  return result;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SPARSE_INCLUDE_SPARSE_HPP_
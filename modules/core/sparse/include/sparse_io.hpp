@@ -0,0 +1,349 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SPARSE_INCLUDE_SPARSE_IO_HPP_
+#define MODULES_CORE_SPARSE_INCLUDE_SPARSE_IO_HPP_
+
+#include <algorithm>
+#include <charconv>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
+
+namespace ppc::core {
+
+// Read-only mapping of a whole file, the contents are read into memory where
+// mmap isn't available. Throws std::runtime_error if the file can't be opened
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  [[nodiscard]] const char* data() const { return begin; }
+  [[nodiscard]] size_t size() const { return length; }
+
+ private:
+  const char* begin = nullptr;
+  size_t length = 0;
+  std::vector<char> buffer;
+  bool mapped = false;
+};
+
+// Banner and size line of a Matrix Market file, only coordinate format
+// (the one of sparse matrices) is read
+struct MatrixMarketHeader {
+  enum Field { REAL, INTEGER, COMPLEX, PATTERN } field = REAL;
+  // only the lower triangle is stored for all but GENERAL
+  enum Symmetry { GENERAL, SYMMETRIC, SKEW_SYMMETRIC, HERMITIAN } symmetry = GENERAL;
+  int64_t rows = 0;
+  int64_t cols = 0;
+  // entries stored in the file
+  int64_t nnz = 0;
+  // offset of the first entry line
+  size_t body_offset = 0;
+};
+
+// Throws std::runtime_error for a malformed or unsupported header
+MatrixMarketHeader parse_matrix_market_header(std::string_view text);
+
+namespace sparse_io_detail {
+
+// Bodies smaller than this are parsed by one thread
+constexpr size_t MIN_CHUNK_BYTES = size_t{1} << 20;
+
+[[noreturn]] void throw_parse_error(const std::string& what, std::string_view line);
+
+inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline void skip_blanks(const char*& position, const char* end) {
+  while (position != end && is_blank(*position)) position++;
+}
+
+template <class Number>
+Number parse_number(const char*& position, const char* end, std::string_view line) {
+  skip_blanks(position, end);
+  Number number{};
+  // from_chars doesn't take a leading plus, which some writers emit
+  if (position != end && *position == '+') position++;
+  auto [next, error] = std::from_chars(position, end, number);
+  if (error != std::errc()) throw_parse_error("Bad number in entry", line);
+  position = next;
+  return number;
+}
+
+template <class T>
+struct IsComplex : std::false_type {};
+template <class T>
+struct IsComplex<std::complex<T>> : std::true_type {};
+
+// Position of an entry line and its value converted to T
+template <class T, class Index>
+SparseEntry<T, Index> parse_entry(std::string_view line, const MatrixMarketHeader& header) {
+  const char* position = line.data();
+  const char* end = line.data() + line.size();
+  auto row = parse_number<int64_t>(position, end, line);
+  auto col = parse_number<int64_t>(position, end, line);
+  if (row < 1 || row > header.rows || col < 1 || col > header.cols) {
+    throw_parse_error("Entry out of the matrix", line);
+  }
+  SparseEntry<T, Index> entry{static_cast<Index>(row - 1), static_cast<Index>(col - 1), T{}};
+  if (header.field == MatrixMarketHeader::PATTERN) {
+    entry.value = T{1};
+  } else if (header.field == MatrixMarketHeader::COMPLEX) {
+    if constexpr (IsComplex<T>::value) {
+      auto real = parse_number<double>(position, end, line);
+      auto imag = parse_number<double>(position, end, line);
+      entry.value = T(real, imag);
+    }
+  } else {
+    entry.value = static_cast<T>(parse_number<double>(position, end, line));
+  }
+  skip_blanks(position, end);
+  if (position != end) throw_parse_error("Trailing characters in entry", line);
+  return entry;
+}
+
+// Mirror of an entry of the lower triangle
+template <class T, class Index>
+SparseEntry<T, Index> get_mirror(const SparseEntry<T, Index>& entry, MatrixMarketHeader::Symmetry symmetry) {
+  SparseEntry<T, Index> mirror{entry.col, entry.row, entry.value};
+  if (symmetry == MatrixMarketHeader::SKEW_SYMMETRIC) mirror.value = -entry.value;
+  if constexpr (IsComplex<T>::value) {
+    if (symmetry == MatrixMarketHeader::HERMITIAN) mirror.value = std::conj(entry.value);
+  }
+  return mirror;
+}
+
+// Entry lines of [begin, end) are passed to body, blank and comment lines
+// are skipped
+template <class Body>
+void for_each_line(const char* begin, const char* end, const Body& body) {
+  while (begin != end) {
+    const auto* line_end = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+    if (line_end == nullptr) line_end = end;
+    const auto* first = begin;
+    skip_blanks(first, line_end);
+    if (first != line_end && *first != '%') body(std::string_view(first, static_cast<size_t>(line_end - first)));
+    begin = line_end == end ? end : line_end + 1;
+  }
+}
+
+// Codes of element types stored in the binary header
+template <class T>
+constexpr uint32_t get_type_code() {
+  if constexpr (std::is_same_v<T, int32_t>) return 1;
+  if constexpr (std::is_same_v<T, int64_t>) return 2;
+  if constexpr (std::is_same_v<T, uint32_t>) return 3;
+  if constexpr (std::is_same_v<T, uint64_t>) return 4;
+  if constexpr (std::is_same_v<T, float>) return 5;
+  if constexpr (std::is_same_v<T, double>) return 6;
+  if constexpr (std::is_same_v<T, std::complex<float>>) return 7;
+  if constexpr (std::is_same_v<T, std::complex<double>>) return 8;
+  return 0;
+}
+
+// Layout of a binary sparse file: this header, then ptr, index and values,
+// each array at an offset aligned to ALIGNMENT, so mapped arrays are aligned
+// as their elements need. Integers are in the byte order of the writer,
+// which is checked by BYTE_ORDER_MARK
+struct BinaryHeader {
+  static constexpr char MAGIC[8] = {'P', 'P', 'C', 'S', 'P', 'M', 'A', 'T'};
+  static constexpr uint32_t VERSION = 1;
+  static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+  static constexpr uint64_t ALIGNMENT = 64;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order_mark;
+  uint32_t layout;
+  uint32_t index_type;
+  uint32_t value_type;
+  uint32_t reserved;
+  uint64_t rows;
+  uint64_t cols;
+  uint64_t nnz;
+  uint64_t ptr_offset;
+  uint64_t index_offset;
+  uint64_t values_offset;
+};
+
+// Header for a matrix with sizes and offsets of its arrays filled in
+BinaryHeader make_binary_header(uint32_t layout, uint32_t index_type, uint32_t value_type, size_t index_size,
+                                uint64_t rows, uint64_t cols, uint64_t num_lines, uint64_t nnz);
+// Throws std::runtime_error unless the file starts with a header of these
+// types whose arrays fit in the file, returns the header
+BinaryHeader check_binary_header(const MappedFile& file, const std::string& path, uint32_t layout,
+                                 uint32_t index_type, uint32_t value_type, size_t index_size, size_t value_size);
+void write_binary(const std::string& path, const BinaryHeader& header, std::span<const std::byte> ptr,
+                  std::span<const std::byte> index, std::span<const std::byte> values);
+
+}  // namespace sparse_io_detail
+
+// Matrix of a coordinate Matrix Market file. Lines are parsed in parallel
+// straight from the mapped file, no dense form is built. Symmetric matrices
+// are expanded to both triangles, pattern ones get unit values. Throws
+// std::runtime_error for a malformed file or a complex one read as real, and
+// std::overflow_error if sizes don't fit Index
+template <class Matrix, class Backend = StlSortBackend>
+Matrix read_matrix_market(const std::string& path, const Backend& backend = {}) {
+  using T = typename Matrix::value_type;
+  using Index = typename Matrix::index_type;
+  MappedFile file(path);
+  std::string_view text(file.data(), file.size());
+  auto header = parse_matrix_market_header(text);
+  if (header.field == MatrixMarketHeader::COMPLEX && !sparse_io_detail::IsComplex<T>::value) {
+    throw std::runtime_error("Complex matrix " + path + " can't be read into real values");
+  }
+  auto max_index = static_cast<uint64_t>(std::numeric_limits<Index>::max());
+  if (static_cast<uint64_t>(header.rows) > max_index || static_cast<uint64_t>(header.cols) > max_index) {
+    throw std::overflow_error("Size of " + path + " doesn't fit index type of the sparse matrix");
+  }
+
+  // Chunks of the body start after a line break, so every line belongs to
+  // the chunk where it starts. Entry lines are counted first to find where
+  // the entries of each chunk go
+  const char* body = file.data() + header.body_offset;
+  const char* end = file.data() + file.size();
+  auto body_size = static_cast<size_t>(end - body);
+  auto max_chunks = static_cast<size_t>(std::max(1, backend.get_num_threads()));
+  auto num_chunks = std::clamp<size_t>(body_size / sparse_io_detail::MIN_CHUNK_BYTES, 1, max_chunks);
+  std::vector<const char*> bounds(num_chunks + 1, end);
+  bounds[0] = body;
+  for (size_t chunk = 1; chunk < num_chunks; chunk++) {
+    const char* position = body + chunk * body_size / num_chunks;
+    const auto* line_end = static_cast<const char*>(std::memchr(position, '\n', static_cast<size_t>(end - position)));
+    bounds[chunk] = std::max(bounds[chunk - 1], line_end == nullptr ? end : line_end + 1);
+  }
+  std::vector<size_t> offsets(num_chunks + 1, 0);
+  backend.for_each(num_chunks, [&](size_t chunk) {
+    sparse_io_detail::for_each_line(bounds[chunk], bounds[chunk + 1],
+                                    [&](std::string_view /*line*/) { offsets[chunk + 1]++; });
+  });
+  for (size_t chunk = 0; chunk < num_chunks; chunk++) offsets[chunk + 1] += offsets[chunk];
+  if (offsets[num_chunks] != static_cast<size_t>(header.nnz)) {
+    throw std::runtime_error(path + " has " + std::to_string(offsets[num_chunks]) + " entries instead of " +
+                             std::to_string(header.nnz));
+  }
+
+  std::vector<SparseEntry<T, Index>> entries(offsets[num_chunks]);
+  backend.for_each(num_chunks, [&](size_t chunk) {
+    auto position = offsets[chunk];
+    sparse_io_detail::for_each_line(bounds[chunk], bounds[chunk + 1], [&](std::string_view line) {
+      entries[position++] = sparse_io_detail::parse_entry<T, Index>(line, header);
+    });
+  });
+  if (header.symmetry != MatrixMarketHeader::GENERAL) {
+    auto size = entries.size();
+    for (size_t k = 0; k < size; k++) {
+      if (entries[k].row == entries[k].col) continue;
+      entries.push_back(sparse_io_detail::get_mirror(entries[k], header.symmetry));
+    }
+  }
+  return from_entries<Matrix>(static_cast<Index>(header.rows), static_cast<Index>(header.cols), entries);
+}
+
+// Write a general coordinate Matrix Market file, values are written in the
+// shortest form which reads back exactly
+template <class T, class Index, SparseLayout Layout>
+void write_matrix_market(const std::string& path, const SparseView<T, Index, Layout>& matrix) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) throw std::runtime_error("Can't create " + path);
+  std::string field = "real";
+  if constexpr (sparse_io_detail::IsComplex<T>::value) {
+    field = "complex";
+  } else if constexpr (std::is_integral_v<T>) {
+    field = "integer";
+  }
+  out << "%%MatrixMarket matrix coordinate " << field << " general\n"
+      << matrix.rows << ' ' << matrix.cols << ' ' << matrix.get_nnz() << '\n';
+  auto write_number = [&out](auto number) {
+    char buffer[64];
+    auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out << ' ' << std::string_view(buffer, static_cast<size_t>(end - buffer));
+  };
+  for (Index i = 0; i < matrix.get_num_lines(); i++) {
+    for (auto k = matrix.ptr[i]; k < matrix.ptr[i + 1]; k++) {
+      auto [row, col] = Layout == SparseLayout::CRS ? std::pair(i, matrix.index[k]) : std::pair(matrix.index[k], i);
+      out << row + 1 << ' ' << col + 1;
+      if constexpr (sparse_io_detail::IsComplex<T>::value) {
+        write_number(matrix.values[k].real());
+        write_number(matrix.values[k].imag());
+      } else {
+        write_number(matrix.values[k]);
+      }
+      out << '\n';
+    }
+  }
+  if (!out.flush()) throw std::runtime_error("Can't write " + path);
+}
+
+// Write arrays of the matrix into a binary file which MappedSparseMatrix
+// maps back without parsing
+template <class T, class Index, SparseLayout Layout>
+void write_sparse_binary(const std::string& path, const SparseView<T, Index, Layout>& matrix) {
+  static_assert(sparse_io_detail::get_type_code<T>() != 0 && sparse_io_detail::get_type_code<Index>() != 0,
+                "Binary sparse files store only arithmetic and complex values with fixed width indices");
+  auto header = sparse_io_detail::make_binary_header(
+      static_cast<uint32_t>(Layout), sparse_io_detail::get_type_code<Index>(), sparse_io_detail::get_type_code<T>(),
+      sizeof(Index), static_cast<uint64_t>(matrix.rows), static_cast<uint64_t>(matrix.cols),
+      static_cast<uint64_t>(matrix.get_num_lines()), matrix.get_nnz());
+  sparse_io_detail::write_binary(path, header, std::as_bytes(matrix.ptr), std::as_bytes(matrix.index),
+                                 std::as_bytes(matrix.values));
+}
+
+// Binary sparse file mapped into memory: get_view() points straight into the
+// mapping, so a matrix of any size is ready without reading or parsing it.
+// The constructor checks the header, the sizes of the arrays and that the
+// offsets of lines grow from 0 to nnz, so every line is within the entries,
+// and throws std::runtime_error otherwise. Numbers of lines are checked
+// only by validate(get_view())
+template <class T, class Index = int32_t, SparseLayout Layout = SparseLayout::CRS>
+class MappedSparseMatrix {
+ public:
+  explicit MappedSparseMatrix(const std::string& path) : file(std::make_unique<MappedFile>(path)) {
+    auto header = sparse_io_detail::check_binary_header(*file, path, static_cast<uint32_t>(Layout),
+                                                        sparse_io_detail::get_type_code<Index>(),
+                                                        sparse_io_detail::get_type_code<T>(), sizeof(Index), sizeof(T));
+    auto max_index = static_cast<uint64_t>(std::numeric_limits<Index>::max());
+    if (header.rows > max_index || header.cols > max_index || header.nnz > max_index) {
+      throw std::runtime_error("Sizes of " + path + " don't fit index type of the sparse matrix");
+    }
+    view.rows = static_cast<Index>(header.rows);
+    view.cols = static_cast<Index>(header.cols);
+    const char* data = file->data();
+    auto num_offsets = static_cast<size_t>(view.get_num_lines()) + 1;
+    view.ptr = {reinterpret_cast<const Index*>(data + header.ptr_offset), num_offsets};
+    view.index = {reinterpret_cast<const Index*>(data + header.index_offset), static_cast<size_t>(header.nnz)};
+    view.values = {reinterpret_cast<const T*>(data + header.values_offset), static_cast<size_t>(header.nnz)};
+    if (view.ptr.front() != 0 || static_cast<uint64_t>(view.ptr.back()) != header.nnz) {
+      throw std::runtime_error("Offsets of lines in " + path + " don't span its entries");
+    }
+    if (!std::is_sorted(view.ptr.begin(), view.ptr.end())) {
+      throw std::runtime_error("Offsets of lines in " + path + " decrease");
+    }
+  }
+
+  [[nodiscard]] const SparseView<T, Index, Layout>& get_view() const { return view; }
+
+ private:
+  std::unique_ptr<MappedFile> file;
+  SparseView<T, Index, Layout> view;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SPARSE_INCLUDE_SPARSE_IO_HPP_
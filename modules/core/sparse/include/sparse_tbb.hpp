@@ -0,0 +1,81 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SPARSE_INCLUDE_SPARSE_TBB_HPP_
+#define MODULES_CORE_SPARSE_INCLUDE_SPARSE_TBB_HPP_
+
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_scan.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "core/sort/include/sort_tbb.hpp"
+#include "core/sparse/include/sparse.hpp"
+
+namespace ppc::core {
+
+// Range of lines [0, cost_prefix.size() - 1) for TBB algorithms which is
+// split at half of its cost rather than half of its lines, cost_prefix[i]
+// being the total cost of lines before i (see split_by_cost). A range is
+// divisible while it has more than a line and its cost is above grain_cost,
+// so with simple_partitioner a heavy line ends up alone and light lines are
+// taken in chunks of about grain_cost. Header-only like TbbSortBackend
+class CostRange {
+ public:
+  explicit CostRange(std::span<const size_t> cost_prefix_, size_t grain_cost_ = 1)
+      : cost_prefix(cost_prefix_),
+        first(0),
+        last(cost_prefix_.empty() ? 0 : cost_prefix_.size() - 1),
+        grain_cost(std::max<size_t>(grain_cost_, 1)) {}
+
+  CostRange(CostRange& other, oneapi::tbb::split /*unused*/)
+      : cost_prefix(other.cost_prefix), first(other.split_line()), last(other.last), grain_cost(other.grain_cost) {
+    other.last = first;
+  }
+
+  [[nodiscard]] size_t begin() const { return first; }
+  [[nodiscard]] size_t end() const { return last; }
+  [[nodiscard]] size_t size() const { return last - first; }
+  [[nodiscard]] size_t get_cost() const { return cost_prefix[last] - cost_prefix[first]; }
+  [[nodiscard]] bool empty() const { return first == last; }
+  [[nodiscard]] bool is_divisible() const { return size() > 1 && get_cost() > grain_cost; }
+
+ private:
+  // First line whose prefix reaches the middle of the cost, kept inside the
+  // range so both halves have a line
+  [[nodiscard]] size_t split_line() const {
+    auto middle = cost_prefix[first] + get_cost() / 2;
+    auto line = std::lower_bound(cost_prefix.begin() + first + 1, cost_prefix.begin() + last - 1, middle);
+    return static_cast<size_t>(line - cost_prefix.begin());
+  }
+
+  std::span<const size_t> cost_prefix;
+  size_t first;
+  size_t last;
+  size_t grain_cost;
+};
+
+// make_cost_prefix of sparse.hpp for TBB tasks: a single parallel_scan, its
+// pre-scan pass may estimate a line twice, so line_cost should be cheap
+template <class LineCost>
+std::vector<size_t> make_cost_prefix(size_t num_lines, const LineCost& line_cost, const TbbSortBackend& /*backend*/) {
+  std::vector<size_t> prefix(num_lines + 1, 0);
+  oneapi::tbb::parallel_scan(
+      oneapi::tbb::blocked_range<size_t>(0, num_lines), size_t{0},
+      [&](const oneapi::tbb::blocked_range<size_t>& r, size_t sum, bool is_final_scan) {
+        for (auto i = r.begin(); i != r.end(); i++) {
+          sum += static_cast<size_t>(line_cost(i));
+          if (is_final_scan) prefix[i + 1] = sum;
+        }
+        return sum;
+      },
+      std::plus<>());
+  return prefix;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SPARSE_INCLUDE_SPARSE_TBB_HPP_
@@ -0,0 +1,437 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SPARSE_INCLUDE_SPGEMM_HPP_
+#define MODULES_CORE_SPARSE_INCLUDE_SPGEMM_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
+
+namespace ppc::core {
+
+struct SpgemmAttr {
+  // Accumulator of a row of the product: DENSE holds a value per column of
+  // B, HASH an open addressing table sized by the work of the row. AUTO takes
+  // DENSE unless B is too wide for it to stay small and rows of the chunk are
+  // too light to use much of it
+  enum Accumulator { AUTO, DENSE, HASH } accumulator = AUTO;
+  // sort numbers within lines of the product, otherwise they are in order of
+  // the accumulator
+  bool sorted = true;
+};
+
+namespace spgemm_detail {
+
+// Dense accumulators up to this size are always taken: a stamp check beats
+// probing a table even when the stamps miss the cache
+constexpr size_t DENSE_MAX_BYTES = size_t{32} << 20;
+// Wider B takes it when the work of a row is at least line_size / ratio
+constexpr size_t DENSE_MIN_WORK_RATIO = 16;
+// Rows are split into this many chunks of about equal work per thread, so
+// threads finishing early because of a wrong estimate take the rest of it
+constexpr size_t CHUNKS_PER_THREAD = 4;
+
+// Stamp per column of the row which touched it last, so the columns aren't
+// cleared between rows. Rows with work above the line size are counted by a
+// scan of the stamps rather than checking every entry. Base of the dense
+// accumulators, which keep values per column next to it
+template <class T, class Index>
+class DenseStamps {
+ public:
+  using View = sparse_detail::CompressedView<T, Index>;
+
+  explicit DenseStamps(Index line_size) : stamps(static_cast<size_t>(line_size), 0) {}
+
+  size_t count_row(const View& a, const View& b, Index row, size_t work) {
+    if (is_heavy(work)) {
+      auto current = stamp_row(a, b, row);
+      return static_cast<size_t>(std::count(stamps.begin(), stamps.end(), current));
+    }
+    auto current = next_stamp();
+    auto* row_stamps = stamps.data();
+    size_t count = 0;
+    for (auto k = a.ptr[row], end = a.ptr[row + 1]; k < end; k++) {
+      const auto* number = b.index + b.ptr[a.index[k]];
+      const auto* numbers_end = b.index + b.ptr[a.index[k] + 1];
+      for (; number != numbers_end; number++) {
+        if (row_stamps[*number] != current) {
+          row_stamps[*number] = current;
+          count++;
+        }
+      }
+    }
+    return count;
+  }
+
+ protected:
+  [[nodiscard]] bool is_heavy(size_t work) const { return work >= stamps.size(); }
+
+  // Stamp numbers of the row without checking them
+  uint32_t stamp_row(const View& a, const View& b, Index row) {
+    auto current = next_stamp();
+    auto* row_stamps = stamps.data();
+    for (auto k = a.ptr[row], end = a.ptr[row + 1]; k < end; k++) {
+      for (auto l = b.ptr[a.index[k]], line_end = b.ptr[a.index[k] + 1]; l < line_end; l++) {
+        row_stamps[b.index[l]] = current;
+      }
+    }
+    return current;
+  }
+
+  // Numbers of the row in index in order of their first entries, count of them
+  size_t collect_row(const View& a, const View& b, Index row, Index* index) {
+    auto current = next_stamp();
+    auto* row_stamps = stamps.data();
+    size_t count = 0;
+    for (auto k = a.ptr[row], end = a.ptr[row + 1]; k < end; k++) {
+      for (auto l = b.ptr[a.index[k]], line_end = b.ptr[a.index[k] + 1]; l < line_end; l++) {
+        auto number = b.index[l];
+        if (row_stamps[number] != current) {
+          row_stamps[number] = current;
+          index[count++] = number;
+        }
+      }
+    }
+    return count;
+  }
+
+  // Numbers in [begin, end) stamped by the last stamp_row in order
+  size_t list_stamped(Index* index, size_t begin, size_t end) const {
+    size_t count = 0;
+    for (size_t j = begin; j < end; j++) {
+      if (stamps[j] == stamp) index[count++] = static_cast<Index>(j);
+    }
+    return count;
+  }
+
+  uint32_t next_stamp() {
+    if (++stamp == 0) {
+      std::fill(stamps.begin(), stamps.end(), 0);
+      stamp = 1;
+    }
+    return stamp;
+  }
+
+  std::vector<uint32_t> stamps;
+  uint32_t stamp = 0;
+};
+
+// Value per column, kept zero outside of a row. Numbers of heavy rows are
+// found by a scan of the values, which also sorts them; only rows where some
+// entries cancelled out to zero repeat the stamping. Rows are processed
+// whole through raw pointers: stores of numbers may alias the arrays of A
+// and B otherwise
+template <class T, class Index>
+class DenseAccumulator : public DenseStamps<T, Index> {
+ public:
+  using View = sparse_detail::CompressedView<T, Index>;
+
+  explicit DenseAccumulator(Index line_size) : DenseStamps<T, Index>(line_size), values(this->stamps.size()) {}
+
+  // size is the count of the row. Numbers of light rows are written to index
+  // as they appear, so no list of them is kept
+  void compute_row(const View& a, const View& b, Index row, size_t work, size_t size, Index* index, T* out,
+                   bool sorted) {
+    auto* row_values = values.data();
+    size_t count = 0;
+    if (this->is_heavy(work)) {
+      for (auto k = a.ptr[row], end = a.ptr[row + 1]; k < end; k++) {
+        const auto scale = a.values[k];
+        for (auto l = b.ptr[a.index[k]], line_end = b.ptr[a.index[k] + 1]; l < line_end; l++) {
+          row_values[b.index[l]] += scale * b.values[l];
+        }
+      }
+      for (size_t j = 0; j < values.size(); j++) {
+        if (row_values[j] != T{}) index[count++] = static_cast<Index>(j);
+      }
+      if (count < size) {
+        this->stamp_row(a, b, row);
+        count = this->list_stamped(index, 0, values.size());
+      }
+    } else {
+      auto current = this->next_stamp();
+      auto* row_stamps = this->stamps.data();
+      for (auto k = a.ptr[row], end = a.ptr[row + 1]; k < end; k++) {
+        const auto scale = a.values[k];
+        for (auto l = b.ptr[a.index[k]], line_end = b.ptr[a.index[k] + 1]; l < line_end; l++) {
+          auto number = b.index[l];
+          if (row_stamps[number] != current) {
+            row_stamps[number] = current;
+            index[count++] = number;
+          }
+          row_values[number] += scale * b.values[l];
+        }
+      }
+      if (sorted) std::sort(index, index + count);
+    }
+    for (size_t k = 0; k < count; k++) {
+      out[k] = row_values[index[k]];
+      row_values[index[k]] = T{};
+    }
+  }
+
+ private:
+  std::vector<T> values;
+};
+
+// Linear probing table of at least twice as many slots as the row may have
+// numbers. Only the used slots are cleared after a row
+template <class T, class Index>
+class HashAccumulator {
+ public:
+  using View = sparse_detail::CompressedView<T, Index>;
+
+  explicit HashAccumulator(Index line_size_) : line_size(static_cast<size_t>(line_size_)) {}
+
+  size_t count_row(const View& a, const View& b, Index row, size_t work) {
+    begin_row(work);
+    for (auto k = a.ptr[row], end = a.ptr[row + 1]; k < end; k++) {
+      const auto* number = b.index + b.ptr[a.index[k]];
+      const auto* numbers_end = b.index + b.ptr[a.index[k] + 1];
+      for (; number != numbers_end; number++) find(*number);
+    }
+    return used.size();
+  }
+
+  void compute_row(const View& a, const View& b, Index row, size_t work, size_t /*size*/, Index* index, T* out,
+                   bool sorted) {
+    begin_row(work);
+    auto* row_values = values.data();
+    for (auto k = a.ptr[row], end = a.ptr[row + 1]; k < end; k++) {
+      const auto scale = a.values[k];
+      for (auto l = b.ptr[a.index[k]], line_end = b.ptr[a.index[k] + 1]; l < line_end; l++) {
+        auto [slot, inserted] = find(b.index[l]);
+        if (inserted) {
+          row_values[slot] = scale * b.values[l];
+        } else {
+          row_values[slot] += scale * b.values[l];
+        }
+      }
+    }
+    if (sorted) std::sort(used.begin(), used.end(), [this](size_t x, size_t y) { return keys[x] < keys[y]; });
+    for (size_t k = 0; k < used.size(); k++) {
+      index[k] = keys[used[k]];
+      out[k] = row_values[used[k]];
+    }
+  }
+
+ private:
+  static constexpr Index EMPTY = std::numeric_limits<Index>::max();
+
+  void begin_row(size_t work) {
+    auto capacity = std::bit_ceil(2 * std::max<size_t>(std::min(work, line_size), 1));
+    if (capacity > keys.size()) {
+      keys.assign(capacity, EMPTY);
+      values.resize(capacity);
+    }
+    mask = std::min(capacity, keys.size()) - 1;
+    for (auto slot : used) keys[slot] = EMPTY;
+    used.clear();
+  }
+
+  std::pair<size_t, bool> find(Index number) {
+    auto slot = (static_cast<size_t>(number) * 0x9E3779B97F4A7C15ULL >> 32) & mask;
+    while (keys[slot] != number) {
+      if (keys[slot] == EMPTY) {
+        keys[slot] = number;
+        used.push_back(slot);
+        return {slot, true};
+      }
+      slot = (slot + 1) & mask;
+    }
+    return {slot, false};
+  }
+
+  size_t line_size;
+  size_t mask = 0;
+  std::vector<Index> keys;
+  std::vector<T> values;
+  std::vector<size_t> used;
+};
+
+// Accumulators are reused by the chunks run one after another on a thread,
+// so there are at most as many of them as chunks run at once
+template <class Accumulator>
+class AccumulatorPool {
+ public:
+  template <class Factory>
+  std::unique_ptr<Accumulator> acquire(const Factory& factory) {
+    {
+      std::lock_guard lock(mutex);
+      if (!free.empty()) {
+        auto accumulator = std::move(free.back());
+        free.pop_back();
+        return accumulator;
+      }
+    }
+    return factory();
+  }
+
+  void release(std::unique_ptr<Accumulator> accumulator) {
+    std::lock_guard lock(mutex);
+    free.push_back(std::move(accumulator));
+  }
+
+ private:
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Accumulator>> free;
+};
+
+template <class T, class Index>
+size_t get_row_work(const sparse_detail::CompressedView<T, Index>& a, const sparse_detail::CompressedView<T, Index>& b,
+                    Index row) {
+  size_t work = 0;
+  for (auto k = a.ptr[row]; k < a.ptr[row + 1]; k++) {
+    work += static_cast<size_t>(b.ptr[a.index[k] + 1] - b.ptr[a.index[k]]);
+  }
+  return work;
+}
+
+// Work (multiply-adds) of rows of A * B and bounds of chunks of rows for
+// the backend. Finding the work costs about nnz of A and is split by rows.
+// Chunks are split by work plus a row overhead, so a few heavy rows of a
+// skewed matrix don't leave one thread with most of it
+struct RowChunks {
+  std::vector<size_t> work;
+  std::vector<size_t> bounds;
+
+  [[nodiscard]] size_t get_num_chunks() const { return bounds.size() - 1; }
+};
+
+template <class T, class Index, class Backend>
+RowChunks split_rows(const sparse_detail::CompressedView<T, Index>& a,
+                     const sparse_detail::CompressedView<T, Index>& b, const Backend& backend) {
+  auto num_rows = static_cast<size_t>(a.num_lines);
+  auto num_chunks = std::min(num_rows, std::max<size_t>(1, backend.get_num_threads()) * CHUNKS_PER_THREAD);
+  RowChunks chunks;
+  chunks.work.resize(num_rows);
+  backend.for_each(num_chunks, [&](size_t chunk) {
+    for (auto i = chunk * num_rows / num_chunks; i < (chunk + 1) * num_rows / num_chunks; i++) {
+      chunks.work[i] = get_row_work(a, b, static_cast<Index>(i));
+    }
+  });
+  std::vector<size_t> cost_prefix(num_rows + 1, 0);
+  for (size_t i = 0; i < num_rows; i++) cost_prefix[i + 1] = cost_prefix[i] + chunks.work[i] + 1;
+  chunks.bounds = split_by_cost(num_rows, num_chunks, [&](size_t i) { return cost_prefix[i]; });
+  return chunks;
+}
+
+// Turns counts of lines in ptr[i + 1] into offsets, returns nnz
+template <class Index>
+size_t set_offsets(std::vector<Index>& ptr) {
+  size_t nnz = 0;
+  for (size_t i = 1; i < ptr.size(); i++) {
+    nnz += static_cast<size_t>(ptr[i]);
+    ptr[i] = sparse_detail::check_nnz<Index>(nnz);
+  }
+  return nnz;
+}
+
+// Gustavson's product of compressed views, lines of C are lines of A:
+// C[i] = sum over k in A[i] of A[i][k] * B[k]. The symbolic phase counts
+// numbers of every line, so index and values of C are allocated once at their
+// exact size and the numeric phase writes lines in place
+template <class T, class Index, SparseLayout Layout, class Backend>
+void multiply(const sparse_detail::CompressedView<T, Index>& a, const sparse_detail::CompressedView<T, Index>& b,
+              SparseMatrix<T, Index, Layout>& c, const Backend& backend, const SpgemmAttr& attr) {
+  auto num_rows = static_cast<size_t>(a.num_lines);
+  auto line_size = static_cast<size_t>(b.line_size);
+  c.ptr.assign(num_rows + 1, 0);
+  if (num_rows == 0) {
+    c.index.clear();
+    c.values.clear();
+    return;
+  }
+  auto chunks = split_rows(a, b, backend);
+  const auto& work = chunks.work;
+  auto chunk_begin = [&](size_t chunk) { return static_cast<Index>(chunks.bounds[chunk]); };
+
+  // the heaviest row per chunk picks its accumulator
+  std::vector<size_t> max_work(chunks.get_num_chunks());
+  for (size_t chunk = 0; chunk < max_work.size(); chunk++) {
+    for (auto i = chunks.bounds[chunk]; i < chunks.bounds[chunk + 1]; i++) {
+      max_work[chunk] = std::max(max_work[chunk], work[i]);
+    }
+  }
+  auto use_dense = [&](size_t chunk) {
+    if (attr.accumulator != SpgemmAttr::AUTO) return attr.accumulator == SpgemmAttr::DENSE;
+    return line_size * (sizeof(T) + sizeof(uint32_t)) <= DENSE_MAX_BYTES ||
+           max_work[chunk] * DENSE_MIN_WORK_RATIO >= line_size;
+  };
+
+  AccumulatorPool<DenseAccumulator<T, Index>> dense_pool;
+  AccumulatorPool<HashAccumulator<T, Index>> hash_pool;
+  auto run_chunks = [&](const auto& body) {
+    backend.for_each(chunks.get_num_chunks(), [&](size_t chunk) {
+      auto run = [&](auto& pool, const auto& factory) {
+        auto accumulator = pool.acquire(factory);
+        for (auto i = chunk_begin(chunk); i < chunk_begin(chunk + 1); i++) body(*accumulator, i);
+        pool.release(std::move(accumulator));
+      };
+      if (use_dense(chunk)) {
+        run(dense_pool, [&] { return std::make_unique<DenseAccumulator<T, Index>>(b.line_size); });
+      } else {
+        run(hash_pool, [&] { return std::make_unique<HashAccumulator<T, Index>>(b.line_size); });
+      }
+    });
+  };
+
+  run_chunks([&](auto& accumulator, Index i) {
+    c.ptr[i + 1] = static_cast<Index>(accumulator.count_row(a, b, i, work[i]));
+  });
+
+  auto nnz = set_offsets(c.ptr);
+  c.index.resize(nnz);
+  c.values.resize(nnz);
+
+  run_chunks([&](auto& accumulator, Index i) {
+    auto size = static_cast<size_t>(c.ptr[i + 1] - c.ptr[i]);
+    accumulator.compute_row(a, b, i, work[i], size, c.index.data() + c.ptr[i], c.values.data() + c.ptr[i],
+                            attr.sorted);
+  });
+}
+
+}  // namespace spgemm_detail
+
+// C = A * B by lines of the layout. CRS runs Gustavson's product over rows
+// of A; CCS of C is CRS of C^T = B^T * A^T, and CCS of A and B are CRS of
+// A^T and B^T, so the same kernel runs over columns of B and nothing is
+// transposed. Numbers of a line of C that only cancel out stay in it as
+// zeros. Throws std::invalid_argument if the sizes don't match and
+// std::overflow_error if nnz of C doesn't fit Index
+template <class T, class Index, SparseLayout Layout, class Backend = StlSortBackend>
+SparseMatrix<T, Index, Layout> spgemm(const SparseView<T, Index, Layout>& a, const SparseView<T, Index, Layout>& b,
+                                      const Backend& backend = {}, const SpgemmAttr& attr = {}) {
+  if (a.cols != b.rows) {
+    throw std::invalid_argument("Can't multiply " + std::to_string(a.rows) + "x" + std::to_string(a.cols) + " by " +
+                                std::to_string(b.rows) + "x" + std::to_string(b.cols) + " sparse matrix");
+  }
+  SparseMatrix<T, Index, Layout> c(a.rows, b.cols);
+  if constexpr (Layout == SparseLayout::CRS) {
+    spgemm_detail::multiply(sparse_detail::make_view(a), sparse_detail::make_view(b), c, backend, attr);
+  } else {
+    spgemm_detail::multiply(sparse_detail::make_view(b), sparse_detail::make_view(a), c, backend, attr);
+  }
+  return c;
+}
+
+template <class T, class Index, SparseLayout Layout, class Backend = StlSortBackend>
+SparseMatrix<T, Index, Layout> spgemm(const SparseMatrix<T, Index, Layout>& a, const SparseMatrix<T, Index, Layout>& b,
+                                      const Backend& backend = {}, const SpgemmAttr& attr = {}) {
+  return spgemm(a.get_view(), b.get_view(), backend, attr);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SPARSE_INCLUDE_SPGEMM_HPP_
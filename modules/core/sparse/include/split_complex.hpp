@@ -0,0 +1,270 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SPARSE_INCLUDE_SPLIT_COMPLEX_HPP_
+#define MODULES_CORE_SPARSE_INCLUDE_SPLIT_COMPLEX_HPP_
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
+#include "core/sparse/include/spgemm.hpp"
+
+namespace ppc::core {
+
+// Complex sparse matrix with real and imaginary parts of the values in
+// separate arrays, so kernels load a vector of either part without
+// shuffling pairs. Lines, ptr and index are the same as in SparseMatrix
+template <class Real, class Index = int32_t, SparseLayout Layout = SparseLayout::CRS>
+struct SplitComplexMatrix {
+  static_assert(std::is_floating_point_v<Real>, "Parts of a split complex matrix must be floating point");
+  static_assert(std::is_integral_v<Index>, "Index of a sparse matrix must be an integer");
+
+  using value_type = std::complex<Real>;
+  using real_type = Real;
+  using index_type = Index;
+  static constexpr SparseLayout LAYOUT = Layout;
+
+  Index rows = 0;
+  Index cols = 0;
+  std::vector<Index> ptr;
+  std::vector<Index> index;
+  std::vector<Real> real;
+  std::vector<Real> imag;
+
+  SplitComplexMatrix() : ptr(1) {}
+  SplitComplexMatrix(Index rows_, Index cols_)
+      : rows(rows_), cols(cols_), ptr(static_cast<size_t>(get_num_lines()) + 1) {}
+
+  [[nodiscard]] Index get_num_lines() const { return Layout == SparseLayout::CRS ? rows : cols; }
+  [[nodiscard]] Index get_line_size() const { return Layout == SparseLayout::CRS ? cols : rows; }
+  [[nodiscard]] size_t get_nnz() const { return real.size(); }
+  [[nodiscard]] value_type get_value(size_t k) const { return {real[k], imag[k]}; }
+
+  bool operator==(const SplitComplexMatrix& other) const = default;
+};
+
+template <class Real, class Index = int32_t>
+using SplitCrsMatrix = SplitComplexMatrix<Real, Index, SparseLayout::CRS>;
+template <class Real, class Index = int32_t>
+using SplitCcsMatrix = SplitComplexMatrix<Real, Index, SparseLayout::CCS>;
+
+namespace spgemm_detail {
+
+// Adds row of A times B to the accumulator parts by the vector kernel of
+// the SIMD level, false if there is none. Values of the views are real
+// parts. Numbers of a line of B must be unique, lanes scatter them at once
+bool accumulate_complex_simd(const sparse_detail::CompressedView<double, int32_t>& a, const double* a_imag,
+                             const sparse_detail::CompressedView<double, int32_t>& b, const double* b_imag,
+                             int32_t row, double* acc_real, double* acc_imag);
+
+// Rows whose numbers span at most this many times their work are
+// accumulated without stamps and their numbers are found by a scan of the
+// span, which also sorts them. It is most rows of banded and mesh matrices
+constexpr size_t SPLIT_WINDOW_RATIO = 2;
+
+// Dense accumulator of both parts. Rows spanning many columns are stamped
+// first to list their numbers, then accumulated without checks, which the
+// vector kernel runs in lanes of entries of B
+template <class Real, class Index>
+class SplitComplexAccumulator : public DenseStamps<Real, Index> {
+ public:
+  using View = sparse_detail::CompressedView<Real, Index>;
+
+  explicit SplitComplexAccumulator(Index line_size)
+      : DenseStamps<Real, Index>(line_size), real(this->stamps.size()), imag(this->stamps.size()) {}
+
+  // Count of numbers of the row and the range [first, last] of them
+  size_t count_row(const View& a, const View& b, Index row, Index& first, Index& last) {
+    auto current = this->next_stamp();
+    auto* row_stamps = this->stamps.data();
+    size_t count = 0;
+    first = static_cast<Index>(this->stamps.size());
+    last = 0;
+    for (auto k = a.ptr[row], end = a.ptr[row + 1]; k < end; k++) {
+      const auto* number = b.index + b.ptr[a.index[k]];
+      const auto* numbers_end = b.index + b.ptr[a.index[k] + 1];
+      for (; number != numbers_end; number++) {
+        first = std::min(first, *number);
+        last = std::max(last, *number);
+        if (row_stamps[*number] != current) {
+          row_stamps[*number] = current;
+          count++;
+        }
+      }
+    }
+    return count;
+  }
+
+  // first, last and size are from count_row
+  void compute_row(const View& a, const Real* a_imag, const View& b, const Real* b_imag, Index row, size_t work,
+                   Index first, Index last, size_t size, Index* index, Real* out_real, Real* out_imag, bool sorted) {
+    if (size == 0) return;
+    size_t count = 0;
+    auto begin = static_cast<size_t>(first);
+    auto end = static_cast<size_t>(last) + 1;
+    if (end - begin <= work * SPLIT_WINDOW_RATIO) {
+      accumulate(a, a_imag, b, b_imag, row);
+      for (auto j = begin; j < end; j++) {
+        if (real[j] != Real{} || imag[j] != Real{}) index[count++] = static_cast<Index>(j);
+      }
+      if (count < size) {
+        this->stamp_row(a, b, row);
+        count = this->list_stamped(index, begin, end);
+      }
+    } else {
+      count = this->collect_row(a, b, row, index);
+      accumulate(a, a_imag, b, b_imag, row);
+      if (sorted) std::sort(index, index + count);
+    }
+    for (size_t k = 0; k < count; k++) {
+      out_real[k] = real[index[k]];
+      out_imag[k] = imag[index[k]];
+      real[index[k]] = Real{};
+      imag[index[k]] = Real{};
+    }
+  }
+
+ private:
+  void accumulate(const View& a, const Real* a_imag, const View& b, const Real* b_imag, Index row) {
+    if constexpr (std::is_same_v<Real, double> && std::is_same_v<Index, int32_t>) {
+      if (accumulate_complex_simd(a, a_imag, b, b_imag, row, real.data(), imag.data())) return;
+    }
+    auto* row_real = real.data();
+    auto* row_imag = imag.data();
+    for (auto k = a.ptr[row], end = a.ptr[row + 1]; k < end; k++) {
+      const auto scale_real = a.values[k];
+      const auto scale_imag = a_imag[k];
+      for (auto l = b.ptr[a.index[k]], line_end = b.ptr[a.index[k] + 1]; l < line_end; l++) {
+        auto number = b.index[l];
+        row_real[number] += scale_real * b.values[l] - scale_imag * b_imag[l];
+        row_imag[number] += scale_real * b_imag[l] + scale_imag * b.values[l];
+      }
+    }
+  }
+
+  std::vector<Real> real;
+  std::vector<Real> imag;
+};
+
+// Same phases as multiply, always with the dense accumulator: the parts are
+// line_size * 2 * sizeof(Real), and hashing would take the scatters away
+template <class Real, class Index, SparseLayout Layout, class Backend>
+void multiply_split(const SplitComplexMatrix<Real, Index, Layout>& a, const SplitComplexMatrix<Real, Index, Layout>& b,
+                    SplitComplexMatrix<Real, Index, Layout>& c, const Backend& backend, const SpgemmAttr& attr) {
+  using View = sparse_detail::CompressedView<Real, Index>;
+  View a_view{a.get_num_lines(), a.get_line_size(), a.ptr.data(), a.index.data(), a.real.data()};
+  View b_view{b.get_num_lines(), b.get_line_size(), b.ptr.data(), b.index.data(), b.real.data()};
+  auto num_rows = static_cast<size_t>(a_view.num_lines);
+  c.ptr.assign(num_rows + 1, 0);
+  c.index.clear();
+  c.real.clear();
+  c.imag.clear();
+  if (num_rows == 0) return;
+  auto chunks = split_rows(a_view, b_view, backend);
+
+  AccumulatorPool<SplitComplexAccumulator<Real, Index>> pool;
+  auto run_chunks = [&](const auto& body) {
+    backend.for_each(chunks.get_num_chunks(), [&](size_t chunk) {
+      auto accumulator = pool.acquire(
+          [&] { return std::make_unique<SplitComplexAccumulator<Real, Index>>(b_view.line_size); });
+      for (auto i = chunks.bounds[chunk]; i < chunks.bounds[chunk + 1]; i++) body(*accumulator, static_cast<Index>(i));
+      pool.release(std::move(accumulator));
+    });
+  };
+
+  std::vector<Index> first(num_rows);
+  std::vector<Index> last(num_rows);
+  run_chunks([&](auto& accumulator, Index i) {
+    c.ptr[i + 1] = static_cast<Index>(accumulator.count_row(a_view, b_view, i, first[i], last[i]));
+  });
+
+  auto nnz = set_offsets(c.ptr);
+  c.index.resize(nnz);
+  c.real.resize(nnz);
+  c.imag.resize(nnz);
+
+  run_chunks([&](auto& accumulator, Index i) {
+    auto offset = c.ptr[i];
+    auto size = static_cast<size_t>(c.ptr[i + 1] - offset);
+    accumulator.compute_row(a_view, a.imag.data(), b_view, b.imag.data(), i, chunks.work[i], first[i], last[i], size,
+                            c.index.data() + offset, c.real.data() + offset, c.imag.data() + offset, attr.sorted);
+  });
+}
+
+}  // namespace spgemm_detail
+
+template <class Real, class Index, SparseLayout Layout>
+SplitComplexMatrix<Real, Index, Layout> to_split_complex(const SparseView<std::complex<Real>, Index, Layout>& matrix) {
+  SplitComplexMatrix<Real, Index, Layout> split(matrix.rows, matrix.cols);
+  split.ptr.assign(matrix.ptr.begin(), matrix.ptr.end());
+  split.index.assign(matrix.index.begin(), matrix.index.end());
+  split.real.resize(matrix.get_nnz());
+  split.imag.resize(matrix.get_nnz());
+  for (size_t k = 0; k < matrix.get_nnz(); k++) {
+    split.real[k] = matrix.values[k].real();
+    split.imag[k] = matrix.values[k].imag();
+  }
+  return split;
+}
+
+template <class Real, class Index, SparseLayout Layout>
+SplitComplexMatrix<Real, Index, Layout> to_split_complex(
+    const SparseMatrix<std::complex<Real>, Index, Layout>& matrix) {
+  return to_split_complex(matrix.get_view());
+}
+
+template <class Real, class Index, SparseLayout Layout>
+SparseMatrix<std::complex<Real>, Index, Layout> to_interleaved(const SplitComplexMatrix<Real, Index, Layout>& matrix) {
+  SparseMatrix<std::complex<Real>, Index, Layout> interleaved(matrix.rows, matrix.cols);
+  interleaved.ptr = matrix.ptr;
+  interleaved.index = matrix.index;
+  interleaved.values.resize(matrix.get_nnz());
+  for (size_t k = 0; k < matrix.get_nnz(); k++) interleaved.values[k] = matrix.get_value(k);
+  return interleaved;
+}
+
+// Throws std::invalid_argument like validate of SparseMatrix, or if the parts
+// differ in size
+template <class Real, class Index, SparseLayout Layout>
+void validate(const SplitComplexMatrix<Real, Index, Layout>& matrix, bool check_sorted = true) {
+  if (matrix.real.size() != matrix.imag.size()) {
+    throw std::invalid_argument("Invalid sparse matrix: real and imaginary parts differ in size");
+  }
+  validate(SparseView<Real, Index, Layout>{matrix.rows, matrix.cols, matrix.ptr, matrix.index, matrix.real},
+           check_sorted);
+}
+
+// C = A * B of split complex matrices, same as spgemm of SparseMatrix except
+// that the accumulator of attr is ignored (see multiply_split). The numeric
+// phase of double values with int32_t indices runs the complex
+// multiply-adds in AVX-512 vectors of entries of B, so numbers
+// within lines of B must be unique, as they are in a validated matrix
+template <class Real, class Index, SparseLayout Layout, class Backend = StlSortBackend>
+SplitComplexMatrix<Real, Index, Layout> spgemm(const SplitComplexMatrix<Real, Index, Layout>& a,
+                                               const SplitComplexMatrix<Real, Index, Layout>& b,
+                                               const Backend& backend = {}, const SpgemmAttr& attr = {}) {
+  if (a.cols != b.rows) {
+    throw std::invalid_argument("Can't multiply " + std::to_string(a.rows) + "x" + std::to_string(a.cols) + " by " +
+                                std::to_string(b.rows) + "x" + std::to_string(b.cols) + " sparse matrix");
+  }
+  SplitComplexMatrix<Real, Index, Layout> c(a.rows, b.cols);
+  if constexpr (Layout == SparseLayout::CRS) {
+    spgemm_detail::multiply_split(a, b, c, backend, attr);
+  } else {
+    spgemm_detail::multiply_split(b, a, c, backend, attr);
+  }
+  return c;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SPARSE_INCLUDE_SPLIT_COMPLEX_HPP_
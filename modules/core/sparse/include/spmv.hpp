@@ -0,0 +1,288 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SPARSE_INCLUDE_SPMV_HPP_
+#define MODULES_CORE_SPARSE_INCLUDE_SPMV_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
+
+namespace ppc::core {
+
+// Rows of a slice of SellMatrix by default: a register of AVX-512 doubles,
+// two of AVX2
+constexpr size_t SELL_SLICE_HEIGHT = 8;
+// Rows sorted by length together by default
+constexpr size_t SELL_SORT_SCOPE = 256;
+
+// Sliced ELLPACK with sorting scope (SELL-C-sigma). Rows are sorted by
+// length in descending order within windows of sort_scope rows, then every
+// slice_height (C) consecutive rows form a slice. A slice is stored
+// column-major and padded to its width: entry j of row r of slice s is at
+// slice_ptr[s] + j * C + r % C of index and values, so the entries of a
+// slice column are contiguous and a vector register takes C rows at once.
+// Sorting keeps rows of similar length together, so little is padded.
+// Padding has value zero and column zero but isn't read by the kernels.
+// The width of a slice is the longest length that doesn't pad more entries
+// than it stores; entries of longer rows beyond it (a few rows of power-law
+// matrices, which would pad their slice many times over) are kept by rows in
+// the overflow arrays, like in the ELL + COO hybrid format
+template <class T, class Index = int32_t>
+struct SellMatrix {
+  using value_type = T;
+  using index_type = Index;
+
+  Index rows = 0;
+  Index cols = 0;
+  size_t slice_height = SELL_SLICE_HEIGHT;
+  size_t sort_scope = SELL_SORT_SCOPE;
+  // num_slices + 1 offsets of slices in index and values
+  std::vector<Index> slice_ptr;
+  // entries of every stored row in its slice, zero for rows padding the
+  // last slice
+  std::vector<Index> lengths;
+  // row of the matrix stored at every position
+  std::vector<Index> row_order;
+  std::vector<Index> index;
+  std::vector<T> values;
+  // overflow entries of row overflow_rows[i] are [overflow_ptr[i],
+  // overflow_ptr[i + 1]) of overflow_index and overflow_values
+  std::vector<Index> overflow_rows;
+  std::vector<Index> overflow_ptr = {0};
+  std::vector<Index> overflow_index;
+  std::vector<T> overflow_values;
+  size_t nnz = 0;
+
+  [[nodiscard]] size_t get_num_slices() const { return slice_ptr.size() - 1; }
+  [[nodiscard]] size_t get_nnz() const { return nnz; }
+  // Entries stored in slices including padding, and out of them
+  [[nodiscard]] size_t get_padded_nnz() const { return values.size(); }
+  [[nodiscard]] size_t get_overflow_nnz() const { return overflow_values.size(); }
+};
+
+namespace spmv_detail {
+
+// Products of matrices below this many nonzeros plus rows per part aren't
+// split further
+constexpr size_t MIN_PART_COST = size_t{1} << 14;
+// Parts are balanced by cost, a few per thread let dynamic schedules even
+// out the rest
+constexpr size_t PARTS_PER_THREAD = 4;
+
+template <class Backend>
+size_t get_num_parts(size_t num_lines, size_t cost, const Backend& backend) {
+  auto max_parts = std::max<size_t>(1, backend.get_num_threads()) * PARTS_PER_THREAD;
+  return std::clamp<size_t>(cost / MIN_PART_COST, 1, std::min(max_parts, std::max<size_t>(1, num_lines)));
+}
+
+inline void check_sizes(size_t rows, size_t cols, size_t x_size, size_t y_size) {
+  if (x_size != cols || y_size != rows) {
+    throw std::invalid_argument("Can't multiply " + std::to_string(rows) + "x" + std::to_string(cols) +
+                                " sparse matrix by vector of " + std::to_string(x_size) + " into vector of " +
+                                std::to_string(y_size));
+  }
+}
+
+// Slices [first, last) of y = A x by gather kernels of the current SIMD
+// level. Returns false if there are none for the level and the slice height,
+// then the caller runs the scalar loop
+bool sell_spmv_simd(const SellMatrix<double, int32_t>& a, size_t first, size_t last, const double* x, double* y);
+
+template <class T, class Index>
+void sell_spmv_scalar(const SellMatrix<T, Index>& a, size_t first, size_t last, const T* x, T* y) {
+  const auto height = a.slice_height;
+  for (size_t slice = first; slice < last; slice++) {
+    auto row_begin = slice * height;
+    auto row_end = std::min(row_begin + height, static_cast<size_t>(a.rows));
+    const auto* index = a.index.data() + a.slice_ptr[slice];
+    const auto* values = a.values.data() + a.slice_ptr[slice];
+    for (auto r = row_begin; r < row_end; r++) {
+      auto lane = r - row_begin;
+      T sum{};
+      for (size_t j = 0; j < static_cast<size_t>(a.lengths[r]); j++) {
+        sum += values[j * height + lane] * x[index[j * height + lane]];
+      }
+      y[a.row_order[r]] = sum;
+    }
+  }
+}
+
+}  // namespace spmv_detail
+
+// y = A x over rows of A. Rows are split into parts of about equal nonzeros
+// plus rows, not equal row counts, so a few heavy rows don't leave other
+// threads idle. Throws std::invalid_argument if the sizes don't match
+template <class T, class Index, class Backend = StlSortBackend>
+void spmv(const CrsView<T, Index>& a, std::type_identity_t<std::span<const T>> x,
+          std::type_identity_t<std::span<T>> y, const Backend& backend = {}) {
+  spmv_detail::check_sizes(static_cast<size_t>(a.rows), static_cast<size_t>(a.cols), x.size(), y.size());
+  auto num_rows = static_cast<size_t>(a.rows);
+  const auto* ptr = a.ptr.data();
+  const auto* index = a.index.data();
+  const auto* values = a.values.data();
+  auto cost_prefix = [ptr](size_t i) { return static_cast<size_t>(ptr[i]) + i; };
+  auto num_parts = spmv_detail::get_num_parts(num_rows, cost_prefix(num_rows), backend);
+  auto bounds = split_by_cost(num_rows, num_parts, cost_prefix);
+  backend.for_each(num_parts, [&](size_t part) {
+    for (auto i = bounds[part]; i < bounds[part + 1]; i++) {
+      T sum{};
+      for (auto k = ptr[i]; k < ptr[i + 1]; k++) sum += values[k] * x[index[k]];
+      y[i] = sum;
+    }
+  });
+}
+
+template <class T, class Index, class Backend = StlSortBackend>
+void spmv(const CrsMatrix<T, Index>& a, std::type_identity_t<std::span<const T>> x,
+          std::type_identity_t<std::span<T>> y, const Backend& backend = {}) {
+  spmv(a.get_view(), x, y, backend);
+}
+
+// SELL-C-sigma form of a CRS matrix. Throws std::invalid_argument unless
+// slice_height is positive and sort_scope is a multiple of it (1 keeps the
+// order of rows), std::overflow_error if the padded entries don't fit Index
+template <class T, class Index>
+SellMatrix<T, Index> to_sell(const CrsView<T, Index>& a, size_t slice_height = SELL_SLICE_HEIGHT,
+                             size_t sort_scope = SELL_SORT_SCOPE) {
+  if (slice_height == 0 || sort_scope == 0 || (sort_scope != 1 && sort_scope % slice_height != 0)) {
+    throw std::invalid_argument("Sort scope " + std::to_string(sort_scope) + " of SELL matrix isn't 1 or multiple of " +
+                                "slice height " + std::to_string(slice_height));
+  }
+  SellMatrix<T, Index> sell;
+  sell.rows = a.rows;
+  sell.cols = a.cols;
+  sell.slice_height = slice_height;
+  sell.sort_scope = sort_scope;
+  sell.nnz = a.get_nnz();
+  auto num_rows = static_cast<size_t>(a.rows);
+  auto num_slices = (num_rows + slice_height - 1) / slice_height;
+  auto row_length = [&a](Index row) { return a.ptr[row + 1] - a.ptr[row]; };
+
+  sell.row_order.resize(num_rows);
+  std::iota(sell.row_order.begin(), sell.row_order.end(), Index{0});
+  for (size_t begin = 0; begin < num_rows && sort_scope > 1; begin += sort_scope) {
+    auto end = std::min(begin + sort_scope, num_rows);
+    std::stable_sort(sell.row_order.begin() + begin, sell.row_order.begin() + end,
+                     [&](Index lhs, Index rhs) { return row_length(lhs) > row_length(rhs); });
+  }
+  sell.lengths.assign(num_slices * slice_height, 0);
+  for (size_t r = 0; r < num_rows; r++) sell.lengths[r] = row_length(sell.row_order[r]);
+
+  sell.slice_ptr.assign(num_slices + 1, 0);
+  std::vector<Index> slice_lengths(slice_height);
+  size_t padded = 0;
+  for (size_t slice = 0; slice < num_slices; slice++) {
+    auto* lengths = sell.lengths.data() + slice * slice_height;
+    std::copy(lengths, lengths + slice_height, slice_lengths.begin());
+    std::sort(slice_lengths.begin(), slice_lengths.end(), std::greater<>());
+    // candidates from the longest length down, the shortest one pads nothing
+    size_t width = 0;
+    for (auto candidate : slice_lengths) {
+      width = static_cast<size_t>(candidate);
+      size_t stored = 0;
+      for (auto length : slice_lengths) stored += std::min(width, static_cast<size_t>(length));
+      if (slice_height * width <= 2 * stored) break;
+    }
+    for (size_t r = 0; r < slice_height; r++) lengths[r] = std::min(lengths[r], static_cast<Index>(width));
+    padded += width * slice_height;
+    sell.slice_ptr[slice + 1] = sparse_detail::check_nnz<Index>(padded);
+  }
+  sell.index.assign(padded, 0);
+  sell.values.assign(padded, T{});
+  for (size_t r = 0; r < num_rows; r++) {
+    auto base = static_cast<size_t>(sell.slice_ptr[r / slice_height]) + r % slice_height;
+    auto row = sell.row_order[r];
+    auto overflow = a.ptr[row] + sell.lengths[r];
+    for (auto k = a.ptr[row]; k < overflow; k++) {
+      auto position = base + static_cast<size_t>(k - a.ptr[row]) * slice_height;
+      sell.index[position] = a.index[k];
+      sell.values[position] = a.values[k];
+    }
+    if (overflow == a.ptr[row + 1]) continue;
+    sell.overflow_rows.push_back(row);
+    sell.overflow_index.insert(sell.overflow_index.end(), a.index.begin() + overflow, a.index.begin() + a.ptr[row + 1]);
+    sell.overflow_values.insert(sell.overflow_values.end(), a.values.begin() + overflow,
+                                a.values.begin() + a.ptr[row + 1]);
+    sell.overflow_ptr.push_back(static_cast<Index>(sell.overflow_values.size()));
+  }
+  return sell;
+}
+
+template <class T, class Index>
+SellMatrix<T, Index> to_sell(const CrsMatrix<T, Index>& a, size_t slice_height = SELL_SLICE_HEIGHT,
+                             size_t sort_scope = SELL_SORT_SCOPE) {
+  return to_sell(a.get_view(), slice_height, sort_scope);
+}
+
+// y = A x over slices of A, split into parts of about equal stored entries.
+// Doubles with int32_t indices run gather kernels of the SIMD level of the
+// core (get_simd_level()) when the slice height is a multiple of the vector
+// width, others a scalar loop. Throws std::invalid_argument if the sizes
+// don't match
+template <class T, class Index, class Backend = StlSortBackend>
+void spmv(const SellMatrix<T, Index>& a, std::type_identity_t<std::span<const T>> x,
+          std::type_identity_t<std::span<T>> y, const Backend& backend = {}) {
+  spmv_detail::check_sizes(static_cast<size_t>(a.rows), static_cast<size_t>(a.cols), x.size(), y.size());
+  auto num_slices = a.get_num_slices();
+  auto cost_prefix = [&a](size_t slice) { return static_cast<size_t>(a.slice_ptr[slice]) + slice * a.slice_height; };
+  auto num_parts = spmv_detail::get_num_parts(num_slices, cost_prefix(num_slices), backend);
+  auto bounds = split_by_cost(num_slices, num_parts, cost_prefix);
+  backend.for_each(num_parts, [&](size_t part) {
+    if constexpr (std::is_same_v<T, double> && std::is_same_v<Index, int32_t>) {
+      if (spmv_detail::sell_spmv_simd(a, bounds[part], bounds[part + 1], x.data(), y.data())) return;
+    }
+    spmv_detail::sell_spmv_scalar(a, bounds[part], bounds[part + 1], x.data(), y.data());
+  });
+
+  // Overflow rows are added once their slices are done
+  auto num_overflow_rows = a.overflow_rows.size();
+  if (num_overflow_rows == 0) return;
+  auto overflow_prefix = [&a](size_t i) { return static_cast<size_t>(a.overflow_ptr[i]) + i; };
+  auto num_overflow_parts =
+      spmv_detail::get_num_parts(num_overflow_rows, overflow_prefix(num_overflow_rows), backend);
+  auto overflow_bounds = split_by_cost(num_overflow_rows, num_overflow_parts, overflow_prefix);
+  backend.for_each(num_overflow_parts, [&](size_t part) {
+    for (auto i = overflow_bounds[part]; i < overflow_bounds[part + 1]; i++) {
+      T sum{};
+      for (auto k = a.overflow_ptr[i]; k < a.overflow_ptr[i + 1]; k++) {
+        sum += a.overflow_values[k] * x[a.overflow_index[k]];
+      }
+      y[a.overflow_rows[i]] += sum;
+    }
+  });
+}
+
+// Least memory traffic of one product in bytes: every stored entry and
+// offset is read once, x once and y written once. Divided by the time of
+// spmv it gives the attained bandwidth
+template <class T, class Index>
+double get_spmv_bytes(const CrsView<T, Index>& a) {
+  return static_cast<double>(a.get_nnz() * (sizeof(T) + sizeof(Index)) +
+                             (static_cast<size_t>(a.rows) + 1) * sizeof(Index) +
+                             static_cast<size_t>(a.cols) * sizeof(T) + static_cast<size_t>(a.rows) * sizeof(T));
+}
+
+// SELL-C-sigma reads padding of slices as well, and offsets of slices,
+// lengths and order of rows and the overflow part instead of row offsets
+template <class T, class Index>
+double get_spmv_bytes(const SellMatrix<T, Index>& a) {
+  return static_cast<double>((a.get_padded_nnz() + a.get_overflow_nnz()) * (sizeof(T) + sizeof(Index)) +
+                             (a.slice_ptr.size() + a.lengths.size() + a.row_order.size() + a.overflow_rows.size() +
+                              a.overflow_ptr.size()) *
+                                 sizeof(Index) +
+                             static_cast<size_t>(a.cols) * sizeof(T) + static_cast<size_t>(a.rows) * sizeof(T));
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_SPARSE_INCLUDE_SPMV_HPP_
@@ -0,0 +1,216 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sparse/include/sparse_io.hpp"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+[[noreturn]] void throw_io_error(const std::string& what, const std::string& path) {
+  throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+std::string to_lower(std::string text) {
+  for (auto& c : text) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  return text;
+}
+
+uint64_t align_up(uint64_t offset) {
+  const auto alignment = ppc::core::sparse_io_detail::BinaryHeader::ALIGNMENT;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+ppc::core::MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (file == nullptr) throw_io_error("Can't open", path);
+  std::fseek(file, 0, SEEK_END);
+  buffer.resize(static_cast<size_t>(_ftelli64(file)));
+  std::fseek(file, 0, SEEK_SET);
+  auto done = std::fread(buffer.data(), 1, buffer.size(), file);
+  std::fclose(file);
+  if (done != buffer.size()) throw_io_error("Can't read", path);
+  begin = buffer.data();
+  length = buffer.size();
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw_io_error("Can't open", path);
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw_io_error("Can't stat", path);
+  }
+  length = static_cast<size_t>(info.st_size);
+  // an empty file can't be mapped
+  if (length > 0) {
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw_io_error("Can't map", path);
+    }
+    begin = static_cast<const char*>(address);
+    mapped = true;
+  }
+  ::close(fd);
+#endif
+}
+
+ppc::core::MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (mapped) ::munmap(const_cast<char*>(begin), length);
+#endif
+}
+
+ppc::core::MatrixMarketHeader ppc::core::parse_matrix_market_header(std::string_view text) {
+  auto next_line = [&text](size_t& position) {
+    auto end = std::min(text.find('\n', position), text.size());
+    auto line = text.substr(position, end - position);
+    position = std::min(end + 1, text.size());
+    return std::string(line);
+  };
+  size_t position = 0;
+  std::istringstream banner(next_line(position));
+  std::string tag;
+  std::string object;
+  std::string format;
+  std::string field;
+  std::string symmetry;
+  banner >> tag >> object >> format >> field >> symmetry;
+  if (to_lower(tag) != "%%matrixmarket" || to_lower(object) != "matrix") {
+    throw std::runtime_error("Not a Matrix Market matrix: the banner is missing");
+  }
+  if (to_lower(format) != "coordinate") {
+    throw std::runtime_error("Matrix Market format '" + format + "' isn't supported, only coordinate is");
+  }
+
+  MatrixMarketHeader header;
+  field = to_lower(field);
+  if (field == "real" || field == "double") {
+    header.field = MatrixMarketHeader::REAL;
+  } else if (field == "integer") {
+    header.field = MatrixMarketHeader::INTEGER;
+  } else if (field == "complex") {
+    header.field = MatrixMarketHeader::COMPLEX;
+  } else if (field == "pattern") {
+    header.field = MatrixMarketHeader::PATTERN;
+  } else {
+    throw std::runtime_error("Unknown Matrix Market field '" + field + "'");
+  }
+  symmetry = to_lower(symmetry);
+  if (symmetry == "general") {
+    header.symmetry = MatrixMarketHeader::GENERAL;
+  } else if (symmetry == "symmetric") {
+    header.symmetry = MatrixMarketHeader::SYMMETRIC;
+  } else if (symmetry == "skew-symmetric") {
+    header.symmetry = MatrixMarketHeader::SKEW_SYMMETRIC;
+  } else if (symmetry == "hermitian") {
+    header.symmetry = MatrixMarketHeader::HERMITIAN;
+  } else {
+    throw std::runtime_error("Unknown Matrix Market symmetry '" + symmetry + "'");
+  }
+  if (header.symmetry == MatrixMarketHeader::HERMITIAN && header.field != MatrixMarketHeader::COMPLEX) {
+    throw std::runtime_error("Hermitian Matrix Market matrix must be complex");
+  }
+
+  // The size line is the first one which isn't a comment or blank
+  std::string line;
+  while (position < text.size()) {
+    line = next_line(position);
+    auto first = line.find_first_not_of(" \t\r");
+    if (first != std::string::npos && line[first] != '%') break;
+    line.clear();
+  }
+  std::istringstream sizes(line);
+  std::string rest;
+  if (!(sizes >> header.rows >> header.cols >> header.nnz) || (sizes >> rest) || header.rows < 0 ||
+      header.cols < 0 || header.nnz < 0) {
+    throw std::runtime_error("Bad Matrix Market size line '" + line + "'");
+  }
+  if (header.symmetry != MatrixMarketHeader::GENERAL && header.rows != header.cols) {
+    throw std::runtime_error("Symmetric Matrix Market matrix must be square");
+  }
+  header.body_offset = position;
+  return header;
+}
+
+void ppc::core::sparse_io_detail::throw_parse_error(const std::string& what, std::string_view line) {
+  throw std::runtime_error(what + " '" + std::string(line.substr(0, 80)) + "'");
+}
+
+ppc::core::sparse_io_detail::BinaryHeader ppc::core::sparse_io_detail::make_binary_header(
+    uint32_t layout, uint32_t index_type, uint32_t value_type, size_t index_size, uint64_t rows, uint64_t cols,
+    uint64_t num_lines, uint64_t nnz) {
+  BinaryHeader header{};
+  std::memcpy(header.magic, BinaryHeader::MAGIC, sizeof(header.magic));
+  header.version = BinaryHeader::VERSION;
+  header.byte_order_mark = BinaryHeader::BYTE_ORDER_MARK;
+  header.layout = layout;
+  header.index_type = index_type;
+  header.value_type = value_type;
+  header.rows = rows;
+  header.cols = cols;
+  header.nnz = nnz;
+  header.ptr_offset = align_up(sizeof(BinaryHeader));
+  header.index_offset = align_up(header.ptr_offset + (num_lines + 1) * index_size);
+  header.values_offset = align_up(header.index_offset + nnz * index_size);
+  return header;
+}
+
+ppc::core::sparse_io_detail::BinaryHeader ppc::core::sparse_io_detail::check_binary_header(
+    const MappedFile& file, const std::string& path, uint32_t layout, uint32_t index_type, uint32_t value_type,
+    size_t index_size, size_t value_size) {
+  auto fail = [&path](const std::string& what) {
+    throw std::runtime_error("Can't map sparse matrix " + path + ": " + what);
+  };
+  BinaryHeader header{};
+  if (file.size() < sizeof(header)) fail("the file is too short");
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, BinaryHeader::MAGIC, sizeof(header.magic)) != 0) fail("not a binary sparse file");
+  if (header.version != BinaryHeader::VERSION) fail("version " + std::to_string(header.version));
+  if (header.byte_order_mark != BinaryHeader::BYTE_ORDER_MARK) fail("written with other byte order");
+  if (header.layout != layout) fail("layout differs");
+  if (header.index_type != index_type) fail("index type differs");
+  if (header.value_type != value_type) fail("value type differs");
+  auto num_lines = header.layout == static_cast<uint32_t>(SparseLayout::CRS) ? header.rows : header.cols;
+  // bounds the sizes before they are multiplied
+  if (num_lines >= file.size() || header.nnz > file.size()) fail("the file is truncated");
+  // the offsets are recomputed, so the arrays can't overlap or be misaligned
+  auto expected =
+      make_binary_header(layout, index_type, value_type, index_size, header.rows, header.cols, num_lines, header.nnz);
+  if (header.ptr_offset != expected.ptr_offset || header.index_offset != expected.index_offset ||
+      header.values_offset != expected.values_offset) {
+    fail("offsets of the arrays are wrong");
+  }
+  if (file.size() < header.values_offset + header.nnz * value_size) fail("the file is truncated");
+  return header;
+}
+
+void ppc::core::sparse_io_detail::write_binary(const std::string& path, const BinaryHeader& header,
+                                               std::span<const std::byte> ptr, std::span<const std::byte> index,
+                                               std::span<const std::byte> values) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) throw_io_error("Can't create", path);
+  uint64_t position = 0;
+  auto write_at = [&](const void* data, size_t bytes, uint64_t offset) {
+    static const char zeros[BinaryHeader::ALIGNMENT] = {};
+    out.write(zeros, static_cast<std::streamsize>(offset - position));
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    position = offset + bytes;
+  };
+  write_at(&header, sizeof(header), 0);
+  write_at(ptr.data(), ptr.size(), header.ptr_offset);
+  write_at(index.data(), index.size(), header.index_offset);
+  write_at(values.data(), values.size(), header.values_offset);
+  if (!out.flush()) throw_io_error("Can't write", path);
+}
@@ -0,0 +1,16 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sparse/include/split_complex.hpp"
+#include "core/sparse/src/spgemm_isa.hpp"
+#include "core/threads/include/simd.hpp"
+
+bool ppc::core::spgemm_detail::accumulate_complex_simd(const sparse_detail::CompressedView<double, int32_t>& a,
+                                                       const double* a_imag,
+                                                       const sparse_detail::CompressedView<double, int32_t>& b,
+                                                       const double* b_imag, int32_t row, double* acc_real,
+                                                       double* acc_imag) {
+  const auto* kernels = get_simd_level() >= SimdLevel::AVX512 ? get_avx512_spgemm_kernels() : nullptr;
+  if (kernels == nullptr) return false;
+  kernels->accumulate_complex_double({a.ptr, a.index, a.values, a_imag}, {b.ptr, b.index, b.values, b_imag}, row,
+                                     acc_real, acc_imag);
+  return true;
+}
@@ -0,0 +1,82 @@
+// Copyright 2024 Nesterov Alexander
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/sparse/src/spgemm_isa.hpp"
+
+#ifdef PPC_SPGEMM_X86
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+// Products and sums of the intrinsics would be fused like those of vector
+// extensions, which AVX-512 implies
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace {
+
+constexpr int32_t WIDTH = 8;
+
+// Every 8 entries of a line of B gather both parts of the accumulator at
+// their numbers, add the products with the scale from A and scatter them
+// back. The tail of the line is masked, its numbers are copied to a zeroed
+// buffer since masked 256-bit loads need AVX-512VL. Products aren't fused, so the
+// result is the same as of the scalar loop and of std::complex values
+void accumulate_complex_double(const ppc::core::spgemm_detail::SplitComplexArrays& a,
+                               const ppc::core::spgemm_detail::SplitComplexArrays& b, int32_t row, double* acc_real,
+                               double* acc_imag) {
+  for (auto k = a.ptr[row]; k < a.ptr[row + 1]; k++) {
+    const auto scale_real = _mm512_set1_pd(a.real[k]);
+    const auto scale_imag = _mm512_set1_pd(a.imag[k]);
+    const auto end = b.ptr[a.index[k] + 1];
+    for (auto l = b.ptr[a.index[k]]; l < end; l += WIDTH) {
+      auto mask = static_cast<__mmask8>(end - l >= WIDTH ? 0xFF : (1U << (end - l)) - 1);
+      __m256i indices;
+      if (end - l >= WIDTH) {
+        indices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b.index + l));
+      } else {
+        int32_t tail[WIDTH] = {};
+        std::copy(b.index + l, b.index + end, tail);
+        indices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail));
+      }
+      auto b_real = _mm512_maskz_loadu_pd(mask, b.real + l);
+      auto b_imag = _mm512_maskz_loadu_pd(mask, b.imag + l);
+      auto sum_real = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, indices, acc_real, sizeof(double));
+      auto sum_imag = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, indices, acc_imag, sizeof(double));
+      sum_real = _mm512_add_pd(sum_real, _mm512_sub_pd(_mm512_mul_pd(scale_real, b_real),
+                                                       _mm512_mul_pd(scale_imag, b_imag)));
+      sum_imag = _mm512_add_pd(sum_imag, _mm512_add_pd(_mm512_mul_pd(scale_real, b_imag),
+                                                       _mm512_mul_pd(scale_imag, b_real)));
+      _mm512_mask_i32scatter_pd(acc_real, mask, indices, sum_real, sizeof(double));
+      _mm512_mask_i32scatter_pd(acc_imag, mask, indices, sum_imag, sizeof(double));
+    }
+  }
+}
+
+const ppc::core::spgemm_detail::SpgemmKernelTable kernels = {&accumulate_complex_double};
+
+}  // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+const ppc::core::spgemm_detail::SpgemmKernelTable* ppc::core::spgemm_detail::get_avx512_spgemm_kernels() {
+  return &kernels;
+}
+
+#else
+
+const ppc::core::spgemm_detail::SpgemmKernelTable* ppc::core::spgemm_detail::get_avx512_spgemm_kernels() {
+  return nullptr;
+}
+
+#endif  // PPC_SPGEMM_X86
@@ -0,0 +1,39 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SPARSE_SRC_SPGEMM_ISA_HPP_
+#define MODULES_CORE_SPARSE_SRC_SPGEMM_ISA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PPC_SPGEMM_X86
+#endif
+
+namespace ppc::core::spgemm_detail {
+
+// Arrays of a split complex CRS view with double parts and int32_t indices,
+// so the kernels don't include the library headers in the region compiled
+// for their instruction set
+struct SplitComplexArrays {
+  const int32_t* ptr;
+  const int32_t* index;
+  const double* real;
+  const double* imag;
+};
+
+// Kernels of one instruction set
+struct SpgemmKernelTable {
+  // acc += A[row] * B, numbers within lines of B are unique
+  void (*accumulate_complex_double)(const SplitComplexArrays& a, const SplitComplexArrays& b, int32_t row,
+                                    double* acc_real, double* acc_imag);
+};
+
+// Defined in its own translation unit compiled for the instruction set,
+// nullptr when the target isn't x86. There is no AVX2 table: without
+// scatters its lanes store one by one and were slower than the scalar loop
+const SpgemmKernelTable* get_avx512_spgemm_kernels();
+
+}  // namespace ppc::core::spgemm_detail
+
+#endif  // MODULES_CORE_SPARSE_SRC_SPGEMM_ISA_HPP_
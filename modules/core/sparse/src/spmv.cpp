@@ -0,0 +1,20 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/sparse/include/spmv.hpp"
+
+#include "core/sparse/src/spmv_isa.hpp"
+#include "core/threads/include/simd.hpp"
+
+bool ppc::core::spmv_detail::sell_spmv_simd(const SellMatrix<double, int32_t>& a, size_t first, size_t last,
+                                            const double* x, double* y) {
+  auto level = get_simd_level();
+  // AVX-512 kernels take slices of 8 rows, for others AVX2 ones may still fit
+  for (const auto* kernels : {level >= SimdLevel::AVX512 ? get_avx512_spmv_kernels() : nullptr,
+                              level >= SimdLevel::AVX2 ? get_avx2_spmv_kernels() : nullptr}) {
+    if (kernels == nullptr || a.slice_height % kernels->width != 0) continue;
+    SellArrays arrays{static_cast<size_t>(a.rows), a.slice_height, a.slice_ptr.data(), a.lengths.data(),
+                      a.row_order.data(),          a.index.data(),  a.values.data()};
+    kernels->sell_double(arrays, first, last, x, y);
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,70 @@
+// Copyright 2024 Nesterov Alexander
+#include <cstddef>
+#include <cstdint>
+
+#include "core/sparse/src/spmv_isa.hpp"
+
+#ifdef PPC_SPMV_X86
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace {
+
+constexpr size_t WIDTH = 4;
+
+// Every 4 rows of a slice are a register of sums. Step j gathers x at the
+// columns of entry j of the rows, rows shorter than j + 1 are masked out of
+// the gather, and the loop ends when all of them are
+void sell_double(const ppc::core::spmv_detail::SellArrays& a, size_t first, size_t last, const double* x,
+                 double* y) {
+  const auto height = a.slice_height;
+  alignas(32) double sums[WIDTH];
+  for (size_t slice = first; slice < last; slice++) {
+    auto row_begin = slice * height;
+    auto num_rows = a.rows - row_begin < height ? a.rows - row_begin : height;
+    const auto* index = a.index + a.slice_ptr[slice];
+    const auto* values = a.values + a.slice_ptr[slice];
+    auto width = static_cast<size_t>(a.slice_ptr[slice + 1] - a.slice_ptr[slice]) / height;
+    for (size_t group = 0; group < num_rows; group += WIDTH) {
+      auto lengths = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.lengths + row_begin + group));
+      auto sum = _mm256_setzero_pd();
+      for (size_t j = 0; j < width; j++) {
+        auto active = _mm_cmpgt_epi32(lengths, _mm_set1_epi32(static_cast<int>(j)));
+        if (_mm_movemask_epi8(active) == 0) break;
+        auto offset = j * height + group;
+        auto columns = _mm_loadu_si128(reinterpret_cast<const __m128i*>(index + offset));
+        auto mask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(active));
+        auto xs = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, columns, mask, sizeof(double));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_loadu_pd(values + offset), xs));
+      }
+      _mm256_store_pd(sums, sum);
+      for (size_t lane = 0; lane < WIDTH && group + lane < num_rows; lane++) {
+        y[a.row_order[row_begin + group + lane]] = sums[lane];
+      }
+    }
+  }
+}
+
+const ppc::core::spmv_detail::SpmvKernelTable kernels = {WIDTH, &sell_double};
+
+}  // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+const ppc::core::spmv_detail::SpmvKernelTable* ppc::core::spmv_detail::get_avx2_spmv_kernels() { return &kernels; }
+
+#else
+
+const ppc::core::spmv_detail::SpmvKernelTable* ppc::core::spmv_detail::get_avx2_spmv_kernels() { return nullptr; }
+
+#endif  // PPC_SPMV_X86
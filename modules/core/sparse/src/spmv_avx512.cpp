@@ -0,0 +1,74 @@
+// Copyright 2024 Nesterov Alexander
+#include <cstddef>
+#include <cstdint>
+
+#include "core/sparse/src/spmv_isa.hpp"
+
+#ifdef PPC_SPMV_X86
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+// Products and sums of the intrinsics would be fused like those of vector
+// extensions, which AVX-512 implies
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace {
+
+constexpr size_t WIDTH = 8;
+
+// Same steps as the AVX2 kernel over 8 rows, the gather takes a mask
+// register of active rows. Products aren't fused, so sums are the same as
+// of the AVX2 kernel and of the scalar loop
+void sell_double(const ppc::core::spmv_detail::SellArrays& a, size_t first, size_t last, const double* x,
+                 double* y) {
+  const auto height = a.slice_height;
+  alignas(64) double sums[WIDTH];
+  for (size_t slice = first; slice < last; slice++) {
+    auto row_begin = slice * height;
+    auto num_rows = a.rows - row_begin < height ? a.rows - row_begin : height;
+    const auto* index = a.index + a.slice_ptr[slice];
+    const auto* values = a.values + a.slice_ptr[slice];
+    auto width = static_cast<size_t>(a.slice_ptr[slice + 1] - a.slice_ptr[slice]) / height;
+    for (size_t group = 0; group < num_rows; group += WIDTH) {
+      auto lengths = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.lengths + row_begin + group));
+      auto sum = _mm512_setzero_pd();
+      for (size_t j = 0; j < width; j++) {
+        auto active = _mm256_cmpgt_epi32(lengths, _mm256_set1_epi32(static_cast<int>(j)));
+        auto mask = static_cast<__mmask8>(_mm256_movemask_ps(_mm256_castsi256_ps(active)));
+        if (mask == 0) break;
+        auto offset = j * height + group;
+        auto columns = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index + offset));
+        auto xs = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, columns, x, sizeof(double));
+        sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_loadu_pd(values + offset), xs));
+      }
+      _mm512_store_pd(sums, sum);
+      for (size_t lane = 0; lane < WIDTH && group + lane < num_rows; lane++) {
+        y[a.row_order[row_begin + group + lane]] = sums[lane];
+      }
+    }
+  }
+}
+
+const ppc::core::spmv_detail::SpmvKernelTable kernels = {WIDTH, &sell_double};
+
+}  // namespace
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+const ppc::core::spmv_detail::SpmvKernelTable* ppc::core::spmv_detail::get_avx512_spmv_kernels() { return &kernels; }
+
+#else
+
+const ppc::core::spmv_detail::SpmvKernelTable* ppc::core::spmv_detail::get_avx512_spmv_kernels() { return nullptr; }
+
+#endif  // PPC_SPMV_X86
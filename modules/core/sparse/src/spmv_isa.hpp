@@ -0,0 +1,41 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_SPARSE_SRC_SPMV_ISA_HPP_
+#define MODULES_CORE_SPARSE_SRC_SPMV_ISA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PPC_SPMV_X86
+#endif
+
+namespace ppc::core::spmv_detail {
+
+// Arrays of a SellMatrix<double, int32_t>, so the kernels don't include the
+// library headers in the region compiled for their instruction set
+struct SellArrays {
+  size_t rows;
+  size_t slice_height;
+  const int32_t* slice_ptr;
+  const int32_t* lengths;
+  const int32_t* row_order;
+  const int32_t* index;
+  const double* values;
+};
+
+// Kernels of one instruction set, they run slices whose height is a
+// multiple of width
+struct SpmvKernelTable {
+  size_t width;
+  void (*sell_double)(const SellArrays& a, size_t first, size_t last, const double* x, double* y);
+};
+
+// Each table is defined in its own translation unit compiled for the
+// instruction set, nullptr when the target isn't x86
+const SpmvKernelTable* get_avx2_spmv_kernels();
+const SpmvKernelTable* get_avx512_spmv_kernels();
+
+}  // namespace ppc::core::spmv_detail
+
+#endif  // MODULES_CORE_SPARSE_SRC_SPMV_ISA_HPP_
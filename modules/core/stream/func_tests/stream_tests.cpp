@@ -0,0 +1,168 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/stream/include/bounded_queue.hpp"
+#include "core/stream/include/stream.hpp"
+#include "core/task/func_tests/test_task.hpp"
+
+namespace {
+
+class StreamData {
+ public:
+  explicit StreamData(size_t count) : in(count), out(count, std::vector<int32_t>(1, 0)) {
+    for (size_t i = 0; i < count; i++) {
+      in[i] = std::vector<int32_t>(i + 1, 1);
+
+      auto taskData = std::make_shared<ppc::core::TaskData>();
+      taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in[i].data()));
+      taskData->inputs_count.emplace_back(in[i].size());
+      taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out[i].data()));
+      taskData->outputs_count.emplace_back(out[i].size());
+      stream.push_back(taskData);
+    }
+  }
+
+  std::shared_ptr<ppc::core::StreamExecutor> make_executor() {
+    return std::make_shared<ppc::core::StreamExecutor>(
+        [&](std::shared_ptr<ppc::core::TaskData> taskData) {
+          num_created++;
+          return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+        },
+        stream);
+  }
+
+  void check_outputs() {
+    for (size_t i = 0; i < in.size(); i++) {
+      EXPECT_EQ(static_cast<size_t>(out[i][0]), in[i].size());
+    }
+  }
+
+  std::vector<std::vector<int32_t>> in;
+  std::vector<std::vector<int32_t>> out;
+  std::vector<std::shared_ptr<ppc::core::TaskData>> stream;
+  int num_created = 0;
+};
+
+// Throws from pre_processing() or run() of the problem with the given input size
+class ThrowingTask : public ppc::test::TestTask<int32_t> {
+ public:
+  ThrowingTask(std::shared_ptr<ppc::core::TaskData> taskData_, size_t size_, bool in_run_)
+      : TestTask(std::move(taskData_)), size(size_), in_run(in_run_) {}
+
+  bool pre_processing() override {
+    if (!in_run && taskData->inputs_count[0] == size) throw std::runtime_error("pre_processing failed");
+    return TestTask::pre_processing();
+  }
+
+  bool run() override {
+    if (in_run && taskData->inputs_count[0] == size) throw std::runtime_error("run failed");
+    return TestTask::run();
+  }
+
+ private:
+  size_t size;
+  bool in_run;
+};
+
+}  // namespace
+
+TEST(stream_tests, check_double_buffering) {
+  StreamData data(20);
+  auto executor = data.make_executor();
+
+  auto streamAttr = std::make_shared<ppc::core::StreamAttr>();
+
+  ASSERT_TRUE(executor->run(streamAttr));
+  data.check_outputs();
+  EXPECT_EQ(data.num_created, 2);
+  EXPECT_GT(executor->get_steady_throughput(), 0.0);
+}
+
+TEST(stream_tests, check_reuse_of_slots) {
+  StreamData data(7);
+  auto executor = data.make_executor();
+
+  auto streamAttr = std::make_shared<ppc::core::StreamAttr>();
+  streamAttr->num_slots = 3;
+  streamAttr->queue_capacity = 2;
+
+  ASSERT_TRUE(executor->run(streamAttr));
+  ASSERT_TRUE(executor->run(streamAttr));
+  data.check_outputs();
+  EXPECT_EQ(data.num_created, 3);
+}
+
+TEST(stream_tests, check_single_slot) {
+  StreamData data(5);
+  auto executor = data.make_executor();
+
+  auto streamAttr = std::make_shared<ppc::core::StreamAttr>();
+  streamAttr->num_slots = 1;
+
+  ASSERT_TRUE(executor->run(streamAttr));
+  data.check_outputs();
+}
+
+TEST(stream_tests, check_invalid_problem) {
+  StreamData data(6);
+  data.stream[4]->outputs_count[0] = 2;
+  data.out[4][0] = -7;
+  auto executor = data.make_executor();
+
+  EXPECT_FALSE(executor->run(std::make_shared<ppc::core::StreamAttr>()));
+  auto statuses = executor->get_statuses();
+  ASSERT_EQ(statuses.size(), 6U);
+  for (size_t i = 0; i < statuses.size(); i++) {
+    EXPECT_EQ(statuses[i], i != 4);
+  }
+  // stages after validation() weren't called for it
+  EXPECT_EQ(data.out[4][0], -7);
+}
+
+TEST(stream_tests, check_exceptions_are_rethrown) {
+  for (bool in_run : {false, true}) {
+    StreamData data(30);
+    auto streamAttr = std::make_shared<ppc::core::StreamAttr>();
+    streamAttr->queue_capacity = 1;
+    ppc::core::StreamExecutor executor(
+        [&](std::shared_ptr<ppc::core::TaskData> taskData) {
+          return std::make_shared<ThrowingTask>(taskData, 4, in_run);
+        },
+        data.stream);
+    // neither side is left waiting on a queue for the other one
+    EXPECT_THROW(executor.run(streamAttr), std::runtime_error) << "in run " << in_run;
+  }
+}
+
+TEST(stream_tests, check_empty_stream) {
+  StreamData data(0);
+  auto executor = data.make_executor();
+
+  EXPECT_TRUE(executor->run(std::make_shared<ppc::core::StreamAttr>()));
+  EXPECT_EQ(data.num_created, 0);
+}
+
+TEST(stream_tests, check_bounded_queue_backpressure) {
+  ppc::core::BoundedQueue<int> queue(2);
+  std::atomic<int> pushed(0);
+  std::thread producer([&] {
+    for (int i = 0; i < 100; i++) {
+      queue.push(i);
+      pushed++;
+    }
+  });
+
+  // producer never runs ahead of consumer by more than the capacity
+  for (int i = 0; i < 100; i++) {
+    EXPECT_LE(pushed.load(), i + 2);
+    EXPECT_EQ(queue.pop(), i);
+  }
+  producer.join();
+}
@@ -0,0 +1,63 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_STREAM_INCLUDE_BOUNDED_QUEUE_HPP_
+#define MODULES_CORE_STREAM_INCLUDE_BOUNDED_QUEUE_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace ppc::core {
+
+// Blocking FIFO queue between stages: push() waits while the queue is full
+// (backpressure on the producer), pop() waits while it is empty. close()
+// releases both sides when one of them fails: later pushes are dropped and
+// pop() returns nothing once the queue is empty
+template <class T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity_) : capacity(std::max<size_t>(1, capacity_)) {}
+
+  // false if the queue is closed and the value was dropped
+  bool push(T value) {
+    std::unique_lock<std::mutex> lock(mutex);
+    not_full.wait(lock, [&] { return closed || queue.size() < capacity; });
+    if (closed) return false;
+    queue.push_back(std::move(value));
+    not_empty.notify_one();
+    return true;
+  }
+
+  std::optional<T> pop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    not_empty.wait(lock, [&] { return closed || !queue.empty(); });
+    if (queue.empty()) return std::nullopt;
+    T value = std::move(queue.front());
+    queue.pop_front();
+    not_full.notify_one();
+    return value;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    not_full.notify_all();
+    not_empty.notify_all();
+  }
+
+ private:
+  size_t capacity;
+  bool closed = false;
+  std::deque<T> queue;
+  std::mutex mutex;
+  std::condition_variable not_full;
+  std::condition_variable not_empty;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_STREAM_INCLUDE_BOUNDED_QUEUE_HPP_
@@ -0,0 +1,57 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_STREAM_INCLUDE_STREAM_HPP_
+#define MODULES_CORE_STREAM_INCLUDE_STREAM_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+struct StreamAttr {
+  // number of task objects reused for consecutive problems, 2 gives double
+  // buffering: pre_processing() of problem k + 1 overlaps run() of problem k
+  size_t num_slots = 2;
+  // capacity of the queue between pre_processing() and run() stages
+  size_t queue_capacity = 1;
+  // state of testing of tasks
+  TaskData::StateOfTesting state_of_testing = TaskData::StateOfTesting::FUNC;
+};
+
+// Runs a stream of problems through the pipeline with two overlapping stages:
+// validation() -> pre_processing() on a producer thread and run() ->
+// post_processing() on the calling thread
+class StreamExecutor {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>)>;
+
+  StreamExecutor(TaskFactory factory_, std::vector<std::shared_ptr<TaskData>> stream_);
+
+  // Process all problems of the stream in order, returns true if every task
+  // is valid and all of its stages succeeded. A problem fails at its first
+  // stage returning false; an exception of a stage stops the stream and is
+  // rethrown here
+  bool run(const std::shared_ptr<StreamAttr>& streamAttr);
+
+  [[nodiscard]] size_t size() const { return stream.size(); }
+  // status of every problem of the last run
+  [[nodiscard]] std::vector<bool> get_statuses() const;
+  // problems per second between the first and the last completed problem of
+  // the last run, i.e. without filling and draining of the pipeline
+  [[nodiscard]] double get_steady_throughput() const { return steady_throughput; }
+
+ private:
+  TaskFactory factory;
+  std::vector<std::shared_ptr<TaskData>> stream;
+  std::vector<std::shared_ptr<Task>> slots;
+  std::vector<char> statuses;
+  double steady_throughput = 0.0;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_STREAM_INCLUDE_STREAM_HPP_
@@ -0,0 +1,99 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/stream/include/stream.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <thread>
+#include <utility>
+
+#include "core/stream/include/bounded_queue.hpp"
+
+namespace {
+
+double current_time() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct PreparedProblem {
+  size_t slot;
+  size_t index;
+  bool status;
+};
+
+}  // namespace
+
+ppc::core::StreamExecutor::StreamExecutor(TaskFactory factory_, std::vector<std::shared_ptr<TaskData>> stream_)
+    : factory(std::move(factory_)), stream(std::move(stream_)), statuses(stream.size(), 0) {}
+
+bool ppc::core::StreamExecutor::run(const std::shared_ptr<StreamAttr>& streamAttr) {
+  std::fill(statuses.begin(), statuses.end(), 0);
+  steady_throughput = 0.0;
+  if (stream.empty()) return true;
+
+  // task objects are created once and rebound to next problems with set_data()
+  auto num_slots = std::max<size_t>(1, streamAttr->num_slots);
+  while (slots.size() < num_slots) {
+    slots.push_back(factory(stream[slots.size() % stream.size()]));
+  }
+
+  BoundedQueue<size_t> free_slots(num_slots);
+  for (size_t slot = 0; slot < num_slots; slot++) {
+    free_slots.push(slot);
+  }
+  BoundedQueue<PreparedProblem> prepared(streamAttr->queue_capacity);
+
+  // a failed side closes both queues, so the other one doesn't wait for it
+  // forever, and its exception is rethrown after the producer is joined
+  std::exception_ptr producer_error;
+  std::thread producer([&] {
+    try {
+      for (size_t index = 0; index < stream.size(); index++) {
+        auto slot = free_slots.pop();
+        if (!slot) return;
+        auto& task = slots[*slot];
+        task->set_data(stream[index]);
+        task->get_data()->state_of_testing = streamAttr->state_of_testing;
+        // an invalid problem isn't pre-processed, the consumer only records it
+        bool status = task->validation() && task->pre_processing();
+        if (!prepared.push({*slot, index, status})) return;
+      }
+    } catch (...) {
+      producer_error = std::current_exception();
+      prepared.close();
+    }
+  });
+
+  double first_done = 0.0;
+  double last_done = 0.0;
+  std::exception_ptr consumer_error;
+  try {
+    for (size_t count = 0; count < stream.size(); count++) {
+      auto problem = prepared.pop();
+      if (!problem) break;
+      auto& task = slots[problem->slot];
+      bool status = problem->status && task->run() && task->post_processing();
+      statuses[problem->index] = static_cast<char>(status);
+      free_slots.push(problem->slot);
+
+      last_done = current_time();
+      if (count == 0) first_done = last_done;
+    }
+  } catch (...) {
+    consumer_error = std::current_exception();
+    free_slots.close();
+    prepared.close();
+  }
+  producer.join();
+  if (producer_error) std::rethrow_exception(producer_error);
+  if (consumer_error) std::rethrow_exception(consumer_error);
+
+  if (stream.size() > 1 && last_done > first_done) {
+    steady_throughput = static_cast<double>(stream.size() - 1) / (last_done - first_done);
+  }
+  return std::all_of(statuses.begin(), statuses.end(), [](char status) { return status != 0; });
+}
+
+std::vector<bool> ppc::core::StreamExecutor::get_statuses() const {
+  return std::vector<bool>(statuses.begin(), statuses.end());
+}
@@ -0,0 +1,141 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/task/include/cancellation.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+// Counts up to the number from inputs, polling cancellation every step
+class CountingTask : public ppc::core::Task {
+ public:
+  explicit CountingTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] == 1;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    limit = reinterpret_cast<uint64_t *>(taskData->inputs[0])[0];
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    for (count = 0; count < limit; count++) {
+      if (interrupted(static_cast<double>(count) / static_cast<double>(limit))) return false;
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    reinterpret_cast<uint64_t *>(taskData->outputs[0])[0] = count;
+    return true;
+  }
+
+ private:
+  uint64_t limit = 0;
+  uint64_t count = 0;
+};
+
+std::shared_ptr<ppc::core::TaskData> make_task_data(uint64_t &limit, uint64_t &out) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(&limit));
+  taskData->inputs_count.emplace_back(1);
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out));
+  taskData->outputs_count.emplace_back(1);
+  return taskData;
+}
+
+}  // namespace
+
+TEST(cancellation_tests, check_token) {
+  ppc::core::CancellationToken token;
+  EXPECT_FALSE(token.is_cancelled());
+  EXPECT_FALSE(token.is_expired());
+  token.set_timeout(0.0);
+  EXPECT_TRUE(token.is_expired());
+  token.set_timeout(100.0);
+  EXPECT_FALSE(token.is_expired());
+  token.cancel();
+  EXPECT_TRUE(token.is_cancelled());
+  token.reset();
+  EXPECT_FALSE(token.is_cancelled());
+  EXPECT_FALSE(token.is_expired());
+}
+
+TEST(cancellation_tests, check_convergence_progress) {
+  EXPECT_DOUBLE_EQ(ppc::core::get_convergence_progress(1.0, 1.0, 1e-6), 0.0);
+  EXPECT_DOUBLE_EQ(ppc::core::get_convergence_progress(1.0, 1e-3, 1e-6), 0.5);
+  EXPECT_DOUBLE_EQ(ppc::core::get_convergence_progress(1.0, 1e-9, 1e-6), 1.0);
+  EXPECT_DOUBLE_EQ(ppc::core::get_convergence_progress(1.0, 2.0, 1e-6), 0.0);
+  // already converged input
+  EXPECT_DOUBLE_EQ(ppc::core::get_convergence_progress(1e-7, 1e-8, 1e-6), 0.0);
+}
+
+TEST(cancellation_tests, check_run_without_token) {
+  uint64_t limit = 100;
+  uint64_t out = 0;
+  CountingTask task(make_task_data(limit, out));
+  ASSERT_TRUE(task.validation());
+  ASSERT_TRUE(task.pre_processing());
+  ASSERT_TRUE(task.run());
+  ASSERT_TRUE(task.post_processing());
+  EXPECT_EQ(task.get_status(), ppc::core::Task::Status::COMPLETED);
+  EXPECT_EQ(out, limit);
+}
+
+TEST(cancellation_tests, check_deadline) {
+  uint64_t limit = 1000000000;
+  uint64_t out = 0;
+  auto taskData = make_task_data(limit, out);
+  taskData->cancellation = std::make_shared<ppc::core::CancellationToken>();
+  taskData->cancellation->set_timeout(0.05);
+
+  CountingTask task(taskData);
+  ASSERT_TRUE(task.validation());
+  ASSERT_TRUE(task.pre_processing());
+  EXPECT_FALSE(task.run());
+  ASSERT_TRUE(task.post_processing());
+  EXPECT_EQ(task.get_status(), ppc::core::Task::Status::TIMED_OUT);
+  // partial progress is kept
+  EXPECT_GT(out, 0U);
+  EXPECT_LT(out, limit);
+  EXPECT_GT(task.get_progress(), 0.0);
+  EXPECT_LT(task.get_progress(), 1.0);
+}
+
+TEST(cancellation_tests, check_cancel_from_other_thread) {
+  uint64_t limit = 1000000000;
+  uint64_t out = 0;
+  auto taskData = make_task_data(limit, out);
+  taskData->cancellation = std::make_shared<ppc::core::CancellationToken>();
+
+  CountingTask task(taskData);
+  ASSERT_TRUE(task.validation());
+  ASSERT_TRUE(task.pre_processing());
+  std::thread canceller([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    taskData->cancellation->cancel();
+  });
+  EXPECT_FALSE(task.run());
+  canceller.join();
+  ASSERT_TRUE(task.post_processing());
+  EXPECT_EQ(task.get_status(), ppc::core::Task::Status::CANCELLED);
+
+  // status is reset by the next run
+  taskData->cancellation->reset();
+  limit = 10;
+  ASSERT_TRUE(task.validation());
+  ASSERT_TRUE(task.pre_processing());
+  EXPECT_TRUE(task.run());
+  ASSERT_TRUE(task.post_processing());
+  EXPECT_EQ(task.get_status(), ppc::core::Task::Status::COMPLETED);
+  EXPECT_EQ(out, limit);
+}
@@ -0,0 +1,90 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "core/task/include/data_view.hpp"
+
+TEST(data_view_tests, check_input_output_view) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  auto input = ppc::core::input_view<const int32_t>(*taskData, 0);
+  auto output = ppc::core::output_view<int32_t>(*taskData, 0);
+  ASSERT_EQ(input.data(), in.data());
+  ASSERT_EQ(input.size(), in.size());
+  output[0] = std::accumulate(input.begin(), input.end(), 0);
+  EXPECT_EQ(static_cast<size_t>(out[0]), in.size());
+
+  EXPECT_THROW(ppc::core::input_view<const int32_t>(*taskData, 1), std::out_of_range);
+  EXPECT_THROW(ppc::core::output_view<int32_t>(*taskData, 1), std::out_of_range);
+}
+
+TEST(data_view_tests, check_matrix_view) {
+  // Create data: 3x4 matrix
+  std::vector<double> in(12);
+  std::iota(in.begin(), in.end(), 0.0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+
+  auto matrix = ppc::core::input_matrix_view<const double>(*taskData, 0, 3, 4);
+  EXPECT_EQ(matrix.rows(), 3U);
+  EXPECT_EQ(matrix.cols(), 4U);
+  EXPECT_DOUBLE_EQ(matrix(2, 1), 9.0);
+  EXPECT_DOUBLE_EQ(matrix.row(1)[3], 7.0);
+  EXPECT_THROW(matrix.at(3, 0), std::out_of_range);
+
+  auto block = matrix.block(1, 1, 2, 2);
+  EXPECT_EQ(block.stride(), 4U);
+  EXPECT_DOUBLE_EQ(block(0, 0), 5.0);
+  EXPECT_DOUBLE_EQ(block(1, 1), 10.0);
+  EXPECT_THROW(static_cast<void>(matrix.block(2, 2, 2, 2)), std::out_of_range);
+
+  EXPECT_THROW(ppc::core::input_matrix_view<const double>(*taskData, 0, 4, 4), std::out_of_range);
+}
+
+TEST(data_view_tests, check_crs_view) {
+  // Create data: [[1 0 2] [0 0 0] [0 3 0]]
+  std::vector<double> values = {1.0, 2.0, 3.0};
+  std::vector<uint32_t> col_indices = {0, 2, 1};
+  std::vector<uint32_t> row_ptr = {0, 2, 2, 3};
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(values.data()));
+  taskData->inputs_count.emplace_back(values.size());
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(col_indices.data()));
+  taskData->inputs_count.emplace_back(col_indices.size());
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(row_ptr.data()));
+  taskData->inputs_count.emplace_back(row_ptr.size());
+
+  auto crs = ppc::core::input_crs_view<const double, const uint32_t>(*taskData, 0, 1, 2, 3);
+  EXPECT_EQ(crs.rows(), 3U);
+  EXPECT_EQ(crs.cols(), 3U);
+  EXPECT_EQ(crs.nnz(), 3U);
+  EXPECT_EQ(crs.row_values(0).size(), 2U);
+  EXPECT_TRUE(crs.row_values(1).empty());
+  EXPECT_EQ(crs.row_cols(2)[0], 1U);
+  EXPECT_DOUBLE_EQ(crs.row_values(2)[0], 3.0);
+}
+
+TEST(data_view_tests, check_crs_view_inconsistent) {
+  std::vector<double> values = {1.0, 2.0, 3.0};
+  std::vector<uint32_t> col_indices = {0, 2, 1};
+  std::vector<uint32_t> row_ptr = {0, 2, 2, 4};
+
+  EXPECT_THROW((ppc::core::CrsView<double>(values, col_indices, row_ptr, 3)), std::invalid_argument);
+}
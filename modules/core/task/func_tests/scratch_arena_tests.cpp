@@ -0,0 +1,137 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/task/include/scratch_arena.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+// Sum of inputs computed through a scratch copy of them
+class ScratchTask : public ppc::core::Task {
+ public:
+  explicit ScratchTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] == 1;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    auto* input = reinterpret_cast<int32_t *>(taskData->inputs[0]);
+    auto buffer = scratch().allocate<int32_t>(taskData->inputs_count[0]);
+    std::copy(input, input + buffer.size(), buffer.begin());
+    sum = std::accumulate(buffer.begin(), buffer.end(), 0);
+    heap_allocations = scratch().get_heap_allocations();
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    reinterpret_cast<int32_t *>(taskData->outputs[0])[0] = sum;
+    return true;
+  }
+
+  uint64_t heap_allocations = 0;
+
+ private:
+  int32_t sum = 0;
+};
+
+}  // namespace
+
+TEST(scratch_arena_tests, check_alignment_and_zeroing) {
+  ppc::core::ScratchArena arena;
+  auto bytes = arena.allocate<uint8_t>(3);
+  auto values = arena.allocate<double>(100);
+  EXPECT_EQ(bytes.size(), 3U);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(values.data()) % ppc::core::ScratchArena::DEFAULT_ALIGNMENT, 0U);
+  for (auto value : values) {
+    EXPECT_EQ(value, 0.0);
+  }
+  EXPECT_EQ(arena.get_allocated_bytes(), 3 + 100 * sizeof(double));
+  EXPECT_THROW(static_cast<void>(arena.allocate(8, 3)), std::invalid_argument);
+}
+
+TEST(scratch_arena_tests, check_reset_keeps_memory) {
+  ppc::core::ScratchArena arena;
+  for (int i = 0; i < 10; i++) {
+    static_cast<void>(arena.allocate<double>(ppc::core::ScratchArena::MIN_BLOCK_SIZE / 4));
+  }
+  auto heap_allocations = arena.get_heap_allocations();
+  EXPECT_GT(heap_allocations, 1U);
+
+  for (int run = 0; run < 3; run++) {
+    arena.reset();
+    for (int i = 0; i < 10; i++) {
+      static_cast<void>(arena.allocate<double>(ppc::core::ScratchArena::MIN_BLOCK_SIZE / 4));
+    }
+  }
+  // one block of the whole size after the first reset, no allocations then
+  EXPECT_EQ(arena.get_heap_allocations(), heap_allocations + 1);
+}
+
+TEST(scratch_arena_tests, check_scope) {
+  ppc::core::ScratchArena arena;
+  auto* first = arena.allocate(16);
+  void* inner = nullptr;
+  {
+    ppc::core::ScratchArena::Scope scope(arena);
+    inner = arena.allocate(ppc::core::ScratchArena::MIN_BLOCK_SIZE);
+  }
+  // memory of the scope is reused
+  EXPECT_NE(arena.allocate(16), first);
+  {
+    ppc::core::ScratchArena::Scope scope(arena);
+    static_cast<void>(arena.allocate(16));
+    EXPECT_EQ(arena.allocate(ppc::core::ScratchArena::MIN_BLOCK_SIZE), inner);
+  }
+}
+
+TEST(scratch_arena_tests, check_arena_per_thread) {
+  ppc::core::ScratchMemory memory;
+  auto* main_arena = &memory.local();
+  ppc::core::ScratchArena* thread_arena = nullptr;
+  std::thread thread([&] {
+    thread_arena = &memory.local();
+    static_cast<void>(thread_arena->allocate(100));
+  });
+  thread.join();
+  static_cast<void>(memory.local().allocate(50));
+
+  EXPECT_NE(main_arena, thread_arena);
+  EXPECT_EQ(&memory.local(), main_arena);
+  EXPECT_EQ(memory.get_allocated_bytes(), 150U);
+}
+
+TEST(scratch_arena_tests, check_task_scratch) {
+  std::vector<int32_t> in(1000, 2);
+  std::vector<int32_t> out(1, 0);
+
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  ScratchTask task(taskData);
+  std::vector<uint64_t> heap_allocations;
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(task.validation());
+    ASSERT_TRUE(task.pre_processing());
+    ASSERT_TRUE(task.run());
+    ASSERT_TRUE(task.post_processing());
+    ASSERT_EQ(out[0], 2000);
+    heap_allocations.push_back(task.heap_allocations);
+  }
+  EXPECT_EQ(heap_allocations[0], heap_allocations[2]);
+  EXPECT_EQ(task.get_scratch_bytes(), 3 * in.size() * sizeof(int32_t));
+}
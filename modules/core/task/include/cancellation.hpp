@@ -0,0 +1,38 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_TASK_INCLUDE_CANCELLATION_HPP_
+#define MODULES_CORE_TASK_INCLUDE_CANCELLATION_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+namespace ppc::core {
+
+// Cooperative cancellation of a task: cancel() and set_timeout() may be
+// called from any thread, running kernels poll the token at chunk boundaries
+// through Task::interrupted()
+class CancellationToken {
+ public:
+  void cancel() { cancelled.store(true); }
+  // deadline in seconds from now, non-positive value expires immediately
+  void set_timeout(double seconds);
+  // clear cancellation and deadline
+  void reset();
+
+  [[nodiscard]] bool is_cancelled() const { return cancelled.load(); }
+  [[nodiscard]] bool is_expired() const;
+
+ private:
+  std::atomic<bool> cancelled{false};
+  // steady clock time in nanoseconds, 0 if there is no deadline
+  std::atomic<int64_t> deadline_ns{0};
+};
+
+// Progress for Task::interrupted() of an iterative method whose residual
+// decreases geometrically: log scale from the initial residual (0) down to
+// the tolerance (1)
+double get_convergence_progress(double initial_residual, double residual, double tolerance);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_TASK_INCLUDE_CANCELLATION_HPP_
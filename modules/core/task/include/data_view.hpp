@@ -0,0 +1,152 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_TASK_INCLUDE_DATA_VIEW_HPP_
+#define MODULES_CORE_TASK_INCLUDE_DATA_VIEW_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Non-owning row-major view of a matrix, stride is a distance between
+// beginnings of rows (in elements)
+template <class T>
+class MatrixView {
+ public:
+  MatrixView() = default;
+  MatrixView(T* data, size_t rows, size_t cols) : MatrixView(data, rows, cols, cols) {}
+  MatrixView(T* data, size_t rows, size_t cols, size_t stride)
+      : data_(data), rows_(rows), cols_(cols), stride_(stride) {
+    if (stride_ < cols_) throw std::invalid_argument("MatrixView: stride is less than number of columns");
+  }
+  // view of const elements from a mutable one
+  template <class U>
+    requires std::is_convertible_v<U (*)[], T (*)[]>
+  MatrixView(const MatrixView<U>& other)  // NOLINT(google-explicit-constructor)
+      : data_(other.data()), rows_(other.rows()), cols_(other.cols()), stride_(other.stride()) {}
+
+  [[nodiscard]] T* data() const { return data_; }
+  [[nodiscard]] size_t rows() const { return rows_; }
+  [[nodiscard]] size_t cols() const { return cols_; }
+  [[nodiscard]] size_t stride() const { return stride_; }
+
+  T& operator()(size_t row, size_t col) const { return data_[row * stride_ + col]; }
+  T& at(size_t row, size_t col) const {
+    if (row >= rows_ || col >= cols_) throw std::out_of_range("MatrixView: index is out of range");
+    return (*this)(row, col);
+  }
+
+  [[nodiscard]] std::span<T> row(size_t row) const { return std::span<T>(data_ + row * stride_, cols_); }
+
+  // view of rows x cols submatrix starting at (row, col)
+  [[nodiscard]] MatrixView block(size_t row, size_t col, size_t rows, size_t cols) const {
+    if (row + rows > rows_ || col + cols > cols_) throw std::out_of_range("MatrixView: block is out of range");
+    return MatrixView(data_ + row * stride_ + col, rows, cols, stride_);
+  }
+
+ private:
+  T* data_ = nullptr;
+  size_t rows_ = 0;
+  size_t cols_ = 0;
+  size_t stride_ = 0;
+};
+
+// Non-owning view of a sparse matrix in compressed row storage (CRS):
+// row_ptr has rows + 1 elements, values and col_indices have row_ptr[rows]
+template <class T, class IndexType = uint32_t>
+class CrsView {
+ public:
+  CrsView() = default;
+  CrsView(std::span<T> values, std::span<IndexType> col_indices, std::span<IndexType> row_ptr, size_t cols)
+      : values_(values), col_indices_(col_indices), row_ptr_(row_ptr), cols_(cols) {
+    if (row_ptr_.empty() || values_.size() != col_indices_.size() ||
+        static_cast<size_t>(row_ptr_.back()) != values_.size()) {
+      throw std::invalid_argument("CrsView: sizes of values, col_indices and row_ptr are inconsistent");
+    }
+  }
+
+  [[nodiscard]] size_t rows() const { return row_ptr_.empty() ? 0 : row_ptr_.size() - 1; }
+  [[nodiscard]] size_t cols() const { return cols_; }
+  [[nodiscard]] size_t nnz() const { return values_.size(); }
+
+  [[nodiscard]] std::span<T> values() const { return values_; }
+  [[nodiscard]] std::span<IndexType> col_indices() const { return col_indices_; }
+  [[nodiscard]] std::span<IndexType> row_ptr() const { return row_ptr_; }
+
+  [[nodiscard]] std::span<T> row_values(size_t row) const {
+    return values_.subspan(row_ptr_[row], row_ptr_[row + 1] - row_ptr_[row]);
+  }
+  [[nodiscard]] std::span<IndexType> row_cols(size_t row) const {
+    return col_indices_.subspan(row_ptr_[row], row_ptr_[row + 1] - row_ptr_[row]);
+  }
+
+ private:
+  std::span<T> values_;
+  std::span<IndexType> col_indices_;
+  std::span<IndexType> row_ptr_;
+  size_t cols_ = 0;
+};
+
+namespace detail {
+
+template <class T>
+std::span<T> buffer_view(const std::vector<uint8_t*>& buffers, const std::vector<std::uint32_t>& counts, size_t index,
+                         const char* name) {
+  if (index >= buffers.size() || index >= counts.size()) {
+    throw std::out_of_range(std::string("TaskData: no ") + name + " with index " + std::to_string(index));
+  }
+  return std::span<T>(reinterpret_cast<T*>(buffers[index]), counts[index]);
+}
+
+template <class T>
+MatrixView<T> matrix_view(std::span<T> buffer, size_t rows, size_t cols) {
+  if (rows * cols > buffer.size()) {
+    throw std::out_of_range("TaskData: matrix " + std::to_string(rows) + "x" + std::to_string(cols) +
+                            " is bigger than buffer of " + std::to_string(buffer.size()) + " elements");
+  }
+  return MatrixView<T>(buffer.data(), rows, cols);
+}
+
+}  // namespace detail
+
+// Typed views of TaskData buffers without copying, inputs_count and
+// outputs_count are treated as numbers of elements of type T. Use const T
+// for read-only access to inputs
+template <class T>
+std::span<T> input_view(const TaskData& taskData, size_t index) {
+  return detail::buffer_view<T>(taskData.inputs, taskData.inputs_count, index, "input");
+}
+
+template <class T>
+std::span<T> output_view(const TaskData& taskData, size_t index) {
+  return detail::buffer_view<T>(taskData.outputs, taskData.outputs_count, index, "output");
+}
+
+template <class T>
+MatrixView<T> input_matrix_view(const TaskData& taskData, size_t index, size_t rows, size_t cols) {
+  return detail::matrix_view(input_view<T>(taskData, index), rows, cols);
+}
+
+template <class T>
+MatrixView<T> output_matrix_view(const TaskData& taskData, size_t index, size_t rows, size_t cols) {
+  return detail::matrix_view(output_view<T>(taskData, index), rows, cols);
+}
+
+// CRS matrix stored in three inputs: values, col_indices and row_ptr
+template <class T, class IndexType = uint32_t>
+CrsView<T, IndexType> input_crs_view(const TaskData& taskData, size_t values_index, size_t col_indices_index,
+                                     size_t row_ptr_index, size_t cols) {
+  return CrsView<T, IndexType>(input_view<T>(taskData, values_index),
+                               input_view<IndexType>(taskData, col_indices_index),
+                               input_view<IndexType>(taskData, row_ptr_index), cols);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_TASK_INCLUDE_DATA_VIEW_HPP_
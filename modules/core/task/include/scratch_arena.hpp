@@ -0,0 +1,115 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_TASK_INCLUDE_SCRATCH_ARENA_HPP_
+#define MODULES_CORE_TASK_INCLUDE_SCRATCH_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace ppc::core {
+
+// Bump allocator for temporary buffers of a task. Memory is released all at
+// once by reset() and kept for the next use: after reset() the arena holds
+// one block large enough for everything allocated before, so repeated runs of
+// the same task don't touch the heap
+class ScratchArena {
+ public:
+  constexpr static size_t DEFAULT_ALIGNMENT = 64;
+  constexpr static size_t MIN_BLOCK_SIZE = size_t{64} * 1024;
+
+  ScratchArena() = default;
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  // Raw memory, alignment must be a power of two not greater than DEFAULT_ALIGNMENT
+  void* allocate(size_t bytes, size_t alignment = DEFAULT_ALIGNMENT);
+
+  // Value-initialized buffer of count elements
+  template <class T>
+  std::span<T> allocate(size_t count) {
+    static_assert(std::is_trivially_destructible_v<T>, "Scratch buffers are never destroyed");
+    static_assert(alignof(T) <= DEFAULT_ALIGNMENT);
+    auto* data = static_cast<T*>(allocate(count * sizeof(T)));
+    std::uninitialized_value_construct_n(data, count);
+    return {data, count};
+  }
+
+  // Release all buffers
+  void reset();
+
+  // Restores the arena to its state at construction on destruction, for
+  // stack-like temporaries of recursive algorithms
+  class Scope {
+   public:
+    explicit Scope(ScratchArena& arena_) : arena(arena_), block(arena_.block), offset(arena_.offset) {}
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    ~Scope() {
+      arena.block = block;
+      arena.offset = offset;
+    }
+
+   private:
+    ScratchArena& arena;
+    size_t block;
+    size_t offset;
+  };
+
+  // bytes requested since creation of the arena
+  [[nodiscard]] uint64_t get_allocated_bytes() const { return allocated_bytes; }
+  // number of blocks taken from the heap since creation of the arena
+  [[nodiscard]] uint64_t get_heap_allocations() const { return heap_allocations; }
+  [[nodiscard]] size_t get_capacity() const;
+
+ private:
+  struct Deleter {
+    void operator()(std::byte* data) const { ::operator delete[](data, std::align_val_t(DEFAULT_ALIGNMENT)); }
+  };
+  struct Block {
+    std::unique_ptr<std::byte[], Deleter> data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks;
+  // current block and offset in it
+  size_t block = 0;
+  size_t offset = 0;
+  // size of the block which replaces all blocks on the next allocation
+  size_t merged_capacity = 0;
+  uint64_t allocated_bytes = 0;
+  uint64_t heap_allocations = 0;
+
+  void add_block(size_t position, size_t size);
+};
+
+// Scratch arenas of one task, one for every thread which requests memory, so
+// workers of parallel regions allocate without synchronization
+class ScratchMemory {
+ public:
+  ScratchMemory();
+  ScratchMemory(const ScratchMemory&) = delete;
+  ScratchMemory& operator=(const ScratchMemory&) = delete;
+
+  // Arena of the calling thread
+  ScratchArena& local();
+  // Reset arenas of all threads, no thread may use them at the same time
+  void reset();
+  // bytes requested from arenas of all threads since creation
+  [[nodiscard]] uint64_t get_allocated_bytes() const;
+
+ private:
+  uint64_t id;
+  mutable std::mutex mutex;
+  std::unordered_map<std::thread::id, std::unique_ptr<ScratchArena>> arenas;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_TASK_INCLUDE_SCRATCH_ARENA_HPP_
@@ -3,6 +3,7 @@
 #ifndef MODULES_CORE_INCLUDE_TASK_HPP_
 #define MODULES_CORE_INCLUDE_TASK_HPP_
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <iostream>
@@ -10,6 +11,9 @@
 #include <string>
 #include <vector>
 
+#include "core/task/include/cancellation.hpp"
+#include "core/task/include/scratch_arena.hpp"
+
 namespace ppc::core {
 
 struct TaskData {
@@ -18,6 +22,8 @@ struct TaskData {
   std::vector<uint8_t *> outputs;
   std::vector<std::uint32_t> outputs_count;
   enum StateOfTesting { FUNC, PERF } state_of_testing;
+  // optional cancellation and deadline of run(), polled by kernels of tasks
+  std::shared_ptr<CancellationToken> cancellation;
 };
 
 // Memory of inputs and outputs need to be initialized before create object of
@@ -44,13 +50,38 @@ class Task {
   // get input and output data
   [[nodiscard]] std::shared_ptr<TaskData> get_data() const;
 
+  // result of the last run(): COMPLETED or stopped early by cancellation
+  // token of the task data, output then holds partial results
+  enum class Status { COMPLETED, CANCELLED, TIMED_OUT };
+  [[nodiscard]] Status get_status() const { return status.load(); }
+  // progress of the last run() in [0, 1] as reported by its kernel
+  [[nodiscard]] double get_progress() const { return progress.load(); }
+
+  // bytes requested from scratch memory of the task since its creation
+  [[nodiscard]] uint64_t get_scratch_bytes() const;
+
   virtual ~Task();
 
  protected:
   void internal_order_test(const std::string &str = __builtin_FUNCTION());
   std::shared_ptr<TaskData> taskData;
 
+  // Polled by long-running kernels at chunk boundaries (from any thread):
+  // saves progress and returns true if run() has to stop because the task was
+  // cancelled or its deadline passed
+  bool interrupted(double progress_ = 0.0);
+
+  // Temporary buffers of the current stage: scratch memory is reset at the
+  // beginning of every stage, data passed between stages is kept in members
+  ScratchArena& scratch() { return scratch_memory.local(); }
+  // For helpers which allocate from parallel regions, every thread uses
+  // its own arena via local()
+  ScratchMemory& get_scratch_memory() { return scratch_memory; }
+
  private:
+  ScratchMemory scratch_memory;
+  std::atomic<Status> status{Status::COMPLETED};
+  std::atomic<double> progress{0.0};
   std::vector<std::string> functions_order;
   std::vector<std::string> right_functions_order = {"validation", "pre_processing", "run", "post_processing"};
   const double max_test_time = 1.0;
@@ -0,0 +1,35 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/task/include/cancellation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+int64_t steady_time_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+void ppc::core::CancellationToken::set_timeout(double seconds) {
+  auto timeout_ns = static_cast<int64_t>(std::max(seconds, 0.0) * 1e9);
+  deadline_ns.store(std::max<int64_t>(steady_time_ns() + timeout_ns, 1));
+}
+
+void ppc::core::CancellationToken::reset() {
+  cancelled.store(false);
+  deadline_ns.store(0);
+}
+
+bool ppc::core::CancellationToken::is_expired() const {
+  auto deadline = deadline_ns.load();
+  return deadline != 0 && steady_time_ns() >= deadline;
+}
+
+double ppc::core::get_convergence_progress(double initial_residual, double residual, double tolerance) {
+  if (initial_residual <= tolerance || residual >= initial_residual) return 0.0;
+  return std::clamp(std::log(initial_residual / residual) / std::log(initial_residual / tolerance), 0.0, 1.0);
+}
@@ -0,0 +1,102 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/task/include/scratch_arena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::atomic<uint64_t> next_scratch_memory_id{1};
+
+// arena of the current thread for the last used ScratchMemory, ids are never
+// reused, so a stale entry of a destroyed object is never matched
+thread_local uint64_t cached_scratch_memory_id = 0;
+thread_local ppc::core::ScratchArena* cached_arena = nullptr;
+
+size_t align_up(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+}  // namespace
+
+void* ppc::core::ScratchArena::allocate(size_t bytes, size_t alignment) {
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > DEFAULT_ALIGNMENT) {
+    throw std::invalid_argument("Scratch alignment must be a power of two not greater than " +
+                                std::to_string(DEFAULT_ALIGNMENT));
+  }
+  allocated_bytes += bytes;
+  bytes = std::max<size_t>(bytes, 1);
+
+  if (merged_capacity > 0) {
+    // the block merged by reset() is allocated by the owner thread, so with
+    // first-touch page placement scratch memory stays on the node of its user
+    add_block(0, merged_capacity);
+    merged_capacity = 0;
+  }
+
+  auto begin = align_up(offset, alignment);
+  if (blocks.empty() || begin + bytes > blocks[block].size) {
+    // next block is used if it fits, otherwise a new one is inserted after
+    // the current block, so blocks kept by Scope are not lost
+    auto next = blocks.empty() ? 0 : block + 1;
+    if (next >= blocks.size() || blocks[next].size < bytes) {
+      add_block(next, std::max({bytes, MIN_BLOCK_SIZE, 2 * get_capacity()}));
+    }
+    block = next;
+    begin = 0;
+  }
+  offset = begin + bytes;
+  return blocks[block].data.get() + begin;
+}
+
+void ppc::core::ScratchArena::reset() {
+  if (blocks.size() > 1) {
+    merged_capacity = get_capacity();
+    blocks.clear();
+  }
+  block = 0;
+  offset = 0;
+}
+
+size_t ppc::core::ScratchArena::get_capacity() const {
+  return std::accumulate(blocks.begin(), blocks.end(), merged_capacity,
+                         [](size_t sum, const Block& current) { return sum + current.size; });
+}
+
+void ppc::core::ScratchArena::add_block(size_t position, size_t size) {
+  auto* data = static_cast<std::byte*>(::operator new[](size, std::align_val_t(DEFAULT_ALIGNMENT)));
+  blocks.insert(blocks.begin() + static_cast<std::ptrdiff_t>(position),
+                Block{std::unique_ptr<std::byte[], Deleter>(data), size});
+  heap_allocations++;
+}
+
+ppc::core::ScratchMemory::ScratchMemory() : id(next_scratch_memory_id++) {}
+
+ppc::core::ScratchArena& ppc::core::ScratchMemory::local() {
+  if (cached_scratch_memory_id == id) return *cached_arena;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& arena = arenas[std::this_thread::get_id()];
+  if (!arena) arena = std::make_unique<ScratchArena>();
+  cached_scratch_memory_id = id;
+  cached_arena = arena.get();
+  return *arena;
+}
+
+void ppc::core::ScratchMemory::reset() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto& [thread_id, arena] : arenas) {
+    arena->reset();
+  }
+}
+
+uint64_t ppc::core::ScratchMemory::get_allocated_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  uint64_t bytes = 0;
+  for (const auto& [thread_id, arena] : arenas) {
+    bytes += arena->get_allocated_bytes();
+  }
+  return bytes;
+}
@@ -16,7 +16,29 @@ std::shared_ptr<ppc::core::TaskData> ppc::core::Task::get_data() const { return
 
 ppc::core::Task::Task(std::shared_ptr<TaskData> taskData_) { set_data(std::move(taskData_)); }
 
+uint64_t ppc::core::Task::get_scratch_bytes() const { return scratch_memory.get_allocated_bytes(); }
+
+bool ppc::core::Task::interrupted(double progress_) {
+  progress.store(progress_);
+  const auto& token = taskData->cancellation;
+  if (!token) return false;
+  if (token->is_cancelled()) {
+    status.store(Status::CANCELLED);
+    return true;
+  }
+  if (token->is_expired()) {
+    status.store(Status::TIMED_OUT);
+    return true;
+  }
+  return false;
+}
+
 void ppc::core::Task::internal_order_test(const std::string& str) {
+  scratch_memory.reset();
+  if (str == "run") {
+    status.store(Status::COMPLETED);
+    progress.store(0.0);
+  }
   if (!functions_order.empty() && str == functions_order.back() && str == "run") return;
 
   functions_order.push_back(str);
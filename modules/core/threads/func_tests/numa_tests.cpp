@@ -0,0 +1,146 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/threads/include/numa.hpp"
+#include "core/threads/include/thread_pool.hpp"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// sysfs-like directory of a machine with two nodes and a memory-only node
+std::filesystem::path make_fake_sysfs() {
+  auto root = std::filesystem::temp_directory_path() / "ppc_numa_tests_sysfs";
+  std::filesystem::remove_all(root);
+  std::vector<std::pair<std::string, std::string>> nodes = {
+      {"node1", "4-5,7\n"}, {"node0", "0-2,3\n"}, {"node2", "\n"}, {"possible", ""}};
+  for (const auto& [name, cpulist] : nodes) {
+    std::filesystem::create_directories(root / name);
+    std::ofstream(root / name / "cpulist") << cpulist;
+  }
+  return root;
+}
+
+#ifdef __linux__
+int get_num_allowed_cpus() {
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  sched_getaffinity(0, sizeof(mask), &mask);
+  return CPU_COUNT(&mask);
+}
+#endif
+
+}  // namespace
+
+TEST(numa_tests, check_parse_cpu_list) {
+  EXPECT_EQ(ppc::core::NumaTopology::parse_cpu_list("0-3,8-9,12\n"), std::vector<int>({0, 1, 2, 3, 8, 9, 12}));
+  EXPECT_EQ(ppc::core::NumaTopology::parse_cpu_list("5"), std::vector<int>({5}));
+  EXPECT_TRUE(ppc::core::NumaTopology::parse_cpu_list("").empty());
+}
+
+TEST(numa_tests, check_topology_from_sysfs) {
+  auto root = make_fake_sysfs();
+  ppc::core::NumaTopology topology(root.string());
+  std::filesystem::remove_all(root);
+
+  ASSERT_EQ(topology.get_nodes().size(), 2U);
+  EXPECT_EQ(topology.get_nodes()[0].id, 0);
+  EXPECT_EQ(topology.get_nodes()[1].id, 1);
+  EXPECT_EQ(topology.get_num_cpus(), 7);
+  EXPECT_EQ(topology.get_node_of_cpu(3), 0);
+  EXPECT_EQ(topology.get_node_of_cpu(7), 1);
+  EXPECT_EQ(topology.get_node_of_cpu(6), -1);
+
+  using ppc::core::PinningPolicy;
+  EXPECT_EQ(topology.get_cpu_order(PinningPolicy::COMPACT), std::vector<int>({0, 1, 2, 3, 4, 5, 7}));
+  EXPECT_EQ(topology.get_cpu_order(PinningPolicy::SCATTER), std::vector<int>({0, 4, 1, 5, 2, 7, 3}));
+  EXPECT_TRUE(topology.get_cpu_order(PinningPolicy::NONE).empty());
+}
+
+TEST(numa_tests, check_topology_without_sysfs) {
+  ppc::core::NumaTopology topology("/nonexistent/sysfs/node");
+  ASSERT_EQ(topology.get_nodes().size(), 1U);
+  EXPECT_GE(topology.get_num_cpus(), 1);
+  EXPECT_GE(ppc::core::NumaTopology::instance().get_num_cpus(), 1);
+}
+
+TEST(numa_tests, check_pinning_policy_names) {
+  using ppc::core::PinningPolicy;
+  for (auto policy : {PinningPolicy::NONE, PinningPolicy::COMPACT, PinningPolicy::SCATTER}) {
+    EXPECT_EQ(ppc::core::parse_pinning_policy(ppc::core::get_pinning_policy_name(policy)), policy);
+  }
+  EXPECT_THROW(ppc::core::parse_pinning_policy("spread"), std::invalid_argument);
+}
+
+TEST(numa_tests, check_pinning_scope) {
+  auto prev_policy = ppc::core::get_pinning_policy();
+  auto prev_epoch = ppc::core::get_pinning_epoch();
+#ifdef __linux__
+  auto prev_num_cpus = get_num_allowed_cpus();
+#endif
+  {
+    ppc::core::PinningScope scope(ppc::core::PinningPolicy::COMPACT);
+    EXPECT_EQ(ppc::core::get_pinning_policy(), ppc::core::PinningPolicy::COMPACT);
+#ifdef __linux__
+    // the calling thread and threads started by it keep their affinity
+    EXPECT_EQ(get_num_allowed_cpus(), prev_num_cpus);
+    int thread_cpus = 0;
+    std::thread([&] { thread_cpus = get_num_allowed_cpus(); }).join();
+    EXPECT_EQ(thread_cpus, prev_num_cpus);
+
+#ifdef _OPENMP
+    // other threads of OpenMP are pinned
+    int pinned_threads = 0;
+#pragma omp parallel num_threads(omp_get_max_threads()) reduction(+ : pinned_threads)
+    pinned_threads += omp_get_thread_num() != 0 && get_num_allowed_cpus() == 1 ? 1 : 0;
+    EXPECT_EQ(pinned_threads, omp_get_max_threads() - 1);
+#endif
+
+    // workers of the pool pin themselves before the next job
+    int worker_cpus = 0;
+    ppc::core::TaskGroup group;
+    group.run([&] { worker_cpus = get_num_allowed_cpus(); });
+    group.wait();
+    EXPECT_EQ(worker_cpus, 1);
+#endif
+  }
+  EXPECT_EQ(ppc::core::get_pinning_policy(), prev_policy);
+  EXPECT_GT(ppc::core::get_pinning_epoch(), prev_epoch);
+#ifdef __linux__
+  // affinity of the process is restored by NONE policy
+  if (prev_policy == ppc::core::PinningPolicy::NONE) {
+    EXPECT_EQ(get_num_allowed_cpus(), prev_num_cpus);
+  }
+#endif
+}
+
+TEST(numa_tests, check_numa_vector) {
+  std::vector<int> source(10007);
+  for (size_t i = 0; i < source.size(); i++) source[i] = static_cast<int>(i);
+
+  auto copy = ppc::core::make_numa_vector(source.data(), source.size());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), source.begin(), source.end()));
+
+  auto filled = ppc::core::make_numa_vector<double>(1001, 2.5);
+  EXPECT_EQ(filled.size(), 1001U);
+  EXPECT_TRUE(std::all_of(filled.begin(), filled.end(), [](double value) { return value == 2.5; }));
+
+  // values passed to the container are still constructed
+  ppc::core::numa_vector<int> values(3, 7);
+  EXPECT_EQ(values, ppc::core::numa_vector<int>({7, 7, 7}));
+}
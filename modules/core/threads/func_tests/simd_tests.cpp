@@ -0,0 +1,24 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "core/threads/include/simd.hpp"
+
+TEST(simd_tests, check_simd_level_names) {
+  for (auto level : {ppc::core::SimdLevel::SCALAR, ppc::core::SimdLevel::SSE4_1, ppc::core::SimdLevel::AVX2,
+                     ppc::core::SimdLevel::AVX512}) {
+    EXPECT_EQ(ppc::core::parse_simd_level(ppc::core::get_simd_level_name(level)), level);
+  }
+  EXPECT_THROW(ppc::core::parse_simd_level("neon"), std::invalid_argument);
+}
+
+TEST(simd_tests, check_simd_level_is_limited_by_cpu) {
+  auto saved = ppc::core::get_simd_level();
+  EXPECT_LE(saved, ppc::core::get_cpu_simd_level());
+  ppc::core::set_simd_level(ppc::core::SimdLevel::AVX512);
+  EXPECT_EQ(ppc::core::get_simd_level(), ppc::core::get_cpu_simd_level());
+  ppc::core::set_simd_level(ppc::core::SimdLevel::SCALAR);
+  EXPECT_EQ(ppc::core::get_simd_level(), ppc::core::SimdLevel::SCALAR);
+  ppc::core::set_simd_level(saved);
+}
@@ -0,0 +1,86 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "core/threads/include/thread_pool.hpp"
+
+TEST(thread_pool_tests, check_task_group) {
+  ppc::core::ThreadPool pool(3);
+  std::atomic<int> counter(0);
+  ppc::core::TaskGroup group(pool);
+  for (int i = 0; i < 100; i++) {
+    group.run([&] { counter++; });
+  }
+  group.wait();
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(thread_pool_tests, check_nested_task_groups) {
+  ppc::core::ThreadPool pool(2);
+  std::atomic<int> counter(0);
+  ppc::core::TaskGroup group(pool);
+  for (int i = 0; i < 8; i++) {
+    group.run([&] {
+      // waiting inside a job of the pool must not deadlock
+      ppc::core::TaskGroup nested(pool);
+      for (int j = 0; j < 8; j++) {
+        nested.run([&] { counter++; });
+      }
+      nested.wait();
+    });
+  }
+  group.wait();
+  EXPECT_EQ(counter.load(), 64);
+}
+
+TEST(thread_pool_tests, check_exception_of_job) {
+  ppc::core::ThreadPool pool(2);
+  ppc::core::TaskGroup group(pool);
+  group.run([] { throw std::runtime_error("job failed"); });
+  group.run([] {});
+  EXPECT_THROW(group.wait(), std::runtime_error);
+}
+
+TEST(thread_pool_tests, check_parallel_for) {
+  ppc::core::set_num_threads(4);
+  std::vector<int> values(1001, 0);
+  ppc::core::parallel_for<size_t>(0, values.size(), [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      values[i] += static_cast<int>(i);
+    }
+  });
+  ppc::core::set_num_threads(0);
+  for (size_t i = 0; i < values.size(); i++) {
+    ASSERT_EQ(values[i], static_cast<int>(i));
+  }
+}
+
+TEST(thread_pool_tests, check_parallel_for_grain) {
+  ppc::core::set_num_threads(8);
+  std::atomic<int> num_chunks(0);
+  ppc::core::parallel_for(0, 10, [&](int begin, int end) {
+    EXPECT_GE(end - begin, 4);
+    num_chunks++;
+  }, 4);
+  ppc::core::set_num_threads(0);
+  EXPECT_EQ(num_chunks.load(), 2);
+}
+
+TEST(thread_pool_tests, check_parallel_reduce) {
+  ppc::core::set_num_threads(3);
+  std::vector<int64_t> values(12345);
+  std::iota(values.begin(), values.end(), 1);
+  auto sum = ppc::core::parallel_reduce<size_t, int64_t>(
+      0, values.size(), 0,
+      [&](size_t begin, size_t end, int64_t init) {
+        return std::accumulate(values.begin() + begin, values.begin() + end, init);
+      },
+      [](int64_t a, int64_t b) { return a + b; });
+  ppc::core::set_num_threads(0);
+  EXPECT_EQ(sum, int64_t{12345} * 12346 / 2);
+}
@@ -0,0 +1,43 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "core/threads/include/threads.hpp"
+
+TEST(threads_tests, check_default_num_threads) {
+  ppc::core::set_num_threads(0);
+  ASSERT_GE(ppc::core::get_num_threads(), 1);
+  if (std::thread::hardware_concurrency() > 0) {
+    EXPECT_EQ(ppc::core::get_num_threads(), static_cast<int>(std::thread::hardware_concurrency()));
+  }
+}
+
+TEST(threads_tests, check_set_num_threads) {
+  ppc::core::set_num_threads(3);
+  EXPECT_EQ(ppc::core::get_num_threads(), 3);
+  ppc::core::set_num_threads(-1);
+  EXPECT_GE(ppc::core::get_num_threads(), 1);
+  ppc::core::set_num_threads(0);
+}
+
+TEST(threads_tests, check_threads_limit) {
+  ppc::core::set_num_threads(4);
+  {
+    ppc::core::ThreadsLimit limit(1);
+    EXPECT_EQ(ppc::core::get_num_threads(), 1);
+    {
+      ppc::core::ThreadsLimit nested_limit(2);
+      EXPECT_EQ(ppc::core::get_num_threads(), 2);
+    }
+    EXPECT_EQ(ppc::core::get_num_threads(), 1);
+
+    // limit is applied to the current thread only
+    int other_num_threads = 0;
+    std::thread other([&] { other_num_threads = ppc::core::get_num_threads(); });
+    other.join();
+    EXPECT_EQ(other_num_threads, 4);
+  }
+  EXPECT_EQ(ppc::core::get_num_threads(), 4);
+  ppc::core::set_num_threads(0);
+}
@@ -0,0 +1,166 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_THREADS_INCLUDE_NUMA_HPP_
+#define MODULES_CORE_THREADS_INCLUDE_NUMA_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/threads/include/thread_pool.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace ppc::core {
+
+// Placement of threads of parallel regions on CPUs: thread i of a region
+// (the calling thread is thread 0) is pinned to the i-th CPU of the order.
+// COMPACT fills NUMA nodes one by one, SCATTER takes CPUs of the nodes in
+// round robin order, NONE keeps the affinity of the process
+enum class PinningPolicy { NONE, COMPACT, SCATTER };
+
+std::string get_pinning_policy_name(PinningPolicy policy);
+// "none", "compact" or "scatter", throws std::invalid_argument otherwise
+PinningPolicy parse_pinning_policy(const std::string& name);
+
+struct NumaNode {
+  int id = 0;
+  std::vector<int> cpus;
+};
+
+// NUMA nodes of the machine and their CPUs
+class NumaTopology {
+ public:
+  // Read nodes from <sysfs_root>/node<N>/cpulist, a machine without the
+  // directory (or not Linux) is one node with hardware_concurrency() CPUs
+  explicit NumaTopology(const std::string& sysfs_root = "/sys/devices/system/node");
+
+  // Topology of the machine, discovered on first use
+  static const NumaTopology& instance();
+
+  // Parse sysfs CPU list like "0-3,8-11"
+  static std::vector<int> parse_cpu_list(const std::string& list);
+
+  [[nodiscard]] const std::vector<NumaNode>& get_nodes() const { return nodes; }
+  [[nodiscard]] int get_num_cpus() const;
+  // -1 for unknown CPU
+  [[nodiscard]] int get_node_of_cpu(int cpu) const;
+  // CPUs in the order threads are pinned to them, empty for NONE
+  [[nodiscard]] std::vector<int> get_cpu_order(PinningPolicy policy) const;
+
+ private:
+  std::vector<NumaNode> nodes;
+};
+
+// Policy of the process, initially taken from PPC_PINNING environment
+// variable. OpenMP threads are pinned at once, workers of ThreadPool before
+// their next job; TBB tasks apply it with TbbPinningObserver. The calling
+// thread keeps its affinity, so threads started by it aren't confined to
+// one CPU
+PinningPolicy get_pinning_policy();
+void set_pinning_policy(PinningPolicy policy);
+// changed on every set_pinning_policy, for threads which pin themselves lazily
+uint64_t get_pinning_epoch();
+
+// Pin the calling thread as thread_index of a parallel region by the current
+// policy, returns false if pinning is not supported
+bool pin_current_thread(int thread_index);
+
+// Set pinning policy while the object is alive, e.g. for one Perf run
+class PinningScope {
+ public:
+  explicit PinningScope(PinningPolicy policy);
+  PinningScope(const PinningScope&) = delete;
+  PinningScope& operator=(const PinningScope&) = delete;
+  ~PinningScope();
+
+ private:
+  PinningPolicy prev_policy;
+};
+
+// Allocator which leaves elements of trivial types uninitialized, so pages
+// of the buffer are not touched by the allocating thread
+template <class T>
+struct FirstTouchAllocator {
+  using value_type = T;
+
+  FirstTouchAllocator() = default;
+  template <class U>
+  FirstTouchAllocator(const FirstTouchAllocator<U>& /*other*/) {}  // NOLINT(google-explicit-constructor)
+
+  T* allocate(size_t count) { return std::allocator<T>().allocate(count); }
+  void deallocate(T* data, size_t count) { std::allocator<T>().deallocate(data, count); }
+
+  template <class U, class... Args>
+  void construct(U* data, Args&&... args) {
+    if constexpr (sizeof...(Args) == 0) {
+      ::new (static_cast<void*>(data)) U;
+    } else {
+      ::new (static_cast<void*>(data)) U(std::forward<Args>(args)...);
+    }
+  }
+
+  template <class U>
+  struct rebind {
+    using other = FirstTouchAllocator<U>;
+  };
+
+  bool operator==(const FirstTouchAllocator& /*other*/) const { return true; }
+};
+
+// Buffer for data of memory-bound kernels: first written by parallel
+// first_touch_* helpers, so with first-touch page placement of the OS every
+// part of it lives on the node of the thread which processes it
+template <class T>
+using numa_vector = std::vector<T, FirstTouchAllocator<T>>;
+
+// Call body(chunk_begin, chunk_end) for get_num_threads() contiguous chunks
+// of [0, size) in the static order of OpenMP loops (chunk i on thread i),
+// which is the order parallel loops of kernels usually process data
+template <class Body>
+void first_touch_for(size_t size, const Body& body) {
+#ifdef _OPENMP
+  auto num_chunks = static_cast<int>(get_num_chunks(size, 1));
+#pragma omp parallel for schedule(static, 1) num_threads(num_chunks)
+  for (int chunk = 0; chunk < num_chunks; chunk++) {
+    auto index = static_cast<size_t>(chunk);
+    auto count = static_cast<size_t>(num_chunks);
+    body(index * size / count, (index + 1) * size / count);
+  }
+#else
+  parallel_for<size_t>(0, size, body);
+#endif
+}
+
+template <class T>
+void first_touch_fill(T* data, size_t count, const T& value) {
+  first_touch_for(count, [&](size_t begin, size_t end) { std::fill(data + begin, data + end, value); });
+}
+
+template <class T>
+void first_touch_copy(const T* source, size_t count, T* data) {
+  first_touch_for(count, [&](size_t begin, size_t end) { std::copy(source + begin, source + end, data + begin); });
+}
+
+template <class T>
+numa_vector<T> make_numa_vector(size_t count, const T& value = T()) {
+  numa_vector<T> result(count);
+  first_touch_fill(result.data(), count, value);
+  return result;
+}
+
+// Copy of input buffer (e.g. of TaskData) placed on the nodes of its readers
+template <class T>
+numa_vector<T> make_numa_vector(const T* source, size_t count) {
+  numa_vector<T> result(count);
+  first_touch_copy(source, count, result.data());
+  return result;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_THREADS_INCLUDE_NUMA_HPP_
@@ -0,0 +1,28 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_THREADS_INCLUDE_SIMD_HPP_
+#define MODULES_CORE_THREADS_INCLUDE_SIMD_HPP_
+
+#include <string>
+
+namespace ppc::core {
+
+// Instruction sets of the vectorized kernels of the core (sorting, SpMV,
+// roofline probes), in increasing order. Kernels are built for all of them
+// and the one used is chosen at run time
+enum class SimdLevel { SCALAR, SSE4_1, AVX2, AVX512 };
+
+std::string get_simd_level_name(SimdLevel level);
+// "scalar", "sse4.1", "avx2" or "avx512", throws std::invalid_argument otherwise
+SimdLevel parse_simd_level(const std::string& name);
+
+// The best level supported by the CPU and the OS
+SimdLevel get_cpu_simd_level();
+// Level of the kernels, initially taken from PPC_SIMD environment variable
+// (the CPU level if it isn't set). Levels above the CPU one are lowered to it
+SimdLevel get_simd_level();
+void set_simd_level(SimdLevel level);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_THREADS_INCLUDE_SIMD_HPP_
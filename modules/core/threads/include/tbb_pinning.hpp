@@ -0,0 +1,40 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_THREADS_INCLUDE_TBB_PINNING_HPP_
+#define MODULES_CORE_THREADS_INCLUDE_TBB_PINNING_HPP_
+
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/task_scheduler_observer.h>
+
+#include <cstdint>
+
+#include "core/threads/include/numa.hpp"
+
+namespace ppc::core {
+
+// Pins threads of TBB by the current pinning policy when they enter the
+// arena, slot i of the arena is thread i of the policy. Header-only, the core
+// library doesn't depend on TBB; TBB tasks keep the object alive while they
+// run (e.g. as a member)
+class TbbPinningObserver : public oneapi::tbb::task_scheduler_observer {
+ public:
+  TbbPinningObserver() { observe(true); }
+  TbbPinningObserver(const TbbPinningObserver&) = delete;
+  TbbPinningObserver& operator=(const TbbPinningObserver&) = delete;
+  ~TbbPinningObserver() override { observe(false); }
+
+  void on_scheduler_entry(bool /*is_worker*/) override {
+    thread_local uint64_t pinning_epoch = 0;
+    thread_local int thread_index = -1;
+    auto index = oneapi::tbb::this_task_arena::current_thread_index();
+    if (pinning_epoch != get_pinning_epoch() || thread_index != index) {
+      pinning_epoch = get_pinning_epoch();
+      thread_index = index;
+      pin_current_thread(index);
+    }
+  }
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_THREADS_INCLUDE_TBB_PINNING_HPP_
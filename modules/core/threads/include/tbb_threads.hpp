@@ -0,0 +1,40 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_THREADS_INCLUDE_TBB_THREADS_HPP_
+#define MODULES_CORE_THREADS_INCLUDE_TBB_THREADS_HPP_
+
+#include <oneapi/tbb/global_control.h>
+#include <oneapi/tbb/task_arena.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "core/threads/include/threads.hpp"
+
+namespace ppc::core {
+
+// Thread count of TBB tasks, for ScalingAttr::apply_num_threads of their
+// sweeps: TBB ignores set_num_threads, so its parallelism is limited by
+// tbb::global_control while the returned object is alive. Header-only like
+// TbbPinningObserver
+inline std::shared_ptr<void> apply_tbb_num_threads(int num_threads) {
+  using oneapi::tbb::global_control;
+  set_num_threads(num_threads);
+  auto* control = new global_control(global_control::max_allowed_parallelism, std::max(1, num_threads));
+  return std::shared_ptr<void>(control, [](void* object) {
+    delete static_cast<global_control*>(object);
+    set_num_threads(0);
+  });
+}
+
+// Threads TBB runs parallel algorithms of the calling thread with, for
+// ScalingAttr::get_num_threads. Counts above the concurrency of the arena
+// aren't reached, sweeps over them throw
+inline int get_tbb_num_threads() {
+  auto limit = oneapi::tbb::global_control::active_value(oneapi::tbb::global_control::max_allowed_parallelism);
+  return std::min(static_cast<int>(limit), oneapi::tbb::this_task_arena::max_concurrency());
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_THREADS_INCLUDE_TBB_THREADS_HPP_
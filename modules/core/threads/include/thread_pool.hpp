@@ -0,0 +1,140 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_THREADS_INCLUDE_THREAD_POOL_HPP_
+#define MODULES_CORE_THREADS_INCLUDE_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/threads/include/threads.hpp"
+
+namespace ppc::core {
+
+// Persistent work-stealing pool: every worker has its own deque, takes jobs
+// from its back and steals from the front of other deques when it is empty.
+// Threads are created once, so parallel algorithms of STL tasks don't pay
+// for thread startup on every run()
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_workers);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // Shared pool of the process, created on first use with enough workers for
+  // get_num_threads() threads together with the calling one
+  static ThreadPool& instance();
+
+  [[nodiscard]] int size() const { return static_cast<int>(workers.size()); }
+
+  // Queue job to the deque of the current worker or to one of the deques
+  // in round robin order if it is called outside of the pool
+  void submit(std::function<void()> job);
+  // Take one queued job and run it on the calling thread, returns false if
+  // there is no job. Used by threads which wait for results to help the pool
+  bool try_run_one();
+
+ private:
+  struct Queue {
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  std::atomic<size_t> num_queued{0};
+  std::atomic<size_t> next_queue{0};
+  std::atomic<bool> stop{false};
+  std::mutex sleep_mutex;
+  std::condition_variable wake;
+
+  bool pop(size_t index, std::function<void()>& job);
+  void worker_loop(size_t index);
+};
+
+// Set of jobs which are waited together. wait() runs queued jobs of the pool
+// instead of blocking, so groups may be nested inside jobs of other groups
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool& pool_ = ThreadPool::instance()) : pool(pool_) {}
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+  ~TaskGroup();
+
+  void run(std::function<void()> job);
+  // Wait for all jobs of the group, rethrows the first exception of them
+  void wait();
+
+ private:
+  ThreadPool& pool;
+  std::atomic<size_t> num_pending{0};
+  std::mutex error_mutex;
+  std::exception_ptr error;
+};
+
+// Number of chunks of parallel algorithms: one per thread, but not smaller
+// than grain elements
+inline size_t get_num_chunks(size_t size, size_t grain) {
+  return std::max<size_t>(1, std::min(static_cast<size_t>(get_num_threads()), size / grain));
+}
+
+// Call body(chunk_begin, chunk_end) for at most get_num_threads() chunks of
+// [begin, end), every chunk has at least grain elements
+template <class Index, class Body>
+void parallel_for(Index begin, Index end, const Body& body, Index grain = 1) {
+  if (end <= begin) return;
+  auto size = static_cast<size_t>(end - begin);
+  auto num_chunks = get_num_chunks(size, static_cast<size_t>(std::max<Index>(grain, 1)));
+  if (num_chunks <= 1) {
+    body(begin, end);
+    return;
+  }
+
+  // declared before the group: if body throws on chunk 0, the destructor of
+  // the group waits for queued chunks which still call it
+  auto chunk_begin = [&](size_t chunk) { return begin + static_cast<Index>(chunk * size / num_chunks); };
+  TaskGroup group;
+  for (size_t chunk = 1; chunk < num_chunks; chunk++) {
+    group.run([&, chunk] { body(chunk_begin(chunk), chunk_begin(chunk + 1)); });
+  }
+  body(chunk_begin(0), chunk_begin(1));
+  group.wait();
+}
+
+// Reduce chunks of [begin, end): every chunk is folded with
+// body(chunk_begin, chunk_end, identity) and partial results are combined
+// with reduce in the order of chunks, so the result is deterministic
+template <class Index, class T, class Body, class Reduce>
+T parallel_reduce(Index begin, Index end, T identity, const Body& body, const Reduce& reduce, Index grain = 1) {
+  if (end <= begin) return identity;
+  auto size = static_cast<size_t>(end - begin);
+  auto num_chunks = get_num_chunks(size, static_cast<size_t>(std::max<Index>(grain, 1)));
+  if (num_chunks <= 1) return body(begin, end, identity);
+
+  std::vector<T> partial(num_chunks, identity);
+  parallel_for<size_t>(0, num_chunks, [&](size_t first, size_t last) {
+    for (auto chunk = first; chunk < last; chunk++) {
+      partial[chunk] = body(begin + static_cast<Index>(chunk * size / num_chunks),
+                            begin + static_cast<Index>((chunk + 1) * size / num_chunks), identity);
+    }
+  });
+
+  T result = identity;
+  for (auto& value : partial) {
+    result = reduce(result, value);
+  }
+  return result;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_THREADS_INCLUDE_THREAD_POOL_HPP_
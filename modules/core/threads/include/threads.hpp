@@ -0,0 +1,31 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_THREADS_INCLUDE_THREADS_HPP_
+#define MODULES_CORE_THREADS_INCLUDE_THREADS_HPP_
+
+namespace ppc::core {
+
+// Number of threads which parallel implementations (OpenMP, std::thread)
+// should use. Equal to hardware concurrency unless set_num_threads was called
+int get_num_threads();
+
+// Override number of threads for OpenMP and std::thread implementations,
+// non-positive value restores the default one
+void set_num_threads(int num_threads);
+
+// Limit number of threads of parallel implementations called from the current
+// thread while the object is alive, e.g. for tasks run by workers of a batch
+class ThreadsLimit {
+ public:
+  explicit ThreadsLimit(int num_threads);
+  ThreadsLimit(const ThreadsLimit&) = delete;
+  ThreadsLimit& operator=(const ThreadsLimit&) = delete;
+  ~ThreadsLimit();
+
+ private:
+  int prev_num_threads;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_THREADS_INCLUDE_THREADS_HPP_
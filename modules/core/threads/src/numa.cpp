@@ -0,0 +1,205 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/threads/include/numa.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+ppc::core::PinningPolicy initial_pinning_policy() {
+#ifndef __linux__
+  // threads are pinned only on Linux
+  return ppc::core::PinningPolicy::NONE;
+#else
+  const char* name = std::getenv("PPC_PINNING");
+  if (name == nullptr) return ppc::core::PinningPolicy::NONE;
+  try {
+    return ppc::core::parse_pinning_policy(name);
+  } catch (const std::invalid_argument&) {
+    return ppc::core::PinningPolicy::NONE;
+  }
+#endif
+}
+
+std::atomic<ppc::core::PinningPolicy> pinning_policy{initial_pinning_policy()};
+// threads pinned before the first change of the policy are pinned by the
+// policy of the environment variable, if it is set
+std::atomic<uint64_t> pinning_epoch{pinning_policy.load() == ppc::core::PinningPolicy::NONE ? 0U : 1U};
+
+#ifdef __linux__
+// affinity of the process at startup, restored by NONE policy and used to
+// skip CPUs which are not available to the process (e.g. in containers)
+cpu_set_t get_initial_affinity() {
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, &mask);
+  }
+  return mask;
+}
+
+const cpu_set_t initial_affinity = get_initial_affinity();
+#endif
+
+}  // namespace
+
+std::string ppc::core::get_pinning_policy_name(PinningPolicy policy) {
+  switch (policy) {
+    case PinningPolicy::COMPACT:
+      return "compact";
+    case PinningPolicy::SCATTER:
+      return "scatter";
+    default:
+      return "none";
+  }
+}
+
+ppc::core::PinningPolicy ppc::core::parse_pinning_policy(const std::string& name) {
+  if (name == "none" || name.empty()) return PinningPolicy::NONE;
+  if (name == "compact") return PinningPolicy::COMPACT;
+  if (name == "scatter") return PinningPolicy::SCATTER;
+  throw std::invalid_argument("Unknown pinning policy: " + name);
+}
+
+ppc::core::NumaTopology::NumaTopology(const std::string& sysfs_root) {
+  namespace fs = std::filesystem;
+  std::error_code error;
+  for (fs::directory_iterator it(sysfs_root, error), end; !error && it != end; it.increment(error)) {
+    auto name = it->path().filename().string();
+    if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+        !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+      continue;
+    }
+    std::ifstream cpulist(it->path() / "cpulist");
+    std::string list;
+    std::getline(cpulist, list);
+    auto cpus = parse_cpu_list(list);
+    // memory-only nodes have no CPUs to pin threads to
+    if (!cpus.empty()) nodes.push_back(NumaNode{std::stoi(name.substr(4)), std::move(cpus)});
+  }
+  std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+
+  if (nodes.empty()) {
+    NumaNode node;
+    node.cpus.resize(std::max(1U, std::thread::hardware_concurrency()));
+    for (size_t cpu = 0; cpu < node.cpus.size(); cpu++) node.cpus[cpu] = static_cast<int>(cpu);
+    nodes.push_back(std::move(node));
+  }
+}
+
+const ppc::core::NumaTopology& ppc::core::NumaTopology::instance() {
+  static const NumaTopology topology;
+  return topology;
+}
+
+std::vector<int> ppc::core::NumaTopology::parse_cpu_list(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    range.erase(std::remove_if(range.begin(), range.end(), [](char c) { return std::isspace(c) != 0; }),
+                range.end());
+    if (range.empty()) continue;
+    auto dash = range.find('-');
+    auto first = std::stoi(range.substr(0, dash));
+    auto last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (auto cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+int ppc::core::NumaTopology::get_num_cpus() const {
+  int num_cpus = 0;
+  for (const auto& node : nodes) num_cpus += static_cast<int>(node.cpus.size());
+  return num_cpus;
+}
+
+int ppc::core::NumaTopology::get_node_of_cpu(int cpu) const {
+  for (const auto& node : nodes) {
+    if (std::find(node.cpus.begin(), node.cpus.end(), cpu) != node.cpus.end()) return node.id;
+  }
+  return -1;
+}
+
+std::vector<int> ppc::core::NumaTopology::get_cpu_order(PinningPolicy policy) const {
+  std::vector<int> order;
+  if (policy == PinningPolicy::COMPACT) {
+    for (const auto& node : nodes) order.insert(order.end(), node.cpus.begin(), node.cpus.end());
+  } else if (policy == PinningPolicy::SCATTER) {
+    for (size_t i = 0; order.size() < static_cast<size_t>(get_num_cpus()); i++) {
+      for (const auto& node : nodes) {
+        if (i < node.cpus.size()) order.push_back(node.cpus[i]);
+      }
+    }
+  }
+  return order;
+}
+
+ppc::core::PinningPolicy ppc::core::get_pinning_policy() { return pinning_policy.load(); }
+
+void ppc::core::set_pinning_policy(PinningPolicy policy) {
+  pinning_policy.store(policy);
+  pinning_epoch++;
+
+  // threads of OpenMP are kept between parallel regions, so every thread a
+  // region may get is pinned once here. The calling thread is thread 0 of
+  // them, but it gets its affinity back: threads it starts (std::thread,
+  // workers of TBB without TbbPinningObserver) inherit its mask and would all
+  // run on its one CPU
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  bool has_mask = sched_getaffinity(0, sizeof(mask), &mask) == 0;
+#endif
+#ifdef _OPENMP
+#pragma omp parallel num_threads(omp_get_max_threads())
+  pin_current_thread(omp_get_thread_num());
+#endif
+#ifdef __linux__
+  if (has_mask) sched_setaffinity(0, sizeof(mask), &mask);
+#endif
+}
+
+uint64_t ppc::core::get_pinning_epoch() { return pinning_epoch.load(); }
+
+bool ppc::core::pin_current_thread(int thread_index) {
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  std::vector<int> order;
+  for (auto cpu : NumaTopology::instance().get_cpu_order(get_pinning_policy())) {
+    if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &initial_affinity)) order.push_back(cpu);
+  }
+  if (order.empty()) {
+    mask = initial_affinity;
+  } else {
+    CPU_SET(order[static_cast<size_t>(std::max(thread_index, 0)) % order.size()], &mask);
+  }
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif
+}
+
+ppc::core::PinningScope::PinningScope(PinningPolicy policy) : prev_policy(get_pinning_policy()) {
+  if (policy != prev_policy) set_pinning_policy(policy);
+}
+
+ppc::core::PinningScope::~PinningScope() {
+  if (get_pinning_policy() != prev_policy) set_pinning_policy(prev_policy);
+}
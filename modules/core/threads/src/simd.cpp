@@ -0,0 +1,93 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/threads/include/simd.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PPC_SIMD_X86
+#endif
+
+#if defined(PPC_SIMD_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace {
+
+ppc::core::SimdLevel detect_cpu_simd_level() {
+#if !defined(PPC_SIMD_X86)
+  return ppc::core::SimdLevel::SCALAR;
+#elif defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  int max_leaf = info[0];
+  __cpuid(info, 1);
+  bool sse41 = (info[2] & (1 << 19)) != 0;
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  bool avx = (info[2] & (1 << 28)) != 0;
+  // registers saved by the OS: XMM and YMM for AVX, also opmask and ZMM for AVX-512
+  auto xcr0 = osxsave ? _xgetbv(0) : 0;
+  bool avx2 = false;
+  bool avx512 = false;
+  if (max_leaf >= 7) {
+    __cpuidex(info, 7, 0);
+    avx2 = avx && (xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0;
+    avx512 = (xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0;
+  }
+  if (avx512) return ppc::core::SimdLevel::AVX512;
+  if (avx2) return ppc::core::SimdLevel::AVX2;
+  return sse41 ? ppc::core::SimdLevel::SSE4_1 : ppc::core::SimdLevel::SCALAR;
+#else
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return ppc::core::SimdLevel::AVX512;
+  if (__builtin_cpu_supports("avx2")) return ppc::core::SimdLevel::AVX2;
+  if (__builtin_cpu_supports("sse4.1")) return ppc::core::SimdLevel::SSE4_1;
+  return ppc::core::SimdLevel::SCALAR;
+#endif
+}
+
+const ppc::core::SimdLevel cpu_simd_level = detect_cpu_simd_level();
+
+ppc::core::SimdLevel initial_simd_level() {
+  const char* name = std::getenv("PPC_SIMD");
+  if (name == nullptr) return cpu_simd_level;
+  try {
+    return std::min(ppc::core::parse_simd_level(name), cpu_simd_level);
+  } catch (const std::invalid_argument&) {
+    return cpu_simd_level;
+  }
+}
+
+std::atomic<ppc::core::SimdLevel> simd_level{initial_simd_level()};
+
+}  // namespace
+
+std::string ppc::core::get_simd_level_name(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::SSE4_1:
+      return "sse4.1";
+    case SimdLevel::AVX2:
+      return "avx2";
+    case SimdLevel::AVX512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+ppc::core::SimdLevel ppc::core::parse_simd_level(const std::string& name) {
+  if (name == "scalar") return SimdLevel::SCALAR;
+  if (name == "sse4.1") return SimdLevel::SSE4_1;
+  if (name == "avx2") return SimdLevel::AVX2;
+  if (name == "avx512") return SimdLevel::AVX512;
+  throw std::invalid_argument("Unknown SIMD level: " + name);
+}
+
+ppc::core::SimdLevel ppc::core::get_cpu_simd_level() { return cpu_simd_level; }
+
+ppc::core::SimdLevel ppc::core::get_simd_level() { return simd_level.load(); }
+
+void ppc::core::set_simd_level(SimdLevel level) { simd_level = std::min(level, cpu_simd_level); }
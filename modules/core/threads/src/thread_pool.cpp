@@ -0,0 +1,142 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/threads/include/thread_pool.hpp"
+
+#include <utility>
+
+#include "core/threads/include/numa.hpp"
+
+namespace {
+
+// pool and deque of the current worker thread
+thread_local const ppc::core::ThreadPool* current_pool = nullptr;
+thread_local size_t current_queue = 0;
+
+}  // namespace
+
+ppc::core::ThreadPool::ThreadPool(int num_workers) {
+  auto count = static_cast<size_t>(std::max(1, num_workers));
+  for (size_t i = 0; i < count; i++) {
+    queues.push_back(std::make_unique<Queue>());
+  }
+  for (size_t i = 0; i < count; i++) {
+    workers.emplace_back([this, i] { worker_loop(i); });
+  }
+}
+
+ppc::core::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    stop = true;
+  }
+  wake.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+ppc::core::ThreadPool& ppc::core::ThreadPool::instance() {
+  static ThreadPool pool(std::max(get_num_threads(), static_cast<int>(std::thread::hardware_concurrency())) - 1);
+  return pool;
+}
+
+void ppc::core::ThreadPool::submit(std::function<void()> job) {
+  {
+    // counter is changed under the lock to not miss the wake up of a worker
+    // which is going to sleep
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    num_queued++;
+  }
+  auto index = current_pool == this ? current_queue : next_queue++ % queues.size();
+  {
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    queues[index]->jobs.push_back(std::move(job));
+  }
+  wake.notify_one();
+}
+
+bool ppc::core::ThreadPool::pop(size_t index, std::function<void()>& job) {
+  {
+    // own jobs are taken in LIFO order, they are hot in cache
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    if (!queues[index]->jobs.empty()) {
+      job = std::move(queues[index]->jobs.back());
+      queues[index]->jobs.pop_back();
+      num_queued--;
+      return true;
+    }
+  }
+  for (size_t i = 1; i < queues.size(); i++) {
+    auto& victim = queues[(index + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(victim->mutex);
+    if (!victim->jobs.empty()) {
+      job = std::move(victim->jobs.front());
+      victim->jobs.pop_front();
+      num_queued--;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ppc::core::ThreadPool::try_run_one() {
+  std::function<void()> job;
+  auto index = current_pool == this ? current_queue : next_queue.load() % queues.size();
+  if (!pop(index, job)) return false;
+  job();
+  return true;
+}
+
+void ppc::core::ThreadPool::worker_loop(size_t index) {
+  current_pool = this;
+  current_queue = index;
+  uint64_t pinning_epoch = 0;
+  std::function<void()> job;
+  while (true) {
+    if (pop(index, job)) {
+      // the calling thread of parallel algorithms is thread 0 of the policy
+      if (pinning_epoch != get_pinning_epoch()) {
+        pinning_epoch = get_pinning_epoch();
+        pin_current_thread(static_cast<int>(index) + 1);
+      }
+      job();
+      job = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    wake.wait(lock, [&] { return stop || num_queued > 0; });
+    if (stop) return;
+  }
+}
+
+ppc::core::TaskGroup::~TaskGroup() {
+  try {
+    wait();
+  } catch (...) {
+    // exceptions are reported only by explicit wait()
+  }
+}
+
+void ppc::core::TaskGroup::run(std::function<void()> job) {
+  num_pending++;
+  pool.submit([this, job = std::move(job)] {
+    try {
+      job();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) error = std::current_exception();
+    }
+    num_pending--;
+  });
+}
+
+void ppc::core::TaskGroup::wait() {
+  while (num_pending > 0) {
+    if (!pool.try_run_one()) std::this_thread::yield();
+  }
+  std::exception_ptr group_error;
+  {
+    std::lock_guard<std::mutex> lock(error_mutex);
+    std::swap(group_error, error);
+  }
+  if (group_error) std::rethrow_exception(group_error);
+}
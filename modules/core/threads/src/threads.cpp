@@ -0,0 +1,53 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/threads/include/threads.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+std::atomic<int> num_threads_override{0};
+thread_local int num_threads_limit = 0;
+
+#ifdef _OPENMP
+// keep OMP_NUM_THREADS to restore it on reset
+const int omp_default_num_threads = omp_get_max_threads();
+#endif
+
+int default_num_threads() { return std::max(1, static_cast<int>(std::thread::hardware_concurrency())); }
+
+// OpenMP keeps number of threads per thread, so it is updated for the calling one
+void apply_omp_num_threads() {
+#ifdef _OPENMP
+  auto num_threads = num_threads_limit > 0 ? num_threads_limit : num_threads_override.load();
+  omp_set_num_threads(num_threads > 0 ? num_threads : omp_default_num_threads);
+#endif
+}
+
+}  // namespace
+
+int ppc::core::get_num_threads() {
+  if (num_threads_limit > 0) return num_threads_limit;
+  auto num_threads = num_threads_override.load();
+  return num_threads > 0 ? num_threads : default_num_threads();
+}
+
+void ppc::core::set_num_threads(int num_threads) {
+  num_threads_override.store(std::max(0, num_threads));
+  apply_omp_num_threads();
+}
+
+ppc::core::ThreadsLimit::ThreadsLimit(int num_threads) : prev_num_threads(num_threads_limit) {
+  num_threads_limit = std::max(1, num_threads);
+  apply_omp_num_threads();
+}
+
+ppc::core::ThreadsLimit::~ThreadsLimit() {
+  num_threads_limit = prev_num_threads;
+  apply_omp_num_threads();
+}
@@ -7,8 +7,10 @@
 
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -20,12 +22,8 @@ class AverageOfVectorElements : public ppc::core::Task {
   explicit AverageOfVectorElements(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input without copying
+    input_ = ppc::core::input_view<const InType>(*taskData, 0);
     // Init value for output
     average = 0.0;
     return true;
@@ -51,7 +49,7 @@ class AverageOfVectorElements : public ppc::core::Task {
   }
 
  private:
-  std::vector<InType> input_;
+  std::span<const InType> input_;
   OutType average;
 };
 
@@ -8,8 +8,10 @@
 #include <algorithm>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -21,12 +23,8 @@ class MinOfVectorElements : public ppc::core::Task {
   explicit MinOfVectorElements(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input without copying
+    input_ = ppc::core::input_view<const InOutType>(*taskData, 0);
     // Init value for output
     min = 0.0;
     min_index = 0;
@@ -60,7 +58,7 @@ class MinOfVectorElements : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<const InOutType> input_;
   InOutType min;
   IndexType min_index;
 };
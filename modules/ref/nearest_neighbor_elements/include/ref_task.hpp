@@ -9,8 +9,10 @@
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -22,12 +24,8 @@ class NearestNeighborElements : public ppc::core::Task {
   explicit NearestNeighborElements(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input without copying
+    input_ = ppc::core::input_view<const InOutType>(*taskData, 0);
     // Init value for output
     l_elem = r_elem = 0;
     l_elem_index = r_elem_index = 0;
@@ -42,16 +40,13 @@ class NearestNeighborElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = std::vector<InOutType>(input_.size());
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(),
-                   [](InOutType x, InOutType y) { return std::abs(x - y); });
-
-    auto result = std::min_element(temp_res.begin(), temp_res.end() - 1);
-    l_elem_index = static_cast<IndexType>(std::distance(temp_res.begin(), result));
+    // compare neighbors in place: input_ is a view of the caller's buffer
+    auto diff = [&](size_t i) { return static_cast<InOutType>(std::abs(input_[i] - input_[i + 1])); };
+    size_t result = 0;
+    for (size_t i = 1; i + 1 < input_.size(); i++) {
+      if (diff(i) < diff(result)) result = i;
+    }
+    l_elem_index = static_cast<IndexType>(result);
     l_elem = input_[l_elem_index];
 
     r_elem_index = l_elem_index + 1;
@@ -69,7 +64,7 @@ class NearestNeighborElements : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<const InOutType> input_;
   InOutType l_elem, r_elem;
   IndexType l_elem_index, r_elem_index;
 };
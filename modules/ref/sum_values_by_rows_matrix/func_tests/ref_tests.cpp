@@ -192,3 +192,31 @@ TEST(sum_values_by_rows_matrix, check_float) {
     EXPECT_NEAR(out[i], in_index[1] * (in_index[1] + 1) * (2 * in_index[1] + 1) / 6.f, 1e-6);
   }
 }
+
+TEST(sum_values_by_rows_matrix, check_more_rows_than_cols) {
+  // Create data: sums are kept per row, so they must not be sized by cols
+  std::vector<uint64_t> in_index = {38, 3};
+  std::vector<int32_t> in(in_index[0] * in_index[1]);
+  for (size_t i = 0; i < in.size(); i++) in[i] = static_cast<int32_t>(i / in_index[1]);
+  std::vector<int32_t> out(in_index[0], 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in_index.data()));
+  taskData->inputs_count.emplace_back(in_index.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::reference::SumValuesByRowsMatrix<int32_t, uint64_t> testTask(taskData);
+  bool isValid = testTask.validation();
+  ASSERT_EQ(isValid, true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  for (size_t i = 0; i < in_index[0]; i++) {
+    EXPECT_EQ(out[i], static_cast<int32_t>(3 * i));
+  }
+}
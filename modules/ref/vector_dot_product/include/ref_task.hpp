@@ -5,10 +5,13 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -20,14 +23,9 @@ class VectorDotProduct : public ppc::core::Task {
   explicit VectorDotProduct(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<std::vector<InOutType> >(2);
+    // Init views of inputs without copying
     for (size_t i = 0; i < input_.size(); i++) {
-      input_[i] = std::vector<InOutType>(taskData->inputs_count[i]);
-      auto tmp_ptr_ = reinterpret_cast<InOutType*>(taskData->inputs[i]);
-      for (unsigned j = 0; j < taskData->inputs_count[i]; j++) {
-        input_[i][j] = tmp_ptr_[j];
-      }
+      input_[i] = ppc::core::input_view<const InOutType>(*taskData, i);
     }
 
     // Init value for output
@@ -54,7 +52,7 @@ class VectorDotProduct : public ppc::core::Task {
   }
 
  private:
-  std::vector<std::vector<InOutType> > input_;
+  std::array<std::span<const InOutType>, 2> input_;
   InOutType dor_product;
 };
 
@@ -1,11 +1,12 @@
 import argparse
+import json
 import os
 import re
 import xlsxwriter
 import multiprocessing
 
 parser = argparse.ArgumentParser()
-parser.add_argument('-i', '--input', help='Input file path (logs of perf tests, .txt)', required=True)
+parser.add_argument('-i', '--input', help='Input file path (logs of perf tests, .txt, or PPC_PERF_OUTPUT records, .jsonl)', required=True)
 parser.add_argument('-o', '--output', help='Output file path (path to .xlsx table)', required=True)
 args = parser.parse_args()
 logs_path = os.path.abspath(args.input)
@@ -18,10 +19,14 @@ set_of_task_name = []
 
 logs_file = open(logs_path, "r")
 logs_lines = logs_file.readlines()
+if logs_path.endswith(".jsonl"):
+    # records of Perf::print_perf_statistic are converted to lines of the log
+    records = [json.loads(line) for line in logs_lines if line.strip()]
+    logs_lines = [record["task"] + ":" + record["type"] + ":" + "%.10f" % record["time_sec"] for record in records]
 for line in logs_lines:
     pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
     result = re.findall(pattern, line)
-    if len(result):
+    if len(result) and result[0][2] in result_tables:
         task_name = result[0][1]
         perf_type = result[0][2]
         set_of_task_name.append(task_name)
@@ -33,13 +38,41 @@ for line in logs_lines:
 for line in logs_lines:
     pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
     result = re.findall(pattern, line)
-    if len(result):
+    if len(result) and result[0][2] in result_tables:
         task_type = result[0][0]
         task_name = result[0][1]
         perf_type = result[0][2]
         perf_time = float(result[0][3])
         result_tables[perf_type][task_name][task_type] = perf_time
 
+# lines of Perf::print_perf_statistic in scaling mode:
+# tasks/<type>/<name>:<perf_type>_<strong|weak>_scaling:<threads>:<time>:<speedup>:<efficiency>
+scaling_tables = {}
+for line in logs_lines:
+    pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*_scaling):(\d+):(-*\d*\.\d*):(-*\d*\.\d*):(-*\d*\.\d*)'
+    result = re.findall(pattern, line)
+    if len(result):
+        task_type, task_name, scaling_type = result[0][0], result[0][1], result[0][2]
+        num_threads = int(result[0][3])
+        point = [float(result[0][4]), float(result[0][5]), float(result[0][6])]
+        scaling_tables.setdefault(scaling_type, {}).setdefault(task_type + "/" + task_name, {})[num_threads] = point
+
+# lines of Perf::print_sweep_statistic:
+# tasks/<type>/<name>:roofline:<peak_gflops>:<bandwidth_gbs>
+# tasks/<type>/<name>:<perf_type>_sweep:<size>:<time>:<gflops>:<gbs>:<intensity>:<attainable_gflops>
+sweep_tables = {}
+roofline = None
+for line in logs_lines:
+    result = re.findall(r'tasks[\/|\\](\w*)[\/|\\](\w*):roofline:(-*\d*\.\d*):(-*\d*\.\d*)', line)
+    if len(result):
+        roofline = [float(result[0][2]), float(result[0][3])]
+    pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*_sweep):(\d+)' + r':(-*\d*\.\d*)' * 5
+    result = re.findall(pattern, line)
+    if len(result):
+        task_type, task_name, sweep_type = result[0][0], result[0][1], result[0][2]
+        point = [float(value) for value in result[0][4:]]
+        sweep_tables.setdefault(sweep_type, {}).setdefault(task_type + "/" + task_name, {})[int(result[0][3])] = point
+
 
 for table_name in result_tables:
     workbook = xlsxwriter.Workbook(os.path.join(xlsx_path, table_name + '_perf_table.xlsx'))
@@ -85,3 +118,87 @@ for table_name in result_tables:
         it_i = 1
         it_j += 1
     workbook.close()
+
+for table_name in scaling_tables:
+    workbook = xlsxwriter.Workbook(os.path.join(xlsx_path, table_name + '_perf_table.xlsx'))
+    worksheet = workbook.add_worksheet()
+    worksheet.set_column('A:Z', 23)
+    right_bold_border = workbook.add_format({'bold': True, 'right': 2, 'bottom': 2})
+    bottom_bold_border = workbook.add_format({'bold': True, 'bottom': 2})
+    right_border = workbook.add_format({'right': 2})
+    list_of_num_threads = sorted(set(num_threads for task in scaling_tables[table_name].values() for num_threads in task))
+    worksheet.write(0, 0, table_name, right_bold_border)
+
+    it = 1
+    for num_threads in list_of_num_threads:
+        worksheet.write(0, it, "T(" + str(num_threads) + ")", bottom_bold_border)
+        worksheet.write(0, it + 1, "S(" + str(num_threads) + ")", bottom_bold_border)
+        worksheet.write(0, it + 2, "Eff(" + str(num_threads) + ")", right_bold_border)
+        it += 3
+
+    it_j = 1
+    for task_name in sorted(scaling_tables[table_name]):
+        worksheet.write(it_j, 0, task_name, workbook.add_format({'bold': True, 'right': 2}))
+        it_i = 1
+        for num_threads in list_of_num_threads:
+            point = scaling_tables[table_name][task_name].get(num_threads, [-1.0, -1.0, -1.0])
+            worksheet.write(it_j, it_i, point[0])
+            worksheet.write(it_j, it_i + 1, point[1])
+            worksheet.write(it_j, it_i + 2, point[2], right_border)
+            it_i += 3
+        it_j += 1
+    workbook.close()
+
+for table_name in sweep_tables:
+    workbook = xlsxwriter.Workbook(os.path.join(xlsx_path, table_name + '_perf_table.xlsx'))
+    worksheet = workbook.add_worksheet()
+    worksheet.set_column('A:Z', 23)
+    bottom_bold_border = workbook.add_format({'bold': True, 'bottom': 2})
+    chart = workbook.add_chart({'type': 'scatter', 'subtype': 'straight_with_markers'})
+
+    it_j = 0
+    for task_name in sorted(sweep_tables[table_name]):
+        worksheet.write(it_j, 0, task_name, workbook.add_format({'bold': True}))
+        it_j += 1
+        for it_i, header in enumerate(["Size", "T", "GFLOP/s", "GB/s", "FLOP/byte", "Attainable GFLOP/s"]):
+            worksheet.write(it_j, it_i, header, bottom_bold_border)
+        first_row = it_j + 1
+        for size in sorted(sweep_tables[table_name][task_name]):
+            it_j += 1
+            worksheet.write(it_j, 0, size)
+            for it_i, value in enumerate(sweep_tables[table_name][task_name][size]):
+                worksheet.write(it_j, it_i + 1, value)
+        # measured points on the roofline plot: GFLOP/s by arithmetic intensity
+        chart.add_series({'name': task_name,
+                          'categories': [worksheet.name, first_row, 4, it_j, 4],
+                          'values': [worksheet.name, first_row, 2, it_j, 2]})
+        it_j += 2
+
+    if roofline is not None and roofline[0] > 0.0 and roofline[1] > 0.0:
+        peak_gflops, bandwidth_gbs = roofline
+        worksheet.write(it_j, 0, "Roofline", workbook.add_format({'bold': True}))
+        worksheet.write(it_j + 1, 0, "Peak GFLOP/s", bottom_bold_border)
+        worksheet.write(it_j + 1, 1, "Bandwidth GB/s", bottom_bold_border)
+        worksheet.write(it_j + 2, 0, peak_gflops)
+        worksheet.write(it_j + 2, 1, bandwidth_gbs)
+        it_j += 4
+        worksheet.write(it_j, 0, "FLOP/byte", bottom_bold_border)
+        worksheet.write(it_j, 1, "Attainable GFLOP/s", bottom_bold_border)
+        # bandwidth slope up to the ridge point and flat peak after it
+        ridge = peak_gflops / bandwidth_gbs
+        intensities = [ridge / 1024.0, ridge, ridge * 64.0]
+        for intensity in intensities:
+            it_j += 1
+            worksheet.write(it_j, 0, intensity)
+            worksheet.write(it_j, 1, min(peak_gflops, bandwidth_gbs * intensity))
+        chart.add_series({'name': 'roofline',
+                          'categories': [worksheet.name, it_j - len(intensities) + 1, 0, it_j, 0],
+                          'values': [worksheet.name, it_j - len(intensities) + 1, 1, it_j, 1],
+                          'marker': {'type': 'none'}})
+
+    chart.set_title({'name': table_name})
+    chart.set_x_axis({'name': 'FLOP/byte', 'log_base': 10})
+    chart.set_y_axis({'name': 'GFLOP/s', 'log_base': 10})
+    chart.set_size({'width': 960, 'height': 600})
+    worksheet.insert_chart(0, 7, chart)
+    workbook.close()
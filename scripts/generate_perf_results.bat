@@ -1,4 +1,7 @@
 @echo off
 mkdir build\perf_stat_dir
+if exist build\perf_stat_dir\perf_results.jsonl del build\perf_stat_dir\perf_results.jsonl
+set PPC_PERF_OUTPUT=build\perf_stat_dir\perf_results.jsonl
 scripts\run_perf_collector.bat > build\perf_stat_dir\perf_log.txt
 python scripts\create_perf_table.py --input build\perf_stat_dir\perf_log.txt --output build\perf_stat_dir
+python scripts\perf_db.py import --input build\perf_stat_dir\perf_results.jsonl
@@ -1,3 +1,6 @@
 mkdir build/perf_stat_dir
+rm -f build/perf_stat_dir/perf_results.jsonl
+export PPC_PERF_OUTPUT=build/perf_stat_dir/perf_results.jsonl
 source scripts/run_perf_collector.sh | tee build/perf_stat_dir/perf_log.txt
 python3 scripts/create_perf_table.py --input build/perf_stat_dir/perf_log.txt --output build/perf_stat_dir
+python3 scripts/perf_db.py import --input build/perf_stat_dir/perf_results.jsonl
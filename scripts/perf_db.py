@@ -0,0 +1,175 @@
+import argparse
+import json
+import math
+import os
+import sqlite3
+import subprocess
+import sys
+import time
+
+# Benchmark history: records of Perf (PPC_PERF_OUTPUT, .jsonl) are imported as
+# runs keyed by git revision, results of two runs are compared with the
+# Mann-Whitney U test on per-iteration samples.
+#
+#   python3 scripts/perf_db.py import -i build/perf_stat_dir/perf_results.jsonl
+#   python3 scripts/perf_db.py list
+#   python3 scripts/perf_db.py compare --base <rev|run id> --head <rev|run id>
+
+default_db_path = os.path.join("build", "perf_stat_dir", "perf_results.db")
+
+# results are matched between runs by these fields
+key_fields = ["task", "backend", "type", "num_threads", "problem_size"]
+
+
+def open_db(db_path):
+    os.makedirs(os.path.dirname(os.path.abspath(db_path)), exist_ok=True)
+    db = sqlite3.connect(db_path)
+    db.execute("CREATE TABLE IF NOT EXISTS runs ("
+               "id INTEGER PRIMARY KEY AUTOINCREMENT, git_rev TEXT, timestamp INTEGER, label TEXT)")
+    db.execute("CREATE TABLE IF NOT EXISTS results ("
+               "run_id INTEGER REFERENCES runs(id), task TEXT, backend TEXT, type TEXT, num_threads INTEGER, "
+               "problem_size INTEGER, time_sec REAL, median_sec REAL, mean_sec REAL, stddev_sec REAL, "
+               "samples TEXT, record TEXT)")
+    db.execute("CREATE INDEX IF NOT EXISTS results_key ON results (task, backend, type, num_threads, problem_size)")
+    return db
+
+
+def get_git_rev():
+    try:
+        rev = subprocess.check_output(["git", "rev-parse", "--short", "HEAD"], text=True).strip()
+        dirty = subprocess.check_output(["git", "status", "--porcelain", "--untracked-files=no"], text=True).strip()
+        return rev + ("-dirty" if dirty else "")
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def import_records(db, input_path, git_rev, label):
+    with open(input_path, "r") as input_file:
+        records = [json.loads(line) for line in input_file if line.strip()]
+    cursor = db.execute("INSERT INTO runs (git_rev, timestamp, label) VALUES (?, ?, ?)",
+                        (git_rev, int(time.time()), label))
+    run_id = cursor.lastrowid
+    for record in records:
+        db.execute("INSERT INTO results VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+                   (run_id, record["task"], record.get("backend", ""), record["type"], record.get("num_threads", 0),
+                    record.get("problem_size", 0), record["time_sec"], record.get("median_sec", 0.0),
+                    record.get("mean_sec", 0.0), record.get("stddev_sec", 0.0), json.dumps(record.get("samples", [])),
+                    json.dumps(record)))
+    db.commit()
+    print("Imported %d records as run %d (%s)" % (len(records), run_id, git_rev))
+
+
+def find_run(db, run):
+    # run id or the last run of a git revision
+    if run.isdigit():
+        row = db.execute("SELECT id FROM runs WHERE id = ?", (int(run),)).fetchone()
+    else:
+        row = db.execute("SELECT id FROM runs WHERE git_rev = ? OR git_rev LIKE ? ORDER BY id DESC LIMIT 1",
+                         (run, run + "%")).fetchone()
+    if row is None:
+        sys.exit("Run is not found: " + run)
+    return row[0]
+
+
+def load_results(db, run_id):
+    results = {}
+    query = "SELECT " + ", ".join(key_fields) + ", median_sec, samples FROM results WHERE run_id = ?"
+    for row in db.execute(query, (run_id,)):
+        key = tuple(row[:len(key_fields)])
+        # the last record wins if a test was run twice in one run
+        results[key] = (row[len(key_fields)], json.loads(row[len(key_fields) + 1]))
+    return results
+
+
+def mann_whitney_p_value(x, y):
+    # two-sided p-value of the Mann-Whitney U test, normal approximation with
+    # correction for ties (fine for the usual 5+ samples per perf test)
+    values = sorted([(value, 0) for value in x] + [(value, 1) for value in y])
+    n = len(values)
+    ranks = [0.0] * n
+    tie_sum = 0.0
+    i = 0
+    while i < n:
+        j = i
+        while j + 1 < n and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        tie_sum += (j - i + 1) ** 3 - (j - i + 1)
+        i = j + 1
+
+    n1, n2 = len(x), len(y)
+    rank_sum = sum(rank for rank, (value, group) in zip(ranks, values) if group == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2.0
+    mean = n1 * n2 / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_sum / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0
+    z = (abs(u - mean) - 0.5) / math.sqrt(variance)
+    return max(0.0, min(1.0, math.erfc(max(z, 0.0) / math.sqrt(2.0))))
+
+
+def compare_runs(db, base, head, alpha, threshold):
+    base_results = load_results(db, find_run(db, base))
+    head_results = load_results(db, find_run(db, head))
+
+    num_regressions = 0
+    print("%-60s %-9s %7s %12s %12s %8s %8s  %s" %
+          ("task", "type", "threads", "base_median", "head_median", "ratio", "p_value", "status"))
+    for key in sorted(set(base_results) & set(head_results), key=str):
+        base_median, base_samples = base_results[key]
+        head_median, head_samples = head_results[key]
+        if base_median <= 0.0 or head_median <= 0.0:
+            continue
+        ratio = head_median / base_median
+        p_value = 1.0
+        if len(base_samples) > 1 and len(head_samples) > 1:
+            p_value = mann_whitney_p_value(base_samples, head_samples)
+
+        status = ""
+        if p_value < alpha and ratio > 1.0 + threshold:
+            status = "SLOWDOWN"
+            num_regressions += 1
+        elif p_value < alpha and ratio < 1.0 - threshold:
+            status = "speedup"
+        task, _, perf_type, num_threads, _ = key
+        print("%-60s %-9s %7d %12.6f %12.6f %8.3f %8.4f  %s" %
+              (task, perf_type, num_threads, base_median, head_median, ratio, p_value, status))
+
+    for key in sorted(set(base_results) ^ set(head_results), key=str):
+        print("%-60s %-9s %7d only in %s run" % (key[0], key[2], key[3], "base" if key in base_results else "head"))
+
+    print("Significant slowdowns: %d" % num_regressions)
+    return num_regressions
+
+
+parser = argparse.ArgumentParser(description="Store of perf results and comparison of runs")
+parser.add_argument('--db', help='Path to SQLite database', default=default_db_path)
+subparsers = parser.add_subparsers(dest='command', required=True)
+
+import_parser = subparsers.add_parser('import', help='Import PPC_PERF_OUTPUT records (.jsonl) as a new run')
+import_parser.add_argument('-i', '--input', help='Input file path (.jsonl)', required=True)
+import_parser.add_argument('--rev', help='Git revision of the run (current one by default)')
+import_parser.add_argument('--label', help='Free-form description of the run', default='')
+
+subparsers.add_parser('list', help='List runs')
+
+compare_parser = subparsers.add_parser('compare', help='Compare results of two runs')
+compare_parser.add_argument('--base', help='Base run id or git revision', required=True)
+compare_parser.add_argument('--head', help='New run id or git revision', required=True)
+compare_parser.add_argument('--alpha', help='Significance level of the test', type=float, default=0.01)
+compare_parser.add_argument('--threshold', help='Minimal relative change of median time', type=float, default=0.05)
+
+args = parser.parse_args()
+perf_db = open_db(args.db)
+
+if args.command == 'import':
+    import_records(perf_db, args.input, args.rev or get_git_rev(), args.label)
+elif args.command == 'list':
+    for run_row in perf_db.execute("SELECT runs.id, git_rev, timestamp, label, COUNT(results.run_id) FROM runs "
+                                   "LEFT JOIN results ON results.run_id = runs.id GROUP BY runs.id ORDER BY runs.id"):
+        print("%d\t%s\t%s\t%d records\t%s" % (run_row[0], run_row[1],
+                                              time.strftime("%Y-%m-%d %H:%M:%S", time.localtime(run_row[2])),
+                                              run_row[4], run_row[3]))
+elif args.command == 'compare':
+    sys.exit(1 if compare_runs(perf_db, args.base, args.head, args.alpha, args.threshold) > 0 else 0)
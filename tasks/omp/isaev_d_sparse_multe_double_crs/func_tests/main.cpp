@@ -340,3 +340,44 @@ TEST(isaev_d_sparse_multe_double_crs_omp, Test5) {
     EXPECT_DOUBLE_EQ(c_seq.values[i], c_par.values[i]);
   }
 }
+
+TEST(isaev_d_sparse_multe_double_crs_omp, Test6_skewed_rows) {
+  // A few dense rows on top of a sparse matrix hold most of the work
+  IsaevOMP::SparseMatrix a = IsaevOMP::getRandomMatrix(4, 200, 1.0, 9);
+  IsaevOMP::SparseMatrix sparse = IsaevOMP::getRandomMatrix(300, 200, 0.01, 7);
+  int dense_nnz = a.row_pointers.back();
+  for (int i = 1; i <= sparse.rows; i++) a.row_pointers.push_back(dense_nnz + sparse.row_pointers[i]);
+  a.column_indices.insert(a.column_indices.end(), sparse.column_indices.begin(), sparse.column_indices.end());
+  a.values.insert(a.values.end(), sparse.values.begin(), sparse.values.end());
+  a.rows += sparse.rows;
+  IsaevOMP::SparseMatrix b = IsaevOMP::getRandomMatrix(200, 250, 0.05, 8);
+  IsaevOMP::SparseMatrix c_seq;
+  IsaevOMP::SparseMatrix c_par;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&a));
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&c_seq));
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&a));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(&b));
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(&c_par));
+
+  // Create Task
+  IsaevOMP::SparseMultDoubleCRSompSeq ompTaskSequential(taskDataSeq);
+  ASSERT_EQ(ompTaskSequential.validation(), true);
+  ompTaskSequential.pre_processing();
+  ompTaskSequential.run();
+  ompTaskSequential.post_processing();
+  IsaevOMP::SparseMultDoubleCRSompParallel ompTaskParallel(taskDataPar);
+  ASSERT_EQ(ompTaskParallel.validation(), true);
+  ompTaskParallel.pre_processing();
+  ompTaskParallel.run();
+  ompTaskParallel.post_processing();
+
+  ASSERT_EQ(c_seq.row_pointers, c_par.row_pointers);
+  ASSERT_EQ(c_seq.column_indices, c_par.column_indices);
+  ASSERT_EQ(c_seq.values, c_par.values);
+  ASSERT_GT(c_par.row_pointers[1], 200);
+}
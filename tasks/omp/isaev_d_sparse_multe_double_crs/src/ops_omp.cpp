@@ -3,6 +3,10 @@
 
 #include <random>
 #include <thread>
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
 
 namespace IsaevOMP {
 
@@ -122,13 +126,32 @@ bool SparseMultDoubleCRSompParallel::run() {
   internal_order_test();
   std::vector<std::vector<double>> temp(C->rows, std::vector<double>(C->columns, 0.0));
 
-#pragma omp parallel for
-  for (int i = 0; i < A->rows; ++i) {
-    for (int k = A->row_pointers[i]; k < A->row_pointers[i + 1]; ++k) {
-      int j = A->column_indices[k];
-      for (int l = B->row_pointers[j]; l < B->row_pointers[j + 1]; ++l) {
-        int m = B->column_indices[l];
-        temp[i][m] += A->values[k] * B->values[l];
+  // Multiply-adds of every row plus a row overhead, rows are split into
+  // chunks of equal total so that a few heavy rows of a skewed matrix don't
+  // go to the same thread; chunks are handed out dynamically
+  auto cost_prefix = ppc::core::make_cost_prefix(
+      A->rows,
+      [&](size_t i) {
+        size_t work = 1;
+        for (int k = A->row_pointers[i]; k < A->row_pointers[i + 1]; ++k) {
+          int j = A->column_indices[k];
+          work += B->row_pointers[j + 1] - B->row_pointers[j];
+        }
+        return work;
+      },
+      ppc::core::OmpSortBackend());
+  const int num_chunks = omp_get_max_threads() * 4;
+  auto bounds = ppc::core::split_by_cost(A->rows, num_chunks, [&](size_t i) { return cost_prefix[i]; });
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int chunk = 0; chunk < num_chunks; ++chunk) {
+    for (auto i = static_cast<int>(bounds[chunk]); i < static_cast<int>(bounds[chunk + 1]); ++i) {
+      for (int k = A->row_pointers[i]; k < A->row_pointers[i + 1]; ++k) {
+        int j = A->column_indices[k];
+        for (int l = B->row_pointers[j]; l < B->row_pointers[j + 1]; ++l) {
+          int m = B->column_indices[l];
+          temp[i][m] += A->values[k] * B->values[l];
+        }
       }
     }
   }
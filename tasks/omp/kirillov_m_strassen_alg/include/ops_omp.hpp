@@ -5,6 +5,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 namespace kirillov_omp {
 class StrassenMatrixMultParallelOMP : public ppc::core::Task {
@@ -21,6 +22,9 @@ class StrassenMatrixMultParallelOMP : public ppc::core::Task {
 };
 
 std::vector<double> strassen(const std::vector<double>& A, const std::vector<double>& B, int n);
+// C = A * B for n x n matrices, temporaries are taken from scratch memory
+void strassen(ppc::core::MatrixView<const double> A, ppc::core::MatrixView<const double> B,
+              ppc::core::MatrixView<double> C, ppc::core::ScratchMemory& scratch);
 std::vector<double> add(const std::vector<double>& A, const std::vector<double>& B);
 std::vector<double> sub(const std::vector<double>& A, const std::vector<double>& B);
 std::vector<double> mul(const std::vector<double>& A, const std::vector<double>& B, int n);
@@ -6,60 +6,123 @@
 #include <random>
 using namespace kirillov_omp;
 
-std::vector<double> kirillov_omp::strassen(const std::vector<double>& A, const std::vector<double>& B, int n) {
+namespace {
+
+using ConstView = ppc::core::MatrixView<const double>;
+using View = ppc::core::MatrixView<double>;
+
+// X + sign * Y in a new scratch matrix
+View combine(ppc::core::ScratchArena& arena, ConstView X, ConstView Y, double sign) {
+  int n = static_cast<int>(X.rows());
+  View Z(arena.allocate<double>(n * n).data(), n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      Z(i, j) = X(i, j) + sign * Y(i, j);
+    }
+  }
+  return Z;
+}
+
+}  // namespace
+
+void kirillov_omp::strassen(ConstView A, ConstView B, View C, ppc::core::ScratchMemory& scratch) {
+  int n = static_cast<int>(A.rows());
   if ((n == 0) || ((n & (n - 1)) != 0)) {
     throw std::invalid_argument("Matrix size is not 2^n");
   }
 
   if (n <= 2) {
-    return mul(A, B, 2);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        double sum = 0.0;
+        for (int k = 0; k < n; k++) {
+          sum += A(i, k) * B(k, j);
+        }
+        C(i, j) = sum;
+      }
+    }
+    return;
   }
 
   int half = n / 2;
 
-  std::vector<double> A11(half * half);
-  std::vector<double> A12(half * half);
-  std::vector<double> A21(half * half);
-  std::vector<double> A22(half * half);
-
-  std::vector<double> B11(half * half);
-  std::vector<double> B12(half * half);
-  std::vector<double> B21(half * half);
-  std::vector<double> B22(half * half);
-
-  splitMatrix(A, A11, A12, A21, A22);
-  splitMatrix(B, B11, B12, B21, B22);
-  std::vector<double> p1;
-  std::vector<double> p2;
-  std::vector<double> p3;
-  std::vector<double> p4;
-  std::vector<double> p5;
-  std::vector<double> p6;
-  std::vector<double> p7;
+  // quarters are strided views, only operands of products are copied
+  auto A11 = A.block(0, 0, half, half);
+  auto A12 = A.block(0, half, half, half);
+  auto A21 = A.block(half, 0, half, half);
+  auto A22 = A.block(half, half, half, half);
+
+  auto B11 = B.block(0, 0, half, half);
+  auto B12 = B.block(0, half, half, half);
+  auto B21 = B.block(half, 0, half, half);
+  auto B22 = B.block(half, half, half, half);
+
+  // temporaries of the recursion live in scratch memory of the task and are
+  // released when the scope ends
+  auto& arena = scratch.local();
+  ppc::core::ScratchArena::Scope scope(arena);
+  auto product = [&]() { return View(arena.allocate<double>(half * half).data(), half, half); };
+  View p1 = product();
+  View p2 = product();
+  View p3 = product();
+  View p4 = product();
+  View p5 = product();
+  View p6 = product();
+  View p7 = product();
 #pragma omp parallel sections
   {
 #pragma omp section
-    p1 = strassen(add(A11, A22), add(B11, B22), half);
+    {
+      ppc::core::ScratchArena::Scope section(scratch.local());
+      strassen(combine(scratch.local(), A11, A22, 1.0), combine(scratch.local(), B11, B22, 1.0), p1, scratch);
+    }
 #pragma omp section
-    p2 = strassen(add(A21, A22), B11, half);
+    {
+      ppc::core::ScratchArena::Scope section(scratch.local());
+      strassen(combine(scratch.local(), A21, A22, 1.0), B11, p2, scratch);
+    }
 #pragma omp section
-    p3 = strassen(A11, sub(B12, B22), half);
+    {
+      ppc::core::ScratchArena::Scope section(scratch.local());
+      strassen(A11, combine(scratch.local(), B12, B22, -1.0), p3, scratch);
+    }
 #pragma omp section
-    p4 = strassen(A22, sub(B21, B11), half);
+    {
+      ppc::core::ScratchArena::Scope section(scratch.local());
+      strassen(A22, combine(scratch.local(), B21, B11, -1.0), p4, scratch);
+    }
 #pragma omp section
-    p5 = strassen(add(A11, A12), B22, half);
+    {
+      ppc::core::ScratchArena::Scope section(scratch.local());
+      strassen(combine(scratch.local(), A11, A12, 1.0), B22, p5, scratch);
+    }
 #pragma omp section
-    p6 = strassen(sub(A21, A11), add(B11, B12), half);
+    {
+      ppc::core::ScratchArena::Scope section(scratch.local());
+      strassen(combine(scratch.local(), A21, A11, -1.0), combine(scratch.local(), B11, B12, 1.0), p6, scratch);
+    }
 #pragma omp section
-    p7 = strassen(sub(A12, A22), add(B21, B22), half);
+    {
+      ppc::core::ScratchArena::Scope section(scratch.local());
+      strassen(combine(scratch.local(), A12, A22, -1.0), combine(scratch.local(), B21, B22, 1.0), p7, scratch);
+    }
   }
 
-  std::vector<double> C11 = add(add(p1, p4), sub(p7, p5));
-  std::vector<double> C12 = add(p3, p5);
-  std::vector<double> C21 = add(p2, p4);
-  std::vector<double> C22 = add(sub(p1, p2), add(p3, p6));
+  for (int i = 0; i < half; i++) {
+    for (int j = 0; j < half; j++) {
+      C(i, j) = (p1(i, j) + p4(i, j)) + (p7(i, j) - p5(i, j));
+      C(i, j + half) = p3(i, j) + p5(i, j);
+      C(i + half, j) = p2(i, j) + p4(i, j);
+      C(i + half, j + half) = (p1(i, j) - p2(i, j)) + (p3(i, j) + p6(i, j));
+    }
+  }
+}
 
-  return joinMatrices(C11, C12, C21, C22, n);
+std::vector<double> kirillov_omp::strassen(const std::vector<double>& A, const std::vector<double>& B, int n) {
+  std::vector<double> C(n * n);
+  ppc::core::ScratchMemory scratch;
+  strassen(ConstView(A.data(), n, n), ConstView(B.data(), n, n), View(C.data(), n, n), scratch);
+  return C;
 }
 
 std::vector<double> kirillov_omp::joinMatrices(const std::vector<double>& A11, const std::vector<double>& A12,
@@ -162,7 +225,8 @@ bool StrassenMatrixMultParallelOMP::validation() {
 
 bool StrassenMatrixMultParallelOMP::run() {
   internal_order_test();
-  C = strassen(A, B, n);
+  C.resize(n * n);
+  strassen(ConstView(A.data(), n, n), ConstView(B.data(), n, n), View(C.data(), n, n), get_scratch_memory());
   return true;
 }
 
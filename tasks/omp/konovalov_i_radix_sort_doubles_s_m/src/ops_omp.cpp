@@ -3,8 +3,12 @@
 
 #include <omp.h>
 
+#include <functional>
+#include <span>
 #include <thread>
 
+#include "core/sort/include/sort.hpp"
+
 using namespace std::chrono_literals;
 
 bool RadixSortSequentialTask::pre_processing() {
@@ -67,64 +71,10 @@ bool RadixSortOMPTaskParallel::validation() {
   return taskData->inputs_count.size() == taskData->outputs_count.size();
 }
 
-const int max_val = 256;
-
-void RadixSortOMPTaskParallel::radix_sort_seq(double* in, size_t size) {
-  if (size != 0) {
-    char* buf;
-    std::vector<double> ordered_local[sizeof(double) * max_val];
-    for (size_t i = 0; i < sizeof(double); i++) {
-      for (size_t j = 0; j < size; j++) {
-        buf = reinterpret_cast<char*>(&in[j]);
-        ordered_local[(uint8_t)buf[i]].push_back(in[j]);
-      }
-
-      size_t cur = 0;
-      for (size_t j = 0; j < sizeof(double) * 256; j++) {
-        for (size_t k = 0; k < ordered_local[j].size(); k++) {
-          in[cur] = ordered_local[j][k];
-          cur++;
-        }
-        ordered_local[j].clear();
-      }
-    }
-  }
-}
-
+// In place: the input buffer is sorted without buckets of the size of data
 bool RadixSortOMPTaskParallel::run() {
   internal_order_test();
-
-  try {
-    auto* chunks = reinterpret_cast<double*>(std::malloc(input_size * max_val * sizeof(double)));
-    size_t chunk_sizes[max_val];
-    for (size_t i = 0; i < max_val; i++) {
-      chunk_sizes[i] = 0;
-    }
-    for (size_t i = 0; i < input_size; i++) {
-      char val = *(reinterpret_cast<char*>(input_ + i) + sizeof(double) - 1);
-      chunks[(uint8_t)val * input_size + chunk_sizes[(uint8_t)val]] = input_[i];
-      chunk_sizes[(uint8_t)val]++;
-    }
-#pragma omp parallel
-    {
-#pragma omp for nowait
-      for (int64_t i = 0; i < max_val; i++) {
-        radix_sort_seq(chunks + i * input_size, chunk_sizes[i]);
-      }
-    }
-    size_t it = 0;
-    for (int64_t i = 0; i < max_val; i++) {
-      if (chunk_sizes[i] != 0) {
-        for (size_t k = 0; k < chunk_sizes[i]; k++) input_[it + k] = chunks[i * input_size + k];
-        it += chunk_sizes[i];
-      }
-    }
-    free(chunks);
-
-  } catch (const std::exception& e) {
-    std::cerr << "Double Radix sort error: " << e.what() << std::endl;
-    return false;
-  }
+  ppc::core::inplace_radix_sort(std::span<double>(input_, input_size), std::identity(), ppc::core::OmpSortBackend());
   return true;
 }
 
@@ -148,3 +148,36 @@ TEST(kostin_a_sle_conjugate_gradient_omp, Test_generated_SLE_size_1) {
   testTaskOpenMP.post_processing();
   ASSERT_TRUE(check_solution(in_A, size, in_b, out, 1e-6));
 }
+
+TEST(kostin_a_sle_conjugate_gradient_omp, Test_expired_deadline) {
+  int size = 100;
+
+  // Create data
+  std::vector<double> in_A = generateSPDMatrix(size, 100);
+  std::vector<double> in_b = generatePDVector(size, 100);
+  std::vector<double> out(size, 0.0);
+
+  // Create TaskData with deadline which is already expired
+  std::shared_ptr<ppc::core::TaskData> taskDataOMP = std::make_shared<ppc::core::TaskData>();
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_A.data()));
+  taskDataOMP->inputs_count.emplace_back(in_A.size());
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_b.data()));
+  taskDataOMP->inputs_count.emplace_back(in_b.size());
+  taskDataOMP->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+  taskDataOMP->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataOMP->outputs_count.emplace_back(out.size());
+  taskDataOMP->cancellation = std::make_shared<ppc::core::CancellationToken>();
+  taskDataOMP->cancellation->set_timeout(0.0);
+
+  // Create Task
+  ConjugateGradientMethodOMP testTaskOpenMP(taskDataOMP);
+  ASSERT_EQ(testTaskOpenMP.validation(), true);
+  testTaskOpenMP.pre_processing();
+  ASSERT_FALSE(testTaskOpenMP.run());
+  testTaskOpenMP.post_processing();
+  ASSERT_EQ(testTaskOpenMP.get_status(), ppc::core::Task::Status::TIMED_OUT);
+  ASSERT_LT(testTaskOpenMP.get_progress(), 1.0);
+  // solution after the first iteration is kept
+  ASSERT_FALSE(check_solution(in_A, size, in_b, out, 1e-6));
+  ASSERT_NE(out, std::vector<double>(size, 0.0));
+}
@@ -1,6 +1,7 @@
 // Copyright 2024 Kostin Artem
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
@@ -16,9 +17,9 @@ class ConjugateGradientMethodOMP : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<double> A;
+  std::span<const double> A;
   int size = 0;
-  std::vector<double> b;
+  std::span<const double> b;
   std::vector<double> x;
 };
 
@@ -1,13 +1,17 @@
 // Copyright 2024 Kostin Artem
 #include "omp/kostin_a_sle_conjugate_gradient/include/ops_omp.hpp"
 
+#include <cmath>
+#include <functional>
 #include <random>
 #include <thread>
 
+#include "core/task/include/data_view.hpp"
+
 using namespace std::chrono_literals;
 
 namespace KostinArtemOMP {
-std::vector<double> dense_matrix_vector_multiply(const std::vector<double>& A, int n, const std::vector<double>& x) {
+std::vector<double> dense_matrix_vector_multiply(std::span<const double> A, int n, const std::vector<double>& x) {
   std::vector<double> result(n, 0.0);
 #pragma omp parallel for
   for (int i = 0; i < n; ++i) {
@@ -27,12 +31,14 @@ double dot_product(const std::vector<double>& a, const std::vector<double>& b) {
   return result;
 }
 
-std::vector<double> conjugate_gradient(const std::vector<double>& A, int n, const std::vector<double>& b,
-                                       double tolerance) {
+std::vector<double> conjugate_gradient(std::span<const double> A, int n, std::span<const double> b, double tolerance,
+                                       const std::function<bool(double)>& interrupted) {
   std::vector<double> x(n, 0.0);
-  std::vector<double> r = b;
+  std::vector<double> r(b.begin(), b.end());
   std::vector<double> p = r;
-  std::vector<double> r_prev = b;
+  std::vector<double> r_prev = r;
+
+  const double initial_norm = sqrt(dot_product(r, r));
 
   while (true) {
     std::vector<double> Ap = dense_matrix_vector_multiply(A, n, p);
@@ -48,7 +54,11 @@ std::vector<double> conjugate_gradient(const std::vector<double>& A, int n, cons
       r[i] = r_prev[i] - alpha * Ap[i];
     }
 
-    if (sqrt(dot_product(r, r)) < tolerance) {
+    double residual_norm = sqrt(dot_product(r, r));
+    if (residual_norm < tolerance) {
+      break;
+    }
+    if (interrupted(ppc::core::get_convergence_progress(initial_norm, residual_norm, tolerance))) {
       break;
     }
 
@@ -104,20 +114,9 @@ bool check_solution(const std::vector<double>& A, int n, const std::vector<doubl
 
 bool ConjugateGradientMethodOMP::pre_processing() {
   internal_order_test();
-  // Init value for input and output
-  A = std::vector<double>(taskData->inputs_count[0]);
-  // for (unsigned int i = 0; i < taskData->inputs_count[0]; i++) {
-  //   A[i] = reinterpret_cast<double*>(taskData->inputs[0])[i];
-  // }
-  std::copy(reinterpret_cast<double*>(taskData->inputs[0]),
-            reinterpret_cast<double*>(taskData->inputs[0]) + taskData->inputs_count[0], A.begin());
-
-  b = std::vector<double>(taskData->inputs_count[1]);
-  // for (unsigned int i = 0; i < taskData->inputs_count[1]; i++) {
-  //   b[i] = reinterpret_cast<double*>(taskData->inputs[1])[i];
-  // }
-  std::copy(reinterpret_cast<double*>(taskData->inputs[1]),
-            reinterpret_cast<double*>(taskData->inputs[1]) + taskData->inputs_count[1], b.begin());
+  // Init value for input (views of the caller's buffers) and output
+  A = ppc::core::input_view<const double>(*taskData, 0);
+  b = ppc::core::input_view<const double>(*taskData, 1);
 
   size = *reinterpret_cast<int*>(taskData->inputs[2]);
   x = std::vector<double>(size, 0);
@@ -133,8 +132,9 @@ bool ConjugateGradientMethodOMP::validation() {
 
 bool ConjugateGradientMethodOMP::run() {
   internal_order_test();
-  x = conjugate_gradient(A, size, b, 1e-6);
-  return true;
+  // stops with partial solution if the task is cancelled or out of time
+  x = conjugate_gradient(A, size, b, 1e-6, [this](double progress) { return interrupted(progress); });
+  return get_status() == Status::COMPLETED;
 }
 
 bool ConjugateGradientMethodOMP::post_processing() {
@@ -335,3 +335,41 @@ TEST(savchuk_a_crs_matmult_omp, zero_matrix) {
 
   ASSERT_EQ(ch, n1 * m2);
 }
+
+TEST(savchuk_a_crs_matmult_omp, skewed_rows) {
+  // The first row of lhs hits every row of rhs and the first row of rhs is
+  // full, so most of the work is in a few rows of the product
+  size_t p = 64;
+  size_t q = 48;
+  size_t r = 40;
+  std::vector<Complex> lhs_in(p * q, Complex(0, 0));
+  for (size_t j = 0; j < q; ++j) lhs_in[j] = Complex(1.0, static_cast<double>(j % 3));
+  for (size_t i = 1; i < p; ++i) lhs_in[i * q + (i * 7) % q] = Complex(2.0, -1.0);
+  std::vector<Complex> rhs_in(q * r, Complex(0, 0));
+  for (size_t j = 0; j < r; ++j) rhs_in[j] = Complex(static_cast<double>(j), 1.0);
+  for (size_t i = 1; i < q; ++i) rhs_in[i * r + i % r] = Complex(-1.0, 3.0);
+
+  auto run = [&](auto createTask) {
+    std::vector<Complex> out(p * r);
+    std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(lhs_in.data()));
+    taskData->inputs_count.emplace_back(p);
+    taskData->inputs_count.emplace_back(q);
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(rhs_in.data()));
+    taskData->inputs_count.emplace_back(q);
+    taskData->inputs_count.emplace_back(r);
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskData->outputs_count.emplace_back(p);
+    taskData->outputs_count.emplace_back(r);
+    auto task = createTask(taskData);
+    EXPECT_TRUE(task.validation());
+    task.pre_processing();
+    task.run();
+    task.post_processing();
+    return out;
+  };
+  auto expected = run([](auto taskData) { return SavchukCRSMatMultOMPSequential(taskData); });
+  auto actual = run([](auto taskData) { return SavchukCRSMatMultOMPParallel(taskData); });
+  ASSERT_EQ(actual, expected);
+  ASSERT_NE(expected[1], Complex(0, 0));
+}
@@ -1,6 +1,13 @@
 // Copyright 2024 Savchuk Anton
 #include "omp/savchuk_a_crs_matmult_omp/include/crs_matmult_omp.hpp"
 
+#include <omp.h>
+
+#include <vector>
+
+#include "core/sort/include/sort_backend.hpp"
+#include "core/sparse/include/sparse.hpp"
+
 using namespace SavchukOMP;
 
 bool SavchukCRSMatMultOMPSequential::validation() {
@@ -141,18 +148,34 @@ bool SavchukCRSMatMultOMPParallel::pre_processing() {
 bool SavchukCRSMatMultOMPParallel::run() {
   internal_order_test();
 
-#pragma omp parallel for
-  for (int i = 0; i < numRows1; i++) {
-    for (int j = rowPtr1[i]; j < rowPtr1[i + 1]; j++) {
-      int row1 = i;
-      int col1 = colPtr1[j];
-      Complex val1 = values1[j];
-      for (int k = rowPtr2[col1]; k < rowPtr2[col1 + 1]; k++) {
-        int col2 = colPtr2[k];
-        Complex val2 = values2[k];
-        int index = row1 * numCols2 + col2;
-        Complex temp = result[index] + val1 * val2;
-        result[index] = temp;
+  // Rows are split into chunks of about equal multiply-adds (plus a row
+  // overhead), so rows hitting long rows of the second matrix don't leave
+  // one thread with most of the work, and chunks are taken dynamically
+  auto costPrefix = ppc::core::make_cost_prefix(
+      numRows1,
+      [&](size_t i) {
+        size_t rowWork = 1;
+        for (int j = rowPtr1[i]; j < rowPtr1[i + 1]; j++) rowWork += rowPtr2[colPtr1[j] + 1] - rowPtr2[colPtr1[j]];
+        return rowWork;
+      },
+      ppc::core::OmpSortBackend());
+  auto numChunks = static_cast<size_t>(omp_get_max_threads()) * 4;
+  auto bounds = ppc::core::split_by_cost(numRows1, numChunks, [&](size_t i) { return costPrefix[i]; });
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int chunk = 0; chunk < static_cast<int>(numChunks); chunk++) {
+    for (auto i = static_cast<int>(bounds[chunk]); i < static_cast<int>(bounds[chunk + 1]); i++) {
+      for (int j = rowPtr1[i]; j < rowPtr1[i + 1]; j++) {
+        int row1 = i;
+        int col1 = colPtr1[j];
+        Complex val1 = values1[j];
+        for (int k = rowPtr2[col1]; k < rowPtr2[col1 + 1]; k++) {
+          int col2 = colPtr2[k];
+          Complex val2 = values2[k];
+          int index = row1 * numCols2 + col2;
+          Complex temp = result[index] + val1 * val2;
+          result[index] = temp;
+        }
       }
     }
   }
@@ -43,8 +43,8 @@ class ShmelevTaskOmp : public ppc::core::Task {
  private:
   std::vector<int> sequence;
   std::vector<int> result;
+  std::vector<int> merged;
   void batcherMergeSort(int left, int right);
-  void shellSort();
   void mergeSequences(int left, int middle, int right);
 };
 
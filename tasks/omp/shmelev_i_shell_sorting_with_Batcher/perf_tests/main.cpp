@@ -9,7 +9,7 @@
 using namespace shmelev_omp;
 
 TEST(shmelev_i_shell_sorting_with_Batcher, pipeline_run) {
-  const int count = 2048;
+  const int count = 1 << 22;
 
   // Create data
   std::vector<int> input_array = create_random_sequence(count, 1, 1024);
@@ -41,7 +41,7 @@ TEST(shmelev_i_shell_sorting_with_Batcher, pipeline_run) {
 }
 
 TEST(shmelev_i_shell_sorting_with_Batcher, task_run) {
-  const int count = 2048;
+  const int count = 1 << 22;
 
   // Create data
   std::vector<int> input_array = create_random_sequence(count, 1, 1024);
@@ -4,6 +4,8 @@
 
 #include <algorithm>
 
+#include "core/sort/include/simd_sort.hpp"
+
 std::vector<int> shmelev_omp::create_random_sequence(int size, int min, int max) {
   std::random_device rnd_device;
   std::mt19937 mersenne_engine{rnd_device()};
@@ -120,7 +122,10 @@ bool shmelev_omp::ShmelevTaskOmp::validation() {
 
 bool shmelev_omp::ShmelevTaskOmp::run() {
   internal_order_test();
-  batcherMergeSort(0, sequence.size() - 1);
+  merged.resize(sequence.size());
+#pragma omp parallel
+#pragma omp single
+  batcherMergeSort(0, static_cast<int>(sequence.size()) - 1);
   return true;
 }
 
@@ -130,58 +135,24 @@ bool shmelev_omp::ShmelevTaskOmp::post_processing() {
   return true;
 }
 
-void shmelev_omp::ShmelevTaskOmp::shellSort() {
-  int n = sequence.size();
-  for (int gap = n / 2; gap > 0; gap /= 2) {
-    for (int i = gap; i < n; i++) {
-      int temp = sequence[i];
-      int j = i;
-      while (j >= gap && sequence[j - gap] > temp) {
-        sequence[j] = sequence[j - gap];
-        j -= gap;
-      }
-      sequence[j] = temp;
-    }
-  }
-}
-
+// Leaves are sorted by the Batcher network in vector registers
 void shmelev_omp::ShmelevTaskOmp::batcherMergeSort(int left, int right) {
-  shellSort();
-  if (right > left) {
-    int middle = left + (right - left) / 2;
-#pragma omp parallel sections
-    {
-#pragma omp section
-      batcherMergeSort(left, middle);
-#pragma omp section
-      batcherMergeSort(middle + 1, right);
-    }
-    mergeSequences(left, middle, right);
+  int size = right - left + 1;
+  if (size <= static_cast<int>(ppc::core::SIMD_SORT_BLOCK_SIZE)) {
+    if (size > 1) ppc::core::simd_sort_block(sequence.data() + left, size);
+    return;
   }
+  int middle = left + (right - left) / 2;
+  // small halves are sorted by the thread of the parent task
+#pragma omp task if (size > 4096)
+  batcherMergeSort(left, middle);
+  batcherMergeSort(middle + 1, right);
+#pragma omp taskwait
+  mergeSequences(left, middle, right);
 }
 
 void shmelev_omp::ShmelevTaskOmp::mergeSequences(int left, int middle, int right) {
-  std::vector<int> merged(right - left + 1);
-  int i = left;
-  int j = middle + 1;
-  int k = 0;
-
-  for (; i <= middle && j <= right; ++k) {
-    if (sequence[i] <= sequence[j]) {
-      merged[k] = sequence[i++];
-    } else {
-      merged[k] = sequence[j++];
-    }
-  }
-
-  for (; i <= middle; ++i, ++k) {
-    merged[k] = sequence[i];
-  }
-  for (; j <= right; ++j, ++k) {
-    merged[k] = sequence[j];
-  }
-
-  for (int idx = 0; idx < k; ++idx) {
-    sequence[left + idx] = merged[idx];
-  }
+  ppc::core::simd_merge(sequence.data() + left, middle - left + 1, sequence.data() + middle + 1, right - middle,
+                        merged.data() + left);
+  std::copy(merged.begin() + left, merged.begin() + right + 1, sequence.begin() + left);
 }
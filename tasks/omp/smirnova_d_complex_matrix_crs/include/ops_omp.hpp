@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/sparse/include/split_complex.hpp"
 #include "core/task/include/task.hpp"
 
 namespace smirnova_omp {
@@ -41,6 +42,7 @@ class TestComplexMatrixCrsPar : public ppc::core::Task {
 
  private:
   crs_matrix *A_M{}, *B_M{}, *Result{};
+  ppc::core::SplitCrsMatrix<double> A_split, B_split;
 };
 
 crs_matrix T(const crs_matrix& M);
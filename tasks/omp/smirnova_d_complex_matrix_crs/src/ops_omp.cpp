@@ -1,15 +1,22 @@
 // Copyright 2024 Smirnova Daria
 #include "omp/smirnova_d_complex_matrix_crs/include/ops_omp.hpp"
 
-#include <omp.h>
-
 #include <algorithm>
+#include <cmath>
 #include <complex>
 #include <utility>
 #include <vector>
 
 using namespace std::chrono_literals;
 
+namespace {
+
+ppc::core::SparseView<std::complex<double>, int> get_view(const smirnova_omp::crs_matrix& M) {
+  return {M.n_rows, M.n_cols, M.pointer, M.col_indexes, M.non_zero_values};
+}
+
+}  // namespace
+
 smirnova_omp::crs_matrix smirnova_omp::T(const crs_matrix& M) {
   crs_matrix temp_matrix;
   temp_matrix.n_rows = M.n_cols;
@@ -111,7 +118,9 @@ bool smirnova_omp::TestComplexMatrixCrsSeq::post_processing() {
 bool smirnova_omp::TestComplexMatrixCrsPar::pre_processing() {
   internal_order_test();
 
-  *B_M = T(*B_M);
+  // B isn't transposed, the product is accumulated by rows of it
+  A_split = ppc::core::to_split_complex(get_view(*A_M));
+  B_split = ppc::core::to_split_complex(get_view(*B_M));
   return true;
 }
 
@@ -127,41 +136,27 @@ bool smirnova_omp::TestComplexMatrixCrsPar::validation() {
   if (A_M == nullptr || B_M == nullptr || Result == nullptr) return false;
   if (!is_crs(*A_M) || !is_crs(*B_M)) return false;
   if (A_M->n_cols != B_M->n_rows) return false;
-  return true;
+  // the vector kernel of spgemm needs unique columns within rows of B
+  return ppc::core::is_valid(get_view(*B_M), false);
 }
 
 bool smirnova_omp::TestComplexMatrixCrsPar::run() {
   internal_order_test();
 
-  Result->n_rows = A_M->n_rows;
-  Result->n_cols = B_M->n_rows;
+  auto product = ppc::core::spgemm(A_split, B_split, ppc::core::OmpSortBackend());
+  Result->n_rows = product.rows;
+  Result->n_cols = product.cols;
   Result->pointer.assign(Result->n_rows + 1, 0);
-  std::vector<std::vector<std::pair<int, std::complex<double>>>> temp(Result->n_rows);
-
-  omp_set_num_threads(4);
-#pragma omp parallel for
+  Result->col_indexes.clear();
+  Result->non_zero_values.clear();
   for (int i = 0; i < Result->n_rows; i++) {
-    for (int j = 0; j < B_M->n_rows; j++) {
-      std::complex<double> T;
-      for (int k_A = A_M->pointer[i]; k_A < A_M->pointer[i + 1]; k_A++) {
-        for (int k_B = B_M->pointer[j]; k_B < B_M->pointer[j + 1]; k_B++) {
-          if (A_M->col_indexes[k_A] == B_M->col_indexes[k_B]) {
-            T += A_M->non_zero_values[k_A] * B_M->non_zero_values[k_B];
-          }
-        }
+    for (int k = product.ptr[i]; k < product.ptr[i + 1]; k++) {
+      if (std::abs(product.imag[k]) > 1e-3 || std::abs(product.real[k]) > 1e-3) {
+        Result->col_indexes.push_back(product.index[k]);
+        Result->non_zero_values.push_back(product.get_value(k));
       }
-      if (std::abs(T.imag()) > 1e-3 || std::abs(T.real()) > 1e-3) {
-        temp[i].emplace_back(j, T);
-      }
-    }
-  }
-  for (int i = 0; i < Result->n_rows; i++) {
-    Result->pointer[i + 1] = Result->pointer[i];
-    for (auto& j : temp[i]) {
-      Result->col_indexes.push_back(j.first);
-      Result->non_zero_values.push_back(j.second);
-      Result->pointer[i + 1]++;
     }
+    Result->pointer[i + 1] = static_cast<int>(Result->col_indexes.size());
   }
   return true;
 }
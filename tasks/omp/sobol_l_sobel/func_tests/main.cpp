@@ -1,8 +1,11 @@
 // Copyright 2024 Sobol Liubov
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <memory>
 #include <vector>
 
+#include "core/dispatch/include/dispatch.hpp"
 #include "omp/sobol_l_sobel/include/sobel_omp.hpp"
 
 TEST(sobol_l_sobel_omp, test_handle_empty_image) {
@@ -180,3 +183,54 @@ TEST(sobol_l_sobel_omp, test_handle_gradient_image) {
     ASSERT_EQ(out_pixel.b, expected_pixel.b);
   }
 }
+
+TEST(sobol_l_sobel_omp, test_dispatch) {
+  std::vector<sobol::RGB> input;
+  std::vector<sobol::RGB> output;
+  // square image of the given side, described by inputs_count as the
+  // registered task expects
+  auto make_data = [&](uint64_t side) {
+    input = sobol::getRandomRGBPicture(static_cast<int>(side), static_cast<int>(side));
+    output.assign(input.size(), {});
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(input.data()));
+    taskData->inputs_count.emplace_back(static_cast<uint32_t>(input.size() * sizeof(sobol::RGB)));
+    taskData->inputs_count.emplace_back(static_cast<uint32_t>(side));
+    taskData->inputs_count.emplace_back(static_cast<uint32_t>(side));
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(output.data()));
+    taskData->outputs_count.emplace_back(static_cast<uint32_t>(output.size() * sizeof(sobol::RGB)));
+    return taskData;
+  };
+
+  ppc::core::Dispatcher dispatcher("sobol_l_sobel");
+  ppc::core::DispatchAttr dispatchAttr;
+  dispatchAttr.sizes = {16, 64};
+  dispatchAttr.make_data = make_data;
+  dispatchAttr.perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  dispatchAttr.perf_attr->num_running = 3;
+  dispatchAttr.perf_attr->current_timer = [] {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  };
+  dispatcher.calibrate(dispatchAttr);
+  ASSERT_EQ(dispatcher.get_calibration().size(), 2U);
+  EXPECT_EQ(dispatcher.get_calibration().begin()->second.count("omp"), 1U);
+
+  auto taskData = make_data(32);
+  auto task = dispatcher.create(taskData);
+  ASSERT_TRUE(task->validation());
+  ASSERT_TRUE(task->pre_processing());
+  ASSERT_TRUE(task->run());
+  ASSERT_TRUE(task->post_processing());
+
+  std::vector<sobol::RGB> expected_output(input.size());
+  auto expectedData = std::make_shared<ppc::core::TaskData>(*taskData);
+  expectedData->outputs[0] = reinterpret_cast<uint8_t*>(expected_output.data());
+  sobol::Sobel_omp sobel(expectedData, 32, 32);
+  ASSERT_TRUE(sobel.validation());
+  ASSERT_TRUE(sobel.pre_processing());
+  ASSERT_TRUE(sobel.run());
+  ASSERT_TRUE(sobel.post_processing());
+  for (size_t i = 0; i < output.size(); ++i) {
+    ASSERT_EQ(output[i].r, expected_output[i].r);
+  }
+}
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/threads/include/numa.hpp"
 
 namespace sobol {
 struct RGB {
@@ -15,6 +16,9 @@ class Sobel_omp : public ppc::core::Task {
  public:
   explicit Sobel_omp(std::shared_ptr<ppc::core::TaskData> taskData_, int w_, int h_)
       : Task(std::move(taskData_)), width(w_), height(h_) {}
+  // Form of TaskRegistration, width and height are inputs_count[1] and [2]
+  explicit Sobel_omp(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : Task(std::move(taskData_)), width(get_dimension(1)), height(get_dimension(2)) {}
   bool validation() override;
   bool pre_processing() override;
   bool run() override;
@@ -22,8 +26,11 @@ class Sobel_omp : public ppc::core::Task {
 
  private:
   void process_pixel(int i, int j);
-  std::vector<RGB> input_;
-  std::vector<RGB> res;
+  [[nodiscard]] int get_dimension(size_t i) const {
+    return i < taskData->inputs_count.size() ? static_cast<int>(taskData->inputs_count[i]) : 0;
+  }
+  ppc::core::numa_vector<RGB> input_;
+  ppc::core::numa_vector<RGB> res;
   int width, height;
 };
 
@@ -7,6 +7,14 @@
 #include <cstring>
 #include <random>
 
+#include "core/dispatch/include/dispatch.hpp"
+
+namespace {
+
+ppc::core::TaskRegistration<sobol::Sobel_omp> registration("sobol_l_sobel", "omp");
+
+}  // namespace
+
 bool sobol::Sobel_omp::validation() {
   internal_order_test();
   if (taskData->inputs.empty() || taskData->outputs.empty()) {
@@ -23,12 +31,10 @@ bool sobol::Sobel_omp::validation() {
 
 bool sobol::Sobel_omp::pre_processing() {
   internal_order_test();
-  input_.resize(width * height);
-  res.resize(width * height);
+  // rows are first touched by the threads which filter them
   auto* inputPixels = reinterpret_cast<sobol::RGB*>(taskData->inputs[0]);
-  for (int i = 0; i < width * height; i++) {
-    input_[i] = inputPixels[i];
-  }
+  input_ = ppc::core::make_numa_vector(inputPixels, width * height);
+  res = ppc::core::make_numa_vector(width * height, sobol::RGB{});
   return true;
 }
 
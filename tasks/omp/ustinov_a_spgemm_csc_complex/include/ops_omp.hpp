@@ -1,6 +1,9 @@
 // Copyright 2024 Ustinov Alexander
 #pragma once
 
+#include <complex>
+
+#include "core/sparse/include/split_complex.hpp"
 #include "core/task/include/task.hpp"
 #include "omp/ustinov_a_spgemm_csc_complex/include/sparse_matrix.hpp"
 
@@ -25,5 +28,6 @@ class SpgemmCSCComplexOmpPar : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  sparse_matrix *A, *B, *C;
+  ppc::core::SplitCcsMatrix<double> A, B, C;
+  sparse_matrix* result;
 };
\ No newline at end of file
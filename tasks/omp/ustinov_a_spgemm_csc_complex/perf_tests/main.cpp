@@ -2,9 +2,12 @@
 #include <gtest/gtest.h>
 #include <omp.h>
 
+#include <cstdlib>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
+#include "core/sparse/include/sparse.hpp"
+#include "core/sparse/include/sparse_io.hpp"
 #include "omp/ustinov_a_spgemm_csc_complex/include/ops_omp.hpp"
 
 const double PI = 3.14159265358979323846;
@@ -41,6 +44,14 @@ sparse_matrix dft_conj_matrix(int n) {
   return dft_conj;
 }
 
+sparse_matrix to_sparse_matrix(const ppc::core::CcsMatrix<std::complex<double>>& matrix) {
+  sparse_matrix result(matrix.rows, matrix.cols, static_cast<int>(matrix.get_nnz()));
+  result.col_ptr = matrix.ptr;
+  result.rows = matrix.index;
+  result.values = matrix.values;
+  return result;
+}
+
 TEST(ustinov_a_spgemm_csc_complex_omp, test_pipeline_run_dft384x384) {
   int n = 384;
   sparse_matrix A = dft_matrix(n);
@@ -107,4 +118,41 @@ TEST(ustinov_a_spgemm_csc_complex_omp, test_task_run_dft384x384) {
   auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskParallel);
   perfAnalyzer->task_run(perfAttr, perfResults);
   ppc::core::Perf::print_perf_statistic(perfResults);
-}
\ No newline at end of file
+}
+// A * A^T of the Matrix Market file given by PPC_SPARSE_MATRIX, so real
+// matrices are measured without building their dense form
+TEST(ustinov_a_spgemm_csc_complex_omp, test_task_run_matrix_market) {
+  const char* path = std::getenv("PPC_SPARSE_MATRIX");
+  if (path == nullptr) GTEST_SKIP() << "PPC_SPARSE_MATRIX isn't set";
+  auto matrix = ppc::core::read_matrix_market<ppc::core::CcsMatrix<std::complex<double>>>(path);
+  sparse_matrix A = to_sparse_matrix(matrix);
+  sparse_matrix B = to_sparse_matrix(ppc::core::transpose(matrix));
+  sparse_matrix C;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(&A));
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(&B));
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(&C));
+
+  // Create Task
+  auto testTaskParallel = std::make_shared<SpgemmCSCComplexOmpPar>(taskDataPar);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const auto t0 = omp_get_wtime();
+  perfAttr->current_timer = [&] {
+    auto current_time_point = omp_get_wtime();
+    auto duration = current_time_point - t0;
+    return duration;
+  };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskParallel);
+  perfAnalyzer->task_run(perfAttr, perfResults);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+}
@@ -1,7 +1,18 @@
 // Copyright 2024 Ustinov Alexander
 #include "omp/ustinov_a_spgemm_csc_complex/include/ops_omp.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
+
+namespace {
+
+ppc::core::SparseView<std::complex<double>, int, ppc::core::SparseLayout::CCS> get_view(const sparse_matrix& matrix) {
+  return ppc::core::make_prefix_view<ppc::core::SparseLayout::CCS, std::complex<double>>(
+      matrix.row_num, matrix.col_num, matrix.col_ptr, matrix.rows, matrix.values);
+}
+
+}  // namespace
 
 bool SpgemmCSCComplexOmpSeq::pre_processing() {
   internal_order_test();
@@ -93,98 +104,35 @@ bool SpgemmCSCComplexOmpSeq::post_processing() {
 bool SpgemmCSCComplexOmpPar::pre_processing() {
   internal_order_test();
 
-  A = reinterpret_cast<sparse_matrix*>(taskData->inputs[0]);
-  B = reinterpret_cast<sparse_matrix*>(taskData->inputs[1]);
-  C = reinterpret_cast<sparse_matrix*>(taskData->outputs[0]);
+  A = ppc::core::to_split_complex(get_view(*reinterpret_cast<sparse_matrix*>(taskData->inputs[0])));
+  B = ppc::core::to_split_complex(get_view(*reinterpret_cast<sparse_matrix*>(taskData->inputs[1])));
+  result = reinterpret_cast<sparse_matrix*>(taskData->outputs[0]);
   return true;
 }
 
 bool SpgemmCSCComplexOmpPar::validation() {
   internal_order_test();
-  int A_col_num = reinterpret_cast<sparse_matrix*>(taskData->inputs[0])->col_num;
-  int B_row_num = reinterpret_cast<sparse_matrix*>(taskData->inputs[1])->row_num;
+  const auto& a = *reinterpret_cast<sparse_matrix*>(taskData->inputs[0]);
+  const auto& b = *reinterpret_cast<sparse_matrix*>(taskData->inputs[1]);
   // check that matrices are compatible for multiplication
-  return (A_col_num == B_row_num);
+  return a.col_num == b.row_num && ppc::core::is_valid(get_view(a), false) &&
+         ppc::core::is_valid(get_view(b), false);
 }
 
 bool SpgemmCSCComplexOmpPar::run() {
   internal_order_test();
-
-  // symbolic stage
-  C->row_num = A->row_num;
-  C->col_num = B->col_num;
-  C->col_ptr.resize(C->col_num + 1);
-  C->col_ptr[0] = 0;
-
-#pragma omp parallel
-  {
-    std::vector<int> present_elements(C->row_num);
-#pragma omp for schedule(dynamic, 64)
-    for (int b_col = 0; b_col < C->col_num; ++b_col) {
-      for (int c_row = 0; c_row < C->row_num; ++c_row) {
-        present_elements[c_row] = 0;
-      }
-      for (int b_idx = B->col_ptr[b_col]; b_idx < B->col_ptr[b_col + 1]; ++b_idx) {
-        int b_row = B->rows[b_idx];
-        for (int a_idx = A->col_ptr[b_row]; a_idx < A->col_ptr[b_row + 1]; ++a_idx) {
-          present_elements[A->rows[a_idx]] = 1;
-        }
-      }
-      int col_nonzero_count = 0;
-      for (int c_row = 0; c_row < C->row_num; ++c_row) {
-        col_nonzero_count += present_elements[c_row];
-      }
-      C->col_ptr[b_col + 1] = col_nonzero_count;
-    }
-
-#pragma omp single
-    {
-      // allocate memory for matrix C
-      for (int c_col = 0; c_col < C->col_num; ++c_col) {
-        C->col_ptr[c_col + 1] += C->col_ptr[c_col];
-      }
-      int total_nonzeros = C->col_ptr[C->col_num];
-      C->nonzeros = total_nonzeros;
-      C->rows.resize(total_nonzeros);
-      C->values.resize(total_nonzeros);
-    }
-
-    // numeric stage
-    std::complex<double> zero;
-    std::complex<double> b_value;
-    std::vector<std::complex<double>> accumulator(C->row_num);
-#pragma omp for schedule(dynamic, 64)
-    for (int b_col = 0; b_col < C->col_num; ++b_col) {
-      // set accumulator values to zero
-      for (int c_row = 0; c_row < C->row_num; ++c_row) {
-        accumulator[c_row] = zero;
-        present_elements[c_row] = 0;
-      }
-      // calculate column into accumulator
-      for (int b_idx = B->col_ptr[b_col]; b_idx < B->col_ptr[b_col + 1]; ++b_idx) {
-        int b_row = B->rows[b_idx];
-        b_value = B->values[b_idx];
-        for (int a_idx = A->col_ptr[b_row]; a_idx < A->col_ptr[b_row + 1]; ++a_idx) {
-          int a_row = A->rows[a_idx];
-          accumulator[a_row] += A->values[a_idx] * b_value;
-          present_elements[a_row] = 1;
-        }
-      }
-      // write column into matrix C
-      int c_pos = C->col_ptr[b_col];
-      for (int c_row = 0; c_row < C->row_num; ++c_row) {
-        if (present_elements[c_row] != 0) {
-          C->rows[c_pos] = c_row;
-          C->values[c_pos++] = accumulator[c_row];
-        }
-      }
-    }
-  }
-
+  C = ppc::core::spgemm(A, B, ppc::core::OmpSortBackend());
   return true;
 }
 
 bool SpgemmCSCComplexOmpPar::post_processing() {
   internal_order_test();
+  result->row_num = C.rows;
+  result->col_num = C.cols;
+  result->nonzeros = static_cast<int>(C.get_nnz());
+  result->col_ptr = std::move(C.ptr);
+  result->rows = std::move(C.index);
+  result->values.resize(C.get_nnz());
+  for (size_t k = 0; k < C.get_nnz(); k++) result->values[k] = C.get_value(k);
   return true;
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 // Copyright 2024 Vinichuk Timofey
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
@@ -16,17 +17,20 @@ TEST(vinicuk_t_complex_sparse_matrix_mult_csc_omp, test_pipeline_run_10000x10000
   CSCComplexMatrix mtrx_res(n, n);
   std::complex<double> a(2.0, 1.0);
 
-  for (int i = 0; i <= n; i++) {
-    mtrx_A.col_ptrs.push_back(i);
-    mtrx_B.col_ptrs.push_back(i);
+  // band of half width 20, like a discretized field operator
+  int width = 20;
+  for (int j = 0; j < n; j++) {
+    mtrx_A.col_ptrs.push_back(static_cast<int>(mtrx_A.row_indexes.size()));
+    mtrx_B.col_ptrs.push_back(static_cast<int>(mtrx_B.row_indexes.size()));
+    for (int i = std::max(0, j - width); i <= std::min(n - 1, j + width); i++) {
+      mtrx_A.row_indexes.push_back(i);
+      mtrx_A.values.emplace_back(a);
+      mtrx_B.row_indexes.push_back(i);
+      mtrx_B.values.emplace_back(a);
+    }
   }
-
-  for (int i = 0; i < n; i++) {
-    mtrx_A.row_indexes.push_back(i);
-    mtrx_A.values.emplace_back(a);
-    mtrx_B.row_indexes.push_back(i);
-    mtrx_B.values.emplace_back(a);
-  };
+  mtrx_A.col_ptrs.push_back(static_cast<int>(mtrx_A.row_indexes.size()));
+  mtrx_B.col_ptrs.push_back(static_cast<int>(mtrx_B.row_indexes.size()));
 
   // Create TaskData
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
@@ -63,17 +67,20 @@ TEST(vinicuk_t_complex_sparse_matrix_mult_csc_omp, test_task_run_10000x10000) {
   CSCComplexMatrix mtrx_res(n, n);
   std::complex<double> a(2.0, 1.0);
 
-  for (int i = 0; i <= n; i++) {
-    mtrx_A.col_ptrs.push_back(i);
-    mtrx_B.col_ptrs.push_back(i);
+  // band of half width 20, like a discretized field operator
+  int width = 20;
+  for (int j = 0; j < n; j++) {
+    mtrx_A.col_ptrs.push_back(static_cast<int>(mtrx_A.row_indexes.size()));
+    mtrx_B.col_ptrs.push_back(static_cast<int>(mtrx_B.row_indexes.size()));
+    for (int i = std::max(0, j - width); i <= std::min(n - 1, j + width); i++) {
+      mtrx_A.row_indexes.push_back(i);
+      mtrx_A.values.emplace_back(a);
+      mtrx_B.row_indexes.push_back(i);
+      mtrx_B.values.emplace_back(a);
+    }
   }
-
-  for (int i = 0; i < n; i++) {
-    mtrx_A.row_indexes.push_back(i);
-    mtrx_A.values.emplace_back(a);
-    mtrx_B.row_indexes.push_back(i);
-    mtrx_B.values.emplace_back(a);
-  };
+  mtrx_A.col_ptrs.push_back(static_cast<int>(mtrx_A.row_indexes.size()));
+  mtrx_B.col_ptrs.push_back(static_cast<int>(mtrx_B.row_indexes.size()));
 
   // Create TaskData
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
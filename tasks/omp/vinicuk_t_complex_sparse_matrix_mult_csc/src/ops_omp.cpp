@@ -2,11 +2,21 @@
 
 #include "omp/vinicuk_t_complex_sparse_matrix_mult_csc/include/ops_omp.hpp"
 
-#include <omp.h>
-
 #include <algorithm>
 #include <complex>
-#include <iostream>
+
+#include "core/sparse/include/split_complex.hpp"
+
+namespace {
+
+using ccs_view = ppc::core::SparseView<std::complex<double>, int, ppc::core::SparseLayout::CCS>;
+
+ccs_view get_view(const CSCComplexMatrix& matrix) {
+  return ppc::core::make_prefix_view<ppc::core::SparseLayout::CCS, std::complex<double>>(
+      matrix.num_rows, matrix.num_cols, matrix.col_ptrs, matrix.row_indexes, matrix.values);
+}
+
+}  // namespace
 
 bool vinichuk_t_omp::MultMatrixCSCComplex::pre_processing() {
   internal_order_test();
@@ -27,47 +37,29 @@ bool vinichuk_t_omp::MultMatrixCSCComplex::validation() {
   int B_col_num = reinterpret_cast<CSCComplexMatrix*>(taskData->inputs[1])->num_cols;
   int B_row_num = reinterpret_cast<CSCComplexMatrix*>(taskData->inputs[1])->num_rows;
 
-  return A_col_num == B_row_num && res_col_num == B_col_num && res_row_num == A_row_num;
+  return A_col_num == B_row_num && res_col_num == B_col_num && res_row_num == A_row_num &&
+         ppc::core::is_valid(get_view(*reinterpret_cast<CSCComplexMatrix*>(taskData->inputs[0])), false) &&
+         ppc::core::is_valid(get_view(*reinterpret_cast<CSCComplexMatrix*>(taskData->inputs[1])), false);
 }
 
 bool vinichuk_t_omp::MultMatrixCSCComplex::run() {
   internal_order_test();
 
-  std::vector<std::complex<double>> values;
-  std::vector<int> row_indexes;
-  std::vector<int> col_ptrs;
-  std::complex<double> sum;
-
-  std::vector<std::vector<std::complex<double>>> temp_values(mtrx_B->num_cols, std::vector<std::complex<double>>());
-  std::vector<std::vector<int>> temp_row_indexes(mtrx_B->num_cols, std::vector<int>());
-  mtrx_res->col_ptrs.push_back(0);
-
-#pragma omp parallel for private(sum) schedule(dynamic)
-  for (int j = 0; j < mtrx_B->num_cols; j++) {
-    // std::vector<std::complex<double>> temp_values;
-    // std::vector<int> temp_row_indexes;
-    for (int i = 0; i < mtrx_A->num_rows; i++) {
-      sum.imag(0.0);
-      sum.real(0.0);
-      for (int k = mtrx_B->col_ptrs[j]; k < mtrx_B->col_ptrs[j + 1]; k++) {
-        auto start = mtrx_A->row_indexes.begin() + mtrx_A->col_ptrs[mtrx_B->row_indexes[k]];
-        auto end = mtrx_A->row_indexes.begin() + mtrx_A->col_ptrs[mtrx_B->row_indexes[k] + 1];
-        auto it = find(start, end, i);
-        if (it != end) {
-          int index = distance(mtrx_A->row_indexes.begin(), it);
-          sum += mtrx_A->values[index] * mtrx_B->values[k];
-        }
-      }
-      if (sum.imag() != 0.0 || sum.real() != 0.0) {
-        temp_values[j].push_back(sum);
-        temp_row_indexes[j].push_back(i);
+  auto product = ppc::core::spgemm(ppc::core::to_split_complex(get_view(*mtrx_A)),
+                                    ppc::core::to_split_complex(get_view(*mtrx_B)), ppc::core::OmpSortBackend());
+
+  // entries which sum up to zero aren't kept
+  mtrx_res->values.clear();
+  mtrx_res->row_indexes.clear();
+  mtrx_res->col_ptrs.assign(1, 0);
+  for (int j = 0; j < product.cols; j++) {
+    for (int k = product.ptr[j]; k < product.ptr[j + 1]; k++) {
+      if (product.real[k] != 0.0 || product.imag[k] != 0.0) {
+        mtrx_res->values.push_back(product.get_value(k));
+        mtrx_res->row_indexes.push_back(product.index[k]);
       }
     }
-  }
-  for (size_t i = 0; i < temp_values.size(); i++) {
-    mtrx_res->col_ptrs.push_back(mtrx_res->values.size() + temp_values[i].size());
-    mtrx_res->values.insert(mtrx_res->values.end(), temp_values[i].begin(), temp_values[i].end());
-    mtrx_res->row_indexes.insert(mtrx_res->row_indexes.end(), temp_row_indexes[i].begin(), temp_row_indexes[i].end());
+    mtrx_res->col_ptrs.push_back(static_cast<int>(mtrx_res->values.size()));
   }
   return true;
 }
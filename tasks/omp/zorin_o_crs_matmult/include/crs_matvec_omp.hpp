@@ -0,0 +1,26 @@
+// Copyright 2024 Zorin Oleg
+#pragma once
+
+#include <vector>
+
+#include "core/sparse/include/spmv.hpp"
+#include "core/task/include/task.hpp"
+#include "crs_matrix.hpp"
+
+// y = A x for a CRSMatrix A given by pointer, e.g. a step of an iterative
+// solver. pre_processing converts A to SELL-C-sigma once, run() is the
+// vectorized product over parts of about equal nonzeros
+class CRSMatVecMult : public ppc::core::Task {
+  ppc::core::SellMatrix<double> A;
+  const double* x{};
+  std::vector<double> y;
+
+ public:
+  explicit CRSMatVecMult(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+  // A after pre_processing, as the product reads it
+  [[nodiscard]] const ppc::core::SellMatrix<double>& get_sell_matrix() const { return A; }
+};
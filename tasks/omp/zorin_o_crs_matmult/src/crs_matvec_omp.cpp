@@ -0,0 +1,47 @@
+// Copyright 2024 Zorin Oleg
+#include "omp/zorin_o_crs_matmult/include/crs_matvec_omp.hpp"
+
+#include <algorithm>
+#include <span>
+
+bool CRSMatVecMult::validation() {
+  internal_order_test();
+
+  if (taskData->inputs.size() != 2 || taskData->inputs_count.size() != 1 || taskData->outputs.size() != 1 ||
+      taskData->outputs_count.size() != 1) {
+    return false;
+  }
+  const auto* matrix = reinterpret_cast<const CRSMatrix*>(taskData->inputs[0]);
+  return matrix != nullptr && taskData->inputs_count[0] == static_cast<uint32_t>(matrix->n_cols) &&
+         taskData->outputs_count[0] == static_cast<uint32_t>(matrix->n_rows) &&
+         matrix->row_ptr.size() == static_cast<size_t>(matrix->n_rows) + 1;
+}
+
+bool CRSMatVecMult::pre_processing() {
+  internal_order_test();
+
+  const auto* matrix = reinterpret_cast<const CRSMatrix*>(taskData->inputs[0]);
+  ppc::core::CrsView<double> view{matrix->n_rows, matrix->n_cols, matrix->row_ptr, matrix->col_index,
+                                  matrix->values};
+  A = ppc::core::to_sell(view);
+  x = reinterpret_cast<const double*>(taskData->inputs[1]);
+  y.resize(matrix->n_rows);
+
+  return true;
+}
+
+bool CRSMatVecMult::run() {
+  internal_order_test();
+
+  ppc::core::spmv(A, std::span(x, static_cast<size_t>(A.cols)), y, ppc::core::OmpSortBackend());
+
+  return true;
+}
+
+bool CRSMatVecMult::post_processing() {
+  internal_order_test();
+
+  std::copy(y.begin(), y.end(), reinterpret_cast<double*>(taskData->outputs[0]));
+
+  return true;
+}
@@ -146,3 +146,36 @@ TEST(kostin_a_sle_conjugate_gradient_seq, Test_generated_SLE_size_1) {
   testTaskSequential.post_processing();
   ASSERT_TRUE(check_solution(in_A, size, in_b, out, 1e-6));
 }
+
+TEST(kostin_a_sle_conjugate_gradient_seq, Test_expired_deadline) {
+  int size = 100;
+
+  // Create data
+  std::vector<double> in_A = generateSPDMatrix(size, 100);
+  std::vector<double> in_b = generatePDVector(size, 100);
+  std::vector<double> out(size, 0.0);
+
+  // Create TaskData with deadline which is already expired
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_A.data()));
+  taskDataSeq->inputs_count.emplace_back(in_A.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_b.data()));
+  taskDataSeq->inputs_count.emplace_back(in_b.size());
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataSeq->outputs_count.emplace_back(out.size());
+  taskDataSeq->cancellation = std::make_shared<ppc::core::CancellationToken>();
+  taskDataSeq->cancellation->set_timeout(0.0);
+
+  // Create Task
+  ConjugateGradientMethodSequential testTaskSequential(taskDataSeq);
+  ASSERT_EQ(testTaskSequential.validation(), true);
+  testTaskSequential.pre_processing();
+  ASSERT_FALSE(testTaskSequential.run());
+  testTaskSequential.post_processing();
+  ASSERT_EQ(testTaskSequential.get_status(), ppc::core::Task::Status::TIMED_OUT);
+  ASSERT_LT(testTaskSequential.get_progress(), 1.0);
+  // solution after the first iteration is kept
+  ASSERT_FALSE(check_solution(in_A, size, in_b, out, 1e-6));
+  ASSERT_NE(out, std::vector<double>(size, 0.0));
+}
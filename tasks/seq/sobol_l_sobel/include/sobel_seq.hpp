@@ -15,6 +15,9 @@ class Sobel_seq : public ppc::core::Task {
  public:
   explicit Sobel_seq(std::shared_ptr<ppc::core::TaskData> taskData_, int w_, int h_)
       : Task(std::move(taskData_)), width(w_), height(h_) {}
+  // Form of TaskRegistration, width and height are inputs_count[1] and [2]
+  explicit Sobel_seq(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : Task(std::move(taskData_)), width(get_dimension(1)), height(get_dimension(2)) {}
   bool validation() override;
   bool pre_processing() override;
   bool run() override;
@@ -22,6 +25,9 @@ class Sobel_seq : public ppc::core::Task {
 
  private:
   void process_pixel(int i, int j);
+  [[nodiscard]] int get_dimension(size_t i) const {
+    return i < taskData->inputs_count.size() ? static_cast<int>(taskData->inputs_count[i]) : 0;
+  }
   std::vector<RGB> input_;
   std::vector<RGB> res;
   int width, height;
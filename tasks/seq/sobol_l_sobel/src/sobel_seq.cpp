@@ -5,6 +5,14 @@
 #include <cstring>
 #include <random>
 
+#include "core/dispatch/include/dispatch.hpp"
+
+namespace {
+
+ppc::core::TaskRegistration<sobol::Sobel_seq> registration("sobol_l_sobel", "seq");
+
+}  // namespace
+
 bool sobol::Sobel_seq::validation() {
   internal_order_test();
   if (taskData->inputs.empty() || taskData->outputs.empty()) {
@@ -7,6 +7,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace AfanasyevAlekseyStl;
 
 std::vector<Pixel> AfanasyevAlekseyStl::generateRandomPixels(std::size_t size) {
@@ -71,7 +73,7 @@ bool ImageContrastEnhacementTask::run() {
     return false;
   }
 
-  std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t num_threads = static_cast<std::size_t>(ppc::core::get_num_threads());
   std::vector<std::thread> threads(num_threads);
 
   auto handle_pixel = [&](std::size_t start_i, std::size_t end_i) {
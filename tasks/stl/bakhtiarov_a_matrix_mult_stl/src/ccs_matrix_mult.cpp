@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/threads/include/threads.hpp"
 
 using namespace std::chrono_literals;
 
@@ -77,7 +78,7 @@ bool SparseMatrixMultiSTL::run() {
   rows3.reserve(numCols2 * numRows1);
   colPtr3.reserve(numCols2 + 1);
 
-  unsigned int num_threads = thread::hardware_concurrency();
+  unsigned int num_threads = ppc::core::get_num_threads();
   if (num_threads == 0) {
     num_threads = 2;
   }
@@ -6,6 +6,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 using namespace bodrov_stl;
 
@@ -179,7 +181,7 @@ bool SparseMatrixSolverBodrovOMPParallel::run() {
     }
   };
 
-  const auto nthreads = std::thread::hardware_concurrency();
+  const auto nthreads = static_cast<unsigned int>(ppc::core::get_num_threads());
   std::vector<std::thread> threads(nthreads);
 
   for (unsigned t = 0; t < nthreads; ++t) {
@@ -3,6 +3,8 @@
 
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 #undef max
 #undef min
 
@@ -152,7 +154,7 @@ void ConvexHull::convexHullImage() {
     }
   }
 
-  unsigned int num_threads = std::thread::hardware_concurrency();
+  unsigned int num_threads = ppc::core::get_num_threads();
   if (num_threads == 0) {
     num_threads = 1;
   }
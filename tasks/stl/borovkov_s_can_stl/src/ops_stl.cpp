@@ -1,6 +1,8 @@
 // Copyright 2024 Borovkov Sergey
 #include "stl/borovkov_s_can_stl/include/ops_stl.hpp"
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 namespace BorovkovStl {
@@ -56,7 +58,7 @@ std::vector<double> CannonMatrixMultStl(const std::vector<double>& matrOne, cons
   if (!validateMatrix(matrOne.size(), matrTwo.size())) throw std::invalid_argument{"Invalid matrix sizes"};
 
   if (block > size || block <= 0) throw std::invalid_argument{"Wrong block size"};
-  int numThreads = std::thread::hardware_concurrency();
+  int numThreads = ppc::core::get_num_threads();
   if (numThreads == 0) numThreads = 1;
 
   std::vector<double> matrRes(size * size, 0.0);
@@ -6,6 +6,8 @@
 #include <iostream>
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 bool RadixSortTaskSTL::pre_processing() {
@@ -101,7 +103,7 @@ bool RadixSortTaskSTL::run() {
     std::vector<int> result;
     int VectorSize = VectorForSort.size();
 
-    int threadNum = std::thread::hardware_concurrency();
+    int threadNum = ppc::core::get_num_threads();
 
     if (threadNum >= VectorSize) {
       threadNum = VectorSize;
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 double func_x_plus_y(double num1, double num2) { return num1 + num2; }
@@ -32,7 +34,7 @@ bool fedotov_stl::FedotovTaskSeq::run() {
   double vysota1 = (Coordinates_For_Integration1[1] - Coordinates_For_Integration1[0]) / part_of_integrate;
   double vysota2 = (Coordinates_For_Integration2[1] - Coordinates_For_Integration2[0]) / part_of_integrate;
 
-  int num_threads = std::thread::hardware_concurrency();
+  int num_threads = ppc::core::get_num_threads();
   std::vector<std::thread> threads(num_threads);
 
   std::vector<double> partial_results(num_threads, 0.0);
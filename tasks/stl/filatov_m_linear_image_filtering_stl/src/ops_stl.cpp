@@ -3,6 +3,8 @@
 
 #include <cstdint>
 
+#include "core/threads/include/threads.hpp"
+
 filatov_stl::Color::Color() { R = G = B = 0; }
 
 filatov_stl::ColorF::ColorF() { R = G = B = .0f; }
@@ -102,7 +104,7 @@ void filatov_stl::GaussFilterHorizontal::makeKernel(float sigma) {
 }
 
 void filatov_stl::GaussFilterHorizontal::applyKernel() {
-  size_t num_threads = std::thread::hardware_concurrency();
+  size_t num_threads = ppc::core::get_num_threads();
   size_t part_size = image.size() / num_threads;
   std::vector<std::thread> threads;
 
@@ -12,6 +12,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 std::vector<int> getRandomVector2(int sz) {
@@ -133,7 +135,7 @@ bool RadixSTLG::run() {
   internal_order_test();
   try {
     size_t resultSize = input_.size();
-    size_t num_threads = std::thread::hardware_concurrency();
+    size_t num_threads = ppc::core::get_num_threads();
     std::vector<int> result;
     std::mutex resultMutex;
 
@@ -3,6 +3,8 @@
 
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 bool GaussFilterSequential::pre_processing() {
@@ -55,7 +57,7 @@ void GaussFilterSequential::createKernel(float sigma) {
   }
 }
 void GaussFilterSequential::applyKernel() {
-  uint32_t numThreads = std::thread::hardware_concurrency();
+  uint32_t numThreads = ppc::core::get_num_threads();
   auto* threads = new std::thread[numThreads];
   uint32_t columnsPerThread = (width - 2) / numThreads;
 
@@ -8,6 +8,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 bool KachalovIntegralSequentialMonteCarlo::pre_processing() {
@@ -86,7 +88,7 @@ bool KachalovIntegralSTLMonteCarlo::run() {
     }
   };
 
-  int num_threads = std::thread::hardware_concurrency();
+  int num_threads = ppc::core::get_num_threads();
   int chunk_size = N / num_threads;
 
   std::vector<std::thread> threads;
@@ -10,6 +10,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 bool KashinDijkstraStl::Dijkstra::pre_processing() {
   internal_order_test();
   graph = reinterpret_cast<int*>(taskData->inputs[0]);
@@ -40,7 +42,7 @@ bool KashinDijkstraStl::Dijkstra::validation() {
 
 bool KashinDijkstraStl::Dijkstra::run() {
   internal_order_test();
-  const int num_threads = std::thread::hardware_concurrency();
+  const int num_threads = ppc::core::get_num_threads();
   std::vector<std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, Compare>> tpqs(num_threads);
 
   std::vector<std::thread> threads;
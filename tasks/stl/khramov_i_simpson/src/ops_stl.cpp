@@ -3,6 +3,8 @@
 
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 double khramov_stl::simpson_formula(function func, double Xj0, double Xj1, double Xi) {
@@ -35,7 +37,7 @@ double khramov_stl::simpson_parallel(function func, int a1, int a2, int b1, int
   double h1 = static_cast<double>(b1 - a1) / numSteps;
   double h2 = static_cast<double>(b2 - a2) / numSteps;
 
-  int numThreads = std::thread::hardware_concurrency();
+  int numThreads = ppc::core::get_num_threads();
   std::vector<std::thread> threads;
   std::mutex mtx;
 
@@ -4,6 +4,7 @@
 #include <mutex>
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
 #include "stl/kistrimova_e_graham_alg_stl/include/ops_stl.hpp"
 
 bool GrahamAlgTask::pre_processing() {
@@ -57,7 +58,7 @@ std::vector<point> graham(std::vector<point> points) {
   std::swap(R[0], R[std::distance(points.begin(), p0_iter)]);
 
   std::vector<double> angles(n);
-  int num_threads = std::thread::hardware_concurrency();
+  int num_threads = ppc::core::get_num_threads();
   std::vector<std::thread> threads(num_threads);
   int chunk_size = n / num_threads;
 
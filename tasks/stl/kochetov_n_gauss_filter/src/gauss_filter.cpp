@@ -8,6 +8,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 int* GaussFilter::getImgId(int a, int b) { return &input[a * x + b]; }
 
 int* GaussFilter::getResId(int a, int b) { return &result[a * x + b]; }
@@ -47,7 +49,7 @@ void GaussFilter::applyFilter(int startRow, int endRow) {
 bool GaussFilter::run() {
   internal_order_test();
 
-  const int numThreads = std::thread::hardware_concurrency();
+  const int numThreads = ppc::core::get_num_threads();
   std::vector<std::thread> threads;
   int chunkSize = (x - 2) / numThreads;
 
@@ -148,3 +148,36 @@ TEST(kostin_a_sle_conjugate_gradient_stl, Test_generated_SLE_size_1) {
   testTaskSTL.post_processing();
   ASSERT_TRUE(check_solution(in_A, size, in_b, out, 1e-6));
 }
+
+TEST(kostin_a_sle_conjugate_gradient_stl, Test_expired_deadline) {
+  int size = 100;
+
+  // Create data
+  std::vector<double> in_A = generateSPDMatrix(size, 100);
+  std::vector<double> in_b = generatePDVector(size, 100);
+  std::vector<double> out(size, 0.0);
+
+  // Create TaskData with deadline which is already expired
+  std::shared_ptr<ppc::core::TaskData> taskDataSTL = std::make_shared<ppc::core::TaskData>();
+  taskDataSTL->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_A.data()));
+  taskDataSTL->inputs_count.emplace_back(in_A.size());
+  taskDataSTL->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_b.data()));
+  taskDataSTL->inputs_count.emplace_back(in_b.size());
+  taskDataSTL->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+  taskDataSTL->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataSTL->outputs_count.emplace_back(out.size());
+  taskDataSTL->cancellation = std::make_shared<ppc::core::CancellationToken>();
+  taskDataSTL->cancellation->set_timeout(0.0);
+
+  // Create Task
+  ConjugateGradientMethodSTL testTaskSTL(taskDataSTL);
+  ASSERT_EQ(testTaskSTL.validation(), true);
+  testTaskSTL.pre_processing();
+  ASSERT_FALSE(testTaskSTL.run());
+  testTaskSTL.post_processing();
+  ASSERT_EQ(testTaskSTL.get_status(), ppc::core::Task::Status::TIMED_OUT);
+  ASSERT_LT(testTaskSTL.get_progress(), 1.0);
+  // solution after the first iteration is kept
+  ASSERT_FALSE(check_solution(in_A, size, in_b, out, 1e-6));
+  ASSERT_NE(out, std::vector<double>(size, 0.0));
+}
@@ -1,6 +1,9 @@
 // Copyright 2024 Kostin Artem
 #include "stl/kostin_a_sle_conjugate_gradient/include/ops_stl.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <future>
 #include <random>
 #include <thread>
@@ -27,12 +30,14 @@ double dot_product(const std::vector<double>& a, const std::vector<double>& b) {
 }
 
 std::vector<double> conjugate_gradient(const std::vector<double>& A, int n, const std::vector<double>& b,
-                                       double tolerance) {
+                                       double tolerance, const std::function<bool(double)>& interrupted) {
   std::vector<double> x(n, 0.0);
   std::vector<double> r = b;
   std::vector<double> p = r;
   std::vector<double> r_prev = b;
 
+  const double initial_norm = sqrt(dot_product(r, r));
+
   while (true) {
     // 1st
     double Ap_dot_p;
@@ -64,7 +69,11 @@ std::vector<double> conjugate_gradient(const std::vector<double>& A, int n, cons
     double r_dot_r_2 = r_dot_r_future_2.get();
     // end of 3rd
 
-    if (sqrt(r_dot_r_2) < tolerance) {
+    double residual_norm = sqrt(r_dot_r_2);
+    if (residual_norm < tolerance) {
+      break;
+    }
+    if (interrupted(ppc::core::get_convergence_progress(initial_norm, residual_norm, tolerance))) {
       break;
     }
     double beta = r_dot_r_2 / r_prev_dot_prev_r;
@@ -148,8 +157,9 @@ bool ConjugateGradientMethodSTL::validation() {
 
 bool ConjugateGradientMethodSTL::run() {
   internal_order_test();
-  x = conjugate_gradient(A, size, b, 1e-6);
-  return true;
+  // stops with partial solution if the task is cancelled or out of time
+  x = conjugate_gradient(A, size, b, 1e-6, [this](double progress) { return interrupted(progress); });
+  return get_status() == Status::COMPLETED;
 }
 
 bool ConjugateGradientMethodSTL::post_processing() {
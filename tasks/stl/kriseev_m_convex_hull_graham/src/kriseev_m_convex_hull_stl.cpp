@@ -6,6 +6,8 @@
 #include <limits>
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 namespace KriseevMTaskStl {
 
 double angle1(const KriseevMTaskStl::Point &origin, const KriseevMTaskStl::Point &point) {
@@ -38,7 +40,7 @@ bool compareForSort1(const KriseevMTaskStl::Point &origin, const KriseevMTaskStl
 }
 
 void sortPoints(std::vector<Point> &points, const KriseevMTaskStl::Point &origin) {
-  size_t numThreads = std::thread::hardware_concurrency();
+  size_t numThreads = ppc::core::get_num_threads();
 
   size_t chunkSize = points.size() / numThreads;
   if (points.size() % numThreads > 0) {
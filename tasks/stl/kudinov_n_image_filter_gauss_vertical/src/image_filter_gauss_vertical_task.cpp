@@ -5,6 +5,8 @@
 #include <cmath>
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace KudinovSTL;
 
 GaussKernel::GaussKernel() : _radius(), _sigma(), _size() {}
@@ -89,7 +91,7 @@ Pixel Image::_get_gauss_filtered_pixel(std::size_t y, std::size_t x, const Gauss
 Image Image::gauss_filtered(const GaussKernel& gauss_kernel) const {
   Image out(this->_height, this->_width, std::vector<Pixel>(this->_height * this->_width, 0));
 
-  std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t num_threads = static_cast<std::size_t>(ppc::core::get_num_threads());
   std::vector<std::thread> threads(num_threads);
 
   auto process_columns = [&](std::size_t start_x, std::size_t end_x) {
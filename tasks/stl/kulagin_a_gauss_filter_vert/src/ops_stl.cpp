@@ -5,6 +5,8 @@
 #include <exception>
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 enum class CURRENT_POSITION { START, END, MIDDLE };
 
 bool FilterGaussVerticalTaskSTLKulagin::pre_processing() {
@@ -59,7 +61,7 @@ bool FilterGaussVerticalTaskSTLKulagin::run() {
           break;
       }
     };
-    const size_t max_threads = std::thread::hardware_concurrency();
+    const size_t max_threads = ppc::core::get_num_threads();
     // if we have too many threads or 1 thread (also accounts for one edge case when w == 1)
     if (max_threads > w || max_threads <= 1) {
       kulagin_a_gauss::apply_filter(w, h, img, kernel, img_res.get());
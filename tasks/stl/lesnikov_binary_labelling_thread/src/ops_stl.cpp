@@ -2,7 +2,6 @@
 #include "stl/lesnikov_binary_labelling_thread/include/ops_stl.hpp"
 
 #include <cstring>
-#include <future>
 #include <iostream>
 #include <list>
 #include <numeric>
@@ -13,6 +12,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "core/threads/include/thread_pool.hpp"
+
 using namespace std::chrono_literals;
 
 class InfPtr {
@@ -122,29 +123,14 @@ std::vector<int> reducePointers(std::vector<InfPtr>& labelled) {
   return reduced;
 }
 
-std::vector<int> reducePointersThread(std::vector<InfPtr>& labelled, int numThreads) {
+std::vector<int> reducePointersThread(std::vector<InfPtr>& labelled) {
   std::vector<int> reduced(labelled.size());
 
-  size_t blockSize = labelled.size() / numThreads;
-  size_t remainder = labelled.size() % numThreads;
-
-  auto reduce = [&labelled, &reduced](size_t start, size_t end) {
+  ppc::core::parallel_for<size_t>(0, labelled.size(), [&labelled, &reduced](size_t start, size_t end) {
     for (size_t i = start; i < end; i++) {
       reduced[i] = labelled[i].value();
     }
-  };
-
-  std::vector<std::future<void>> futures(static_cast<size_t>(numThreads));
-
-  futures[0] = std::async(std::launch::async, reduce, 0, blockSize + remainder);
-
-  for (size_t i = 1; i < static_cast<size_t>(numThreads); i++) {
-    futures[i] = std::async(std::launch::async, reduce, remainder + i * blockSize, remainder + (i + 1) * blockSize);
-  }
-
-  for (auto& fut : futures) {
-    fut.get();
-  }
+  });
 
   return reduced;
 }
@@ -258,15 +244,14 @@ std::vector<int> getLabelledImageOmp(const std::vector<uint8_t>& v, int m, int n
     processVertical(labelled, v, label, n, start, end);
     processMedium(labelled, v, label, n, start, end);
   };
-  std::vector<std::future<void>> futures(static_cast<size_t>(numThreads));
-  for (int i = 0; i < numThreads; i++) {
-    futures[i] = std::async(std::launch::async, process, i);
-  }
-  for (auto& fut : futures) {
-    fut.get();
+  ppc::core::TaskGroup group;
+  for (int i = 1; i < numThreads; i++) {
+    group.run([&process, i] { process(i); });
   }
+  process(0);
+  group.wait();
   mergeBounds(labelled, blockSize, m, n);
-  return reducePointersThread(labelled, numThreads);
+  return reducePointersThread(labelled);
 }
 
 bool BinaryLabellingSeq::pre_processing() {
@@ -5,6 +5,8 @@
 #include <iostream>
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 #undef min
 
 std::vector<double> cannonMtrxMultiplication(const std::vector<double>& A, const std::vector<double>& B, int n, int m) {
@@ -59,7 +61,7 @@ std::vector<double> cannonMtrxMultiplication_tbb(const std::vector<double>& A, c
     return std::vector<double>();
   }
 
-  int Threads_num = std::thread::hardware_concurrency();
+  int Threads_num = ppc::core::get_num_threads();
   if (Threads_num == 0) {
     Threads_num = 1;
   }
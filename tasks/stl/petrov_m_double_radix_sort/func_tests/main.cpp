@@ -155,3 +155,30 @@ TEST(Petrov_M_Radix_Sort_STL, Test_With_Positive_and_Negative_Numbers3) {
     ASSERT_EQ(sorted[i], out[i]);
   }
 }
+
+TEST(Petrov_M_Radix_Sort_STL, Test_Permutation_Output) {
+  // Create data
+  std::vector<double> in{2.5, -3.22, 5.32, -1.11, 2.5, 0.0};
+  std::vector<double> sorted{-3.22, -1.11, 0.0, 2.5, 2.5, 5.32};
+  std::vector<uint32_t> expected_permutation{1, 3, 5, 0, 4, 2};
+  std::vector<double> out(in.size());
+  std::vector<uint32_t> permutation(in.size());
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskDataPar->inputs_count.emplace_back(in.size());
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataPar->outputs_count.emplace_back(out.size());
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(permutation.data()));
+  taskDataPar->outputs_count.emplace_back(permutation.size());
+
+  // Create Task
+  PetrovRadixSortDoubleSTL testTaskSTL(taskDataPar);
+  ASSERT_EQ(testTaskSTL.validation(), true);
+  testTaskSTL.pre_processing();
+  testTaskSTL.run();
+  testTaskSTL.post_processing();
+  ASSERT_EQ(out, sorted);
+  ASSERT_EQ(permutation, expected_permutation);
+}
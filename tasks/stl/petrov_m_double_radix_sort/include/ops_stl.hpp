@@ -2,13 +2,15 @@
 #pragma once
 
 #include <algorithm>
-#include <future>
 #include <iterator>
+#include <numeric>
 #include <random>
 #include <thread>
 #include <vector>
 
+#include "core/sort/include/sort.hpp"
 #include "core/task/include/task.hpp"
+#include "core/threads/include/thread_pool.hpp"
 
 using namespace std::chrono_literals;
 namespace petrov_stl {
@@ -24,6 +26,9 @@ class PetrovRadixSortDoubleSTL : public ppc::core::Task {
  private:
   int data_size;
   std::vector<double> sort;
+  // argsort mode: second output receives uint32_t indices of sorted inputs
+  bool with_permutation = false;
+  std::vector<uint32_t> permutation;
   static void PetrovCountSort(double* in, double* out, int len, int exp);
   static bool PetrovCountSortSigns(const double* in, double* out, int len);
   static std::vector<double> PetrovRadixSort(const std::vector<double>& data1);
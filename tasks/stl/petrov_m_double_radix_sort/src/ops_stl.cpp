@@ -131,24 +131,17 @@ std::vector<double> PetrovRadixSortDoubleSTL::PetrovRadixSort(const std::vector<
 }
 std::vector<double> PetrovRadixSortDoubleSTL::PetrovBinaryMergeTree(std::vector<std::vector<double>>& sortedVectors) {
   while (sortedVectors.size() > 1) {
-    std::vector<std::vector<double>> mergedVectors;
-    std::vector<std::future<std::vector<double>>> futures;
     int vectorSize = static_cast<int>(sortedVectors.size());
+    std::vector<std::vector<double>> mergedVectors(vectorSize / 2);
 
-    // Предварительное выделение памяти для futures
-    futures.reserve(vectorSize / 2);
-
-    // Создаем асинхронные задачи для слияния пар векторов
+    // Создаем задачи пула потоков для слияния пар векторов
+    ppc::core::TaskGroup group;
     for (int i = 0; i < vectorSize - 1; i += 2) {
-      futures.push_back(std::async(std::launch::async, &PetrovRadixSortDoubleSTL::PetrovMerge,
-                                   std::cref(sortedVectors[i]), std::cref(sortedVectors[i + 1])));
+      group.run([&, i] { mergedVectors[i / 2] = PetrovMerge(sortedVectors[i], sortedVectors[i + 1]); });
     }
 
-    // Собираем результаты выполнения задач
-    mergedVectors.reserve(futures.size());
-    for (auto& future : futures) {
-      mergedVectors.push_back(future.get());
-    }
+    // Дожидаемся результатов выполнения задач
+    group.wait();
 
     // Если количество векторов нечетное, добавляем последний вектор в результат
     if (vectorSize % 2 != 0) {
@@ -164,18 +157,13 @@ std::vector<double> PetrovRadixSortDoubleSTL::PetrovBinaryMergeTree(std::vector<
 
 std::vector<double> PetrovRadixSortDoubleSTL::PetrovRadixSortStl(const std::vector<double>& data, int numParts) {
   std::vector<std::vector<double>> vectorsForParallel = PetrovSplitVector(data, numParts);
-  std::vector<std::future<std::vector<double>>> futures;
   int vectorSize = static_cast<int>(vectorsForParallel.size());
-  futures.reserve(vectorSize);
-
-  for (int i = 0; i < vectorSize; ++i) {
-    futures.push_back(
-        std::async(std::launch::async, &PetrovRadixSortDoubleSTL::PetrovRadixSort, std::cref(vectorsForParallel[i])));
-  }
 
+  ppc::core::TaskGroup group;
   for (int i = 0; i < vectorSize; ++i) {
-    vectorsForParallel[i] = futures[i].get();
+    group.run([&vectorsForParallel, i] { vectorsForParallel[i] = PetrovRadixSort(vectorsForParallel[i]); });
   }
+  group.wait();
 
   std::vector<double> finalResult = PetrovBinaryMergeTree(vectorsForParallel);
   return finalResult;
@@ -192,6 +180,9 @@ bool PetrovRadixSortDoubleSTL::pre_processing() {
     for (int i = 0; i < data_size; i++) {
       sort.push_back(inp[i]);
     }
+    with_permutation = taskData->outputs.size() > 1;
+    permutation.resize(with_permutation ? data_size : 0);
+    std::iota(permutation.begin(), permutation.end(), 0U);
   } catch (...) {
     std::cout << "\n";
     std::cout << "Double radix sort error";
@@ -204,13 +195,22 @@ bool PetrovRadixSortDoubleSTL::pre_processing() {
 bool PetrovRadixSortDoubleSTL::validation() {
   internal_order_test();
   // Check count elements of output
+  if (taskData->outputs.size() > 1 && taskData->outputs_count[1] != taskData->inputs_count[0]) {
+    return false;
+  }
   return ((taskData->inputs_count[0] > 1) && (taskData->outputs_count[0] == taskData->inputs_count[0]));
 }
 
 bool PetrovRadixSortDoubleSTL::run() {
   internal_order_test();
   try {
-    sort = (PetrovRadixSortStl(sort, 6));
+    if (with_permutation) {
+      // indices are moved with keys in the same passes of the radix sort
+      ppc::core::radix_sort_pairs(std::span<double>(sort), std::span<uint32_t>(permutation),
+                                  ppc::core::StlSortBackend());
+    } else {
+      sort = (PetrovRadixSortStl(sort, 6));
+    }
   } catch (...) {
     std::cout << "\n";
     std::cout << "Double radix sort error";
@@ -227,6 +227,9 @@ bool PetrovRadixSortDoubleSTL::post_processing() {
     for (int i = 0; i < data_size; i++) {
       outputs[i] = sort[i];
     }
+    if (with_permutation) {
+      std::copy(permutation.begin(), permutation.end(), reinterpret_cast<uint32_t*>(taskData->outputs[1]));
+    }
   } catch (...) {
     std::cout << "\n";
     std::cout << "Double radix sort error";
@@ -7,6 +7,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 std::vector<Point> Jarvis(const std::vector<Point>& points) {
   if (points.size() < 3) return points;
 
@@ -30,7 +32,7 @@ std::vector<Point> Jarvis(const std::vector<Point>& points) {
 
   do {
     nextPoint = points[0];
-    int numThreads = std::thread::hardware_concurrency();
+    int numThreads = ppc::core::get_num_threads();
     int chunkSize = points.size() / numThreads;
     std::vector<std::thread> threads;
     std::vector<Point> candidates(numThreads, nextPoint);
@@ -1,6 +1,8 @@
 // Copyright 2024 Pozdnyakov Vasya
 #include "stl/pozdnyakov_v_rect_integral/include/ops_stl.hpp"
 
+#include "core/threads/include/threads.hpp"
+
 double pozdnyakov_stl::pozdnyakov_flin(double x, double y) { return x - y; }
 double pozdnyakov_stl::pozdnyakov_fxy(double x, double y) { return x * y; }
 double pozdnyakov_stl::pozdnyakov_fysinx(double x, double y) { return y * std::sin(x); }
@@ -32,7 +34,7 @@ bool pozdnyakov_stl::PozdnyakovTaskSTL::run() {
     double x_i = std::abs(x2 - x1) / n;
     double y_i = std::abs(y2 - y1) / n;
 
-    int threadsCount = std::thread::hardware_concurrency();
+    int threadsCount = ppc::core::get_num_threads();
     std::vector<std::thread> threads;
     std::mutex mutex;
 
@@ -7,6 +7,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 bool check_CRS_properties(const matrix_CRS& A) {
   if (A.row_id.size() != size_t(A.n + 1)) return false;
   int nz = A.value.size();
@@ -81,7 +83,7 @@ bool CRSComplexMult_stl::run() {
   C->m = B->n;  // not m because B is transposed
   C->row_id.assign(C->n + 1, 0);
   std::vector<std::vector<std::pair<int, std::complex<double>>>> temp(C->n);
-  const int num_max_threads = std::thread::hardware_concurrency();
+  const int num_max_threads = ppc::core::get_num_threads();
   const int piece = A->n / num_max_threads;
   std::vector<std::thread> threads(num_max_threads);
   for (int thr = 0; thr < num_max_threads; thr++) {
@@ -7,6 +7,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 SparseMatrixCRS::SparseMatrixCRS(int _numberOfColumns, int _numberOfRows, const std::vector<double>& _values,
                                  const std::vector<int>& _columnIndexes, const std::vector<int>& _pointers)
     : numberOfColumns(_numberOfColumns),
@@ -199,7 +201,7 @@ bool SparseMatrixMultiplicationCRS_STL::run() {
 
   int resultColumnIndexes = Y->numberOfRows;  // After transposing matrix Y
 
-  const int num_threads = 4;
+  const int num_threads = ppc::core::get_num_threads();
   std::vector<std::thread> threads(num_threads);
 
   for (int i = 0; i < num_threads; ++i) {
@@ -2,6 +2,8 @@
 
 #include "stl/salaev_v_components_marking_stl/include/ops_seq.hpp"
 
+#include "core/threads/include/threads.hpp"
+
 using namespace SalaevSTL;
 
 bool ImageMarkingSeq::validation() {
@@ -160,7 +162,7 @@ bool ImageMarkingSTL::run() {
     }
   };
 
-  int numThreads = std::thread::hardware_concurrency();
+  int numThreads = ppc::core::get_num_threads();
   int chunkSize = height / numThreads;
 
   for (int t = 0; t < numThreads; ++t) {
@@ -6,6 +6,8 @@
 #include <iostream>
 #include <random>
 
+#include "core/threads/include/threads.hpp"
+
 void saratova_stl::GenerateIdentityMatrix(double* matrix, int size, double scale) {
   std::fill(matrix, matrix + size * size, 0.0);
   for (int i = 0; i < size; ++i) {
@@ -90,7 +92,7 @@ bool saratova_stl::SaratovaTaskSTL::pre_processing() {
 bool saratova_stl::SaratovaTaskSTL::run() {
   internal_order_test();
   try {
-    unsigned int num_threads = std::thread::hardware_concurrency();
+    unsigned int num_threads = ppc::core::get_num_threads();
     std::vector<std::thread> threads;
 
     auto compute_partial_matrix = [&](size_t start_row, size_t end_row) {
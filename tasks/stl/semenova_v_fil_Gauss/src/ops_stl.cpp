@@ -3,6 +3,8 @@
 
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 bool ImageFilGauss::validation() {
   internal_order_test();
 
@@ -22,7 +24,7 @@ bool ImageFilGauss::pre_processing() {
     image = reinterpret_cast<int*>(taskData->inputs[0]);
     filteredImage = reinterpret_cast<int*>(taskData->outputs[0]);
 
-    int numThreads = std::thread::hardware_concurrency();
+    int numThreads = ppc::core::get_num_threads();
     auto* threads = new std::thread[numThreads];
     int rowsPerThread = n / numThreads;
 
@@ -54,7 +56,7 @@ bool ImageFilGauss::pre_processing() {
 bool ImageFilGauss::run() {
   internal_order_test();
   try {
-    int numThreads = std::thread::hardware_concurrency();
+    int numThreads = ppc::core::get_num_threads();
     auto* threads = new std::thread[numThreads];
     int rowsPerThread = (n - 2) / numThreads;
 
@@ -90,7 +92,7 @@ bool ImageFilGauss::run() {
 bool ImageFilGauss::post_processing() {
   internal_order_test();
   try {
-    int numThreads = std::thread::hardware_concurrency();
+    int numThreads = ppc::core::get_num_threads();
     auto* threads = new std::thread[numThreads];
     int rowsPerThread = n / numThreads;
 
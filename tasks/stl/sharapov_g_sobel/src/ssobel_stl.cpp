@@ -7,6 +7,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 SSobelStl::GrayScale SSobelStl::getPixel(const std::vector<SSobelStl::GrayScale>& image, size_t x, size_t y,
                                          size_t width, size_t height) {
   if (x > width - 1) x = width - 1;
@@ -58,7 +60,7 @@ std::vector<SSobelStl::GrayScale> SSobelStl::SobelOperatorStl(const std::vector<
   int sizeImg = width * height;
   std::vector<GrayScale> resultImg(sizeImg);
 
-  auto numCores = std::thread::hardware_concurrency();
+  auto numCores = static_cast<unsigned int>(ppc::core::get_num_threads());
   std::vector<std::thread> threads(numCores);
   auto blockSize = sizeImg / numCores;
 
@@ -1,6 +1,8 @@
 // Copyright 2024 Shipitsin Alex
 #include "stl/shipitsin_a_rect_integral/include/ops_stl.hpp"
 
+#include "core/threads/include/threads.hpp"
+
 double shipitsin_stl::shipitsin_flin(double x, double y) { return x - y; }
 double shipitsin_stl::shipitsin_fxy(double x, double y) { return x * y; }
 double shipitsin_stl::shipitsin_fysinx(double x, double y) { return y * std::sin(x); }
@@ -32,7 +34,7 @@ bool shipitsin_stl::ShipitsinTaskSTL::run() {
     double x_i = std::abs(x2 - x1) / n;
     double y_i = std::abs(y2 - y1) / n;
 
-    int threadsCount = std::thread::hardware_concurrency();
+    int threadsCount = ppc::core::get_num_threads();
     std::vector<std::thread> threads;
     std::mutex mutex;
 
@@ -27,5 +27,6 @@ class LinearFilteringGauss : public ppc::core::Task {
   std::vector<int> res = {};
   int height{}, width{};
   int min{}, max{};
-  int countThreads = std::thread::hardware_concurrency();
+  // ppc::core::get_num_threads() at run if it isn't set
+  int countThreads = 0;
 };
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <random>
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 void LinearFilteringGauss::applyLinearFilteringGauss(int startRow, int endRow) {
   std::vector<int> gaussianKernel = {1, 2, 1, 2, 4, 2, 1, 2, 1};
   int kernelSize = 3;
@@ -61,20 +63,21 @@ bool LinearFilteringGauss::validation() {
 bool LinearFilteringGauss::run() {
   internal_order_test();
   std::vector<int> filteredImage(input.size(), 0);
-  std::vector<std::thread> threads(countThreads);
-  int blockSize = height / countThreads;
+  int numThreads = countThreads > 0 ? countThreads : ppc::core::get_num_threads();
+  std::vector<std::thread> threads(numThreads);
+  int blockSize = height / numThreads;
 
-  for (int i = 0; i < countThreads; ++i) {
+  for (int i = 0; i < numThreads; ++i) {
     int startRow = i * blockSize;
     int endRow;
-    if (i == countThreads - 1) {
+    if (i == numThreads - 1) {
       endRow = height;
     } else {
       endRow = (i + 1) * blockSize;
     }
     threads[i] = std::thread(&LinearFilteringGauss::applyLinearFilteringGauss, this, startRow, endRow);
   }
-  for (int i = 0; i < countThreads; ++i) {
+  for (int i = 0; i < numThreads; ++i) {
     threads[i].join();
   }
   return true;
@@ -7,6 +7,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 // Транспонирование матрицы
@@ -147,7 +149,7 @@ bool smirnova_stl::StlTestComplexMatrixCrsPar::run() {
   Result->pointer.assign(Result->n_rows + 1, 0);
   std::vector<std::vector<std::pair<int, std::complex<double>>>> temp(Result->n_rows);
 
-  int numThreads = std::thread::hardware_concurrency();
+  int numThreads = ppc::core::get_num_threads();
   std::vector<std::thread> threads;
   std::mutex temp_mutex;
 
@@ -7,6 +7,15 @@
 #include <random>
 #include <thread>
 
+#include "core/dispatch/include/dispatch.hpp"
+#include "core/threads/include/threads.hpp"
+
+namespace {
+
+ppc::core::TaskRegistration<sobol::Sobel_stl> registration("sobol_l_sobel", "stl");
+
+}  // namespace
+
 bool sobol::Sobel_stl::validation() {
   internal_order_test();
   if (taskData->inputs.empty() || taskData->outputs.empty()) {
@@ -53,6 +62,7 @@ bool sobol::Sobel_stl::run() {
     return true;
   }
 
+  num_threads = ppc::core::get_num_threads();
   int rows_per_thread = width / num_threads;
   threads.reserve(num_threads);
   for (int i = 0; i < num_threads; i++) {
@@ -10,6 +10,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 std::vector<uint8_t> getRandomPicture(int n, int m, uint8_t min, uint8_t max) {
@@ -87,7 +89,7 @@ bool ContrastEnhancement_STL_Parallel::run() {
   if ((size == 0) || (min == max)) {
     return false;
   }
-  const int num_max_threads = std::thread::hardware_concurrency();
+  const int num_max_threads = ppc::core::get_num_threads();
   std::vector<std::thread> thr(num_max_threads);
   int block = size / num_max_threads;
   for (int i = 0; i < num_max_threads; i++) {
@@ -1,6 +1,8 @@
 // Copyright 2024 Tushentsova Karina
 #include "stl/tushentsova_k_marking_bin_image/include/ops_stl.hpp"
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 bool markingImageStl::run() {
@@ -45,7 +47,7 @@ void markingImageStl::markingImage() {
   std::vector<std::vector<uint32_t *>> arr;
   arr.resize(height);
 
-  int numThreads = std::thread::hardware_concurrency();
+  int numThreads = ppc::core::get_num_threads();
   auto *threads = new std::thread[numThreads];
   int rowsPerThread = (height) / numThreads;
 
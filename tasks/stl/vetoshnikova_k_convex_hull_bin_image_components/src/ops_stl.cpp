@@ -3,6 +3,8 @@
 
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 bool vetoshnikova_stl::ConstructingConvexHullSeq::pre_processing() {
@@ -196,7 +198,7 @@ bool vetoshnikova_stl::ConstructingConvexHullSTL::run() {
     }
   };
 
-  int numThreads = std::thread::hardware_concurrency();
+  int numThreads = ppc::core::get_num_threads();
   std::vector<std::thread> threads;
   int chunkSize = (numComponents + numThreads - 1) / numThreads;
 
@@ -6,6 +6,8 @@
 #include <mutex>
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 
 double fn_simpson(vinokurovIvanSTL::func _fn, double _x0, double _x1, double _y) {
@@ -71,7 +73,7 @@ bool vinokurovIvanSTL::SimpsonMethodSTL::run() {
   internal_order_test();
   double res{};
 
-  int threadsNumber = std::thread::hardware_concurrency();
+  int threadsNumber = ppc::core::get_num_threads();
   int chunkSize = n / threadsNumber;
 
   std::vector<std::thread> threads;
@@ -5,6 +5,8 @@
 #include <functional>
 #include <iostream>
 
+#include "core/threads/include/threads.hpp"
+
 bool SobelTaskStlVolodin::validation() {
   internal_order_test();
   return (taskData->inputs_count.size() == 2) && (taskData->outputs_count.size() == 2);
@@ -18,7 +20,7 @@ bool SobelTaskStlVolodin::pre_processing() {
     sourceImage.reserve(width_ * height_);
     resultImage.reserve(width_ * height_);
 
-    int numThreads = std::thread::hardware_concurrency();
+    int numThreads = ppc::core::get_num_threads();
     std::vector<std::thread> threads(numThreads);
 
     int elementsPerThread = (width_ * height_) / numThreads;
@@ -42,7 +44,7 @@ bool SobelTaskStlVolodin::pre_processing() {
 bool SobelTaskStlVolodin::run() {
   internal_order_test();
   try {
-    int numThreads = std::thread::hardware_concurrency();
+    int numThreads = ppc::core::get_num_threads();
     std::vector<std::thread> threads(numThreads);
 
     int rowsPerThread = height_ / numThreads;
@@ -67,7 +69,7 @@ bool SobelTaskStlVolodin::post_processing() {
     taskData->outputs_count[0] = width_;
     taskData->outputs_count[1] = height_;
 
-    int numThreads = std::thread::hardware_concurrency();
+    int numThreads = ppc::core::get_num_threads();
     std::vector<std::thread> threads(numThreads);
 
     int elementsPerThread = (width_ * height_) / numThreads;
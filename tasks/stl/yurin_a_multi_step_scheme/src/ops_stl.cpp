@@ -3,6 +3,8 @@
 
 #include <thread>
 
+#include "core/threads/include/threads.hpp"
+
 using namespace std::chrono_literals;
 using namespace yurin_stl;
 
@@ -141,7 +143,7 @@ bool MultiStepSchemeSTL::pre_processing() {
 
   h = reinterpret_cast<double*>(taskData->inputs[2])[0];
   end = reinterpret_cast<double*>(taskData->inputs[3])[0];
-  numThreads = std::thread::hardware_concurrency();
+  numThreads = ppc::core::get_num_threads();
 
   return true;
 }
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <future>
 
+#include "core/threads/include/threads.hpp"
+
 bool ZakharovRadixSortSTL::validation() {
   internal_order_test();
   return taskData->inputs_count[0] == taskData->outputs_count[0];
@@ -17,7 +19,7 @@ bool ZakharovRadixSortSTL::pre_processing() {
     inp_arr.resize(arr_size);
     copy_data(inp, inp_arr.data(), arr_size);
     out_arr = reinterpret_cast<Number*>(taskData->outputs[0]);
-    int max_threads = static_cast<int>(std::pow(2, static_cast<int>(std::log2(std::thread::hardware_concurrency()))));
+    int max_threads = static_cast<int>(std::pow(2, static_cast<int>(std::log2(ppc::core::get_num_threads()))));
     portion = arr_size / max_threads;
     if (arr_size % max_threads != 0) {
       portion++;
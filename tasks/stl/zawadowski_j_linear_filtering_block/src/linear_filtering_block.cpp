@@ -2,6 +2,8 @@
 
 #include "stl/zawadowski_j_linear_filtering_block/include/linear_filtering_block.hpp"
 
+#include "core/threads/include/threads.hpp"
+
 bool zawadaSTL::LinearFiltering::pre_processing() {
   internal_order_test();
   input = taskData->inputs[0];
@@ -25,7 +27,7 @@ bool zawadaSTL::LinearFiltering::validation() {
 bool zawadaSTL::LinearFiltering::run() {
   internal_order_test();
 
-  int numThreads = std::thread::hardware_concurrency();
+  int numThreads = ppc::core::get_num_threads();
   std::vector<std::thread> threads(numThreads);
 
   if (width < blockWidth || height < blockHeight) throw "Error: Image size is less than block size!";
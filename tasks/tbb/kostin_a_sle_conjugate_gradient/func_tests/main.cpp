@@ -148,3 +148,36 @@ TEST(kostin_a_sle_conjugate_gradient_tbb, Test_generated_SLE_size_1) {
   testTaskTBB.post_processing();
   ASSERT_TRUE(check_solution(in_A, size, in_b, out, 1e-6));
 }
+
+TEST(kostin_a_sle_conjugate_gradient_tbb, Test_expired_deadline) {
+  int size = 100;
+
+  // Create data
+  std::vector<double> in_A = generateSPDMatrix(size, 100);
+  std::vector<double> in_b = generatePDVector(size, 100);
+  std::vector<double> out(size, 0.0);
+
+  // Create TaskData with deadline which is already expired
+  std::shared_ptr<ppc::core::TaskData> taskDataTBB = std::make_shared<ppc::core::TaskData>();
+  taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_A.data()));
+  taskDataTBB->inputs_count.emplace_back(in_A.size());
+  taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_b.data()));
+  taskDataTBB->inputs_count.emplace_back(in_b.size());
+  taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(&size));
+  taskDataTBB->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataTBB->outputs_count.emplace_back(out.size());
+  taskDataTBB->cancellation = std::make_shared<ppc::core::CancellationToken>();
+  taskDataTBB->cancellation->set_timeout(0.0);
+
+  // Create Task
+  ConjugateGradientMethodTBB testTaskTBB(taskDataTBB);
+  ASSERT_EQ(testTaskTBB.validation(), true);
+  testTaskTBB.pre_processing();
+  ASSERT_FALSE(testTaskTBB.run());
+  testTaskTBB.post_processing();
+  ASSERT_EQ(testTaskTBB.get_status(), ppc::core::Task::Status::TIMED_OUT);
+  ASSERT_LT(testTaskTBB.get_progress(), 1.0);
+  // solution after the first iteration is kept
+  ASSERT_FALSE(check_solution(in_A, size, in_b, out, 1e-6));
+  ASSERT_NE(out, std::vector<double>(size, 0.0));
+}
@@ -1,6 +1,9 @@
 // Copyright 2024 Kostin Artem
 #include "tbb/kostin_a_sle_conjugate_gradient/include/ops_tbb.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <tbb/tbb.h>
 
 #include <random>
@@ -36,12 +39,14 @@ double dot_product(const std::vector<double>& a, const std::vector<double>& b) {
 }
 
 std::vector<double> conjugate_gradient(const std::vector<double>& A, int n, const std::vector<double>& b,
-                                       double tolerance) {
+                                       double tolerance, const std::function<bool(double)>& interrupted) {
   std::vector<double> x(n, 0.0);
   std::vector<double> r = b;
   std::vector<double> p = r;
   std::vector<double> r_prev = b;
 
+  const double initial_norm = sqrt(dot_product(r, r));
+
   while (true) {
     std::vector<double> Ap = dense_matrix_vector_multiply(A, n, p);
     double alpha = dot_product(r, r) / dot_product(Ap, p);
@@ -58,7 +63,11 @@ std::vector<double> conjugate_gradient(const std::vector<double>& A, int n, cons
       }
     });
 
-    if (sqrt(dot_product(r, r)) < tolerance) {
+    double residual_norm = sqrt(dot_product(r, r));
+    if (residual_norm < tolerance) {
+      break;
+    }
+    if (interrupted(ppc::core::get_convergence_progress(initial_norm, residual_norm, tolerance))) {
       break;
     }
 
@@ -144,8 +153,9 @@ bool ConjugateGradientMethodTBB::validation() {
 
 bool ConjugateGradientMethodTBB::run() {
   internal_order_test();
-  x = conjugate_gradient(A, size, b, 1e-6);
-  return true;
+  // stops with partial solution if the task is cancelled or out of time
+  x = conjugate_gradient(A, size, b, 1e-6, [this](double progress) { return interrupted(progress); });
+  return get_status() == Status::COMPLETED;
 }
 
 bool ConjugateGradientMethodTBB::post_processing() {
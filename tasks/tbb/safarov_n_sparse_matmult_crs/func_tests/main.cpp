@@ -1,9 +1,13 @@
 // Copyright 2024 Safarov Nurlan
 #include <gtest/gtest.h>
+#include <tbb/tbb.h>
 
+#include <algorithm>
 #include <numeric>
+#include <utility>
 #include <vector>
 
+#include "core/sparse/include/sparse_tbb.hpp"
 #include "tbb/safarov_n_sparse_matmult_crs/include/sparse_matmult_crs_tbb.hpp"
 
 TEST(Safarov_N_SparseMatMultCRS_TBB, TestOne) {
@@ -216,4 +220,77 @@ TEST(Safarov_N_SparseMatMultCRS_TBB, TestFive) {
     double t = correctAnswer.values[i] - z.values[i];
     ASSERT_NEAR(0.0f, t, 1e-6);
   }
-}
\ No newline at end of file
+}
+
+TEST(Safarov_N_SparseMatMultCRS_TBB, TestSkewedRows) {
+  // A few dense rows of x hold most of the work of the product
+  std::vector<std::vector<double>> xDense = createRandomMatrix(80, 60, 0.05);
+  for (int r = 0; r < 3; r++) std::fill(xDense[r * 20].begin(), xDense[r * 20].end(), 1.5);
+  std::vector<std::vector<double>> yDense = createRandomMatrix(50, 80, 0.1);
+  SparseMatrixCRS x(xDense);
+  SparseMatrixCRS y(yDense);
+  SparseMatrixCRS correctAnswer(multiplyMatrices(xDense, yDense));
+  SparseMatrixCRS z;
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataTbb = std::make_shared<ppc::core::TaskData>();
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(&x));
+  taskDataTbb->inputs.emplace_back(reinterpret_cast<uint8_t *>(&y));
+  taskDataTbb->outputs.emplace_back(reinterpret_cast<uint8_t *>(&z));
+
+  // Create Task
+  SparseMatrixMultiplicationCRS_TBB taskTbb(taskDataTbb);
+  ASSERT_EQ(taskTbb.validation(), true);
+  ASSERT_EQ(taskTbb.pre_processing(), true);
+  ASSERT_EQ(taskTbb.run(), true);
+  ASSERT_EQ(taskTbb.post_processing(), true);
+
+  ASSERT_EQ(z.numberOfRows, correctAnswer.numberOfRows);
+  ASSERT_EQ(z.numberOfColumns, correctAnswer.numberOfColumns);
+  ASSERT_EQ(z.pointers, correctAnswer.pointers);
+  ASSERT_EQ(z.columnIndexes, correctAnswer.columnIndexes);
+  for (size_t i = 0; i < correctAnswer.values.size(); ++i) {
+    double t = correctAnswer.values[i] - z.values[i];
+    ASSERT_NEAR(0.0f, t, 1e-6);
+  }
+}
+
+TEST(Safarov_N_SparseMatMultCRS_TBB, TestCostRange) {
+  // line 2 costs 100, the others 1
+  std::vector<size_t> costPrefix = {0, 1, 2, 102, 103, 104, 105, 106};
+  ppc::core::CostRange range(costPrefix);
+  ASSERT_EQ(range.size(), 7U);
+  ASSERT_EQ(range.get_cost(), 106U);
+  ppc::core::CostRange right(range, tbb::split());
+  ASSERT_EQ(range.end(), 3U);
+  ASSERT_EQ(right.begin(), 3U);
+  ppc::core::CostRange middle(range, tbb::split());
+  ASSERT_EQ(range.end(), 2U);
+  ASSERT_EQ(middle.size(), 1U);
+  ASSERT_FALSE(middle.is_divisible());
+
+  tbb::concurrent_vector<std::pair<size_t, size_t>> ranges;
+  tbb::parallel_for(
+      ppc::core::CostRange(costPrefix, 3),
+      [&](const ppc::core::CostRange &r) { ranges.emplace_back(r.begin(), r.end()); }, tbb::simple_partitioner());
+  std::vector<std::pair<size_t, size_t>> sorted(ranges.begin(), ranges.end());
+  std::sort(sorted.begin(), sorted.end());
+  ASSERT_EQ(sorted.front().first, 0U);
+  ASSERT_EQ(sorted.back().second, 7U);
+  for (size_t i = 1; i < sorted.size(); ++i) ASSERT_EQ(sorted[i - 1].second, sorted[i].first);
+  ASSERT_NE(std::find(sorted.begin(), sorted.end(), std::make_pair(size_t{2}, size_t{3})), sorted.end());
+
+  ASSERT_TRUE(ppc::core::CostRange(std::vector<size_t>{}).empty());
+  ASSERT_TRUE(ppc::core::CostRange(std::vector<size_t>{0}).empty());
+}
+
+TEST(Safarov_N_SparseMatMultCRS_TBB, TestCostPrefix) {
+  std::vector<size_t> costs(10000);
+  std::iota(costs.begin(), costs.end(), 0);
+  costs[17] = 1000000;
+  std::vector<size_t> expected(costs.size() + 1, 0);
+  std::partial_sum(costs.begin(), costs.end(), expected.begin() + 1);
+  auto lineCost = [&](size_t i) { return costs[i]; };
+  ASSERT_EQ(ppc::core::make_cost_prefix(costs.size(), lineCost, ppc::core::TbbSortBackend()), expected);
+  ASSERT_EQ(ppc::core::make_cost_prefix(0, lineCost, ppc::core::TbbSortBackend()), std::vector<size_t>{0});
+}
@@ -8,6 +8,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/sparse/include/sparse_tbb.hpp"
+
 SparseMatrixCRS::SparseMatrixCRS(int _numberOfColumns, int _numberOfRows, const std::vector<double>& _values,
                                  const std::vector<int>& _columnIndexes, const std::vector<int>& _pointers)
     : numberOfColumns(_numberOfColumns),
@@ -200,36 +202,51 @@ bool SparseMatrixMultiplicationCRS_TBB::run() {
 
   int resultColumnIndexes = Y->numberOfRows;  // After transposing matrix Y
 
-  int sizePart = 10;
-  tbb::parallel_for(tbb::blocked_range<int>(0, X->numberOfRows, sizePart), [&](tbb::blocked_range<int> r) {
-    for (int rOne = r.begin(); rOne != r.end(); ++rOne) {
-      for (int rTwo = 0; rTwo < Y->numberOfRows; rTwo++) {
-        int firstCurrentPointer = X->pointers[rOne];
-        int secondCurrentPointer = Y->pointers[rTwo];
-        int firstEndPointer = X->pointers[rOne + 1] - 1;
-        int secondEndPointer = Y->pointers[rTwo + 1] - 1;
-        double v = 0;
-
-        while ((secondCurrentPointer <= secondEndPointer) && (firstCurrentPointer <= firstEndPointer)) {
-          if (X->columnIndexes[firstCurrentPointer] <= Y->columnIndexes[secondCurrentPointer]) {
-            if (X->columnIndexes[firstCurrentPointer] == Y->columnIndexes[secondCurrentPointer]) {
-              v += (X->values[firstCurrentPointer]) * (Y->values[secondCurrentPointer]);
-              secondCurrentPointer++;
-              firstCurrentPointer++;
-            } else {
-              firstCurrentPointer++;
+  // Row of X is merged with every row of transposed Y, so its cost is about
+  // its length per row of Y plus nnz of Y. Ranges are split at half of the
+  // cost down to a few chunks per thread, heavy rows end up in chunks of
+  // their own and the light ones are taken together
+  const auto mergeCost = Y->values.size() + Y->numberOfRows;
+  auto costPrefix = ppc::core::make_cost_prefix(
+      X->numberOfRows,
+      [&](size_t rOne) {
+        auto length = static_cast<size_t>(X->pointers[rOne + 1] - X->pointers[rOne]);
+        return length * Y->numberOfRows + mergeCost;
+      },
+      ppc::core::TbbSortBackend());
+  const auto grainCost = costPrefix.back() / (tbb::this_task_arena::max_concurrency() * 4);
+  tbb::parallel_for(
+      ppc::core::CostRange(costPrefix, grainCost),
+      [&](const ppc::core::CostRange& r) {
+        for (auto rOne = static_cast<int>(r.begin()); rOne != static_cast<int>(r.end()); ++rOne) {
+          for (int rTwo = 0; rTwo < Y->numberOfRows; rTwo++) {
+            int firstCurrentPointer = X->pointers[rOne];
+            int secondCurrentPointer = Y->pointers[rTwo];
+            int firstEndPointer = X->pointers[rOne + 1] - 1;
+            int secondEndPointer = Y->pointers[rTwo + 1] - 1;
+            double v = 0;
+
+            while ((secondCurrentPointer <= secondEndPointer) && (firstCurrentPointer <= firstEndPointer)) {
+              if (X->columnIndexes[firstCurrentPointer] <= Y->columnIndexes[secondCurrentPointer]) {
+                if (X->columnIndexes[firstCurrentPointer] == Y->columnIndexes[secondCurrentPointer]) {
+                  v += (X->values[firstCurrentPointer]) * (Y->values[secondCurrentPointer]);
+                  secondCurrentPointer++;
+                  firstCurrentPointer++;
+                } else {
+                  firstCurrentPointer++;
+                }
+              } else {
+                secondCurrentPointer++;
+              }
+            }
+            if (v != 0) {
+              localValues[rOne].push_back(v);
+              localColumnIndexes[rOne].push_back(rTwo);
             }
-          } else {
-            secondCurrentPointer++;
           }
         }
-        if (v != 0) {
-          localValues[rOne].push_back(v);
-          localColumnIndexes[rOne].push_back(rTwo);
-        }
-      }
-    }
-  });
+      },
+      tbb::simple_partitioner());
 
   int elementCounter = 0;
   finalPointers.push_back(elementCounter);
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/threads/include/tbb_pinning.hpp"
 
 namespace sobol {
 struct RGB {
@@ -15,6 +16,9 @@ class Sobel_tbb : public ppc::core::Task {
  public:
   explicit Sobel_tbb(std::shared_ptr<ppc::core::TaskData> taskData_, int w_, int h_)
       : Task(std::move(taskData_)), width(w_), height(h_) {}
+  // Form of TaskRegistration, width and height are inputs_count[1] and [2]
+  explicit Sobel_tbb(std::shared_ptr<ppc::core::TaskData> taskData_)
+      : Task(std::move(taskData_)), width(get_dimension(1)), height(get_dimension(2)) {}
   bool validation() override;
   bool pre_processing() override;
   bool run() override;
@@ -22,9 +26,14 @@ class Sobel_tbb : public ppc::core::Task {
 
  private:
   void process_pixel(int i, int j);
+  [[nodiscard]] int get_dimension(size_t i) const {
+    return i < taskData->inputs_count.size() ? static_cast<int>(taskData->inputs_count[i]) : 0;
+  }
   std::vector<RGB> input_;
   std::vector<RGB> res;
   int width, height;
+  // threads of TBB follow pinning policy of Perf runs
+  ppc::core::TbbPinningObserver pinning_observer;
 };
 
 std::vector<RGB> getRandomRGBPicture(int w, int h);
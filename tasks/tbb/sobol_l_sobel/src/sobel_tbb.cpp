@@ -8,6 +8,14 @@
 #include <cstring>
 #include <random>
 
+#include "core/dispatch/include/dispatch.hpp"
+
+namespace {
+
+ppc::core::TaskRegistration<sobol::Sobel_tbb> registration("sobol_l_sobel", "tbb");
+
+}  // namespace
+
 bool sobol::Sobel_tbb::validation() {
   internal_order_test();
   if (taskData->inputs.empty() || taskData->outputs.empty()) {
@@ -1,9 +1,11 @@
 // Copyright 2024 Zorin Oleg
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <vector>
 
 #include "tbb/zorin_o_crs_matmult/include/crs_matmult_tbb.hpp"
+#include "tbb/zorin_o_crs_matmult/include/crs_matvec_tbb.hpp"
 
 TEST(Zorin_O_CRS_MatMult_TBB, incorrect_matrix_sizes) {
   // Create data
@@ -245,4 +247,88 @@ TEST(Zorin_O_CRS_MatMult_TBB, special_matmult) {
         EXPECT_DOUBLE_EQ(out[i * r + j], 0.0);
     }
   }
-}
\ No newline at end of file
+}
+
+TEST(Zorin_O_CRS_MatVecMult_TBB, incorrect_vector_size) {
+  // Create data
+  int p = 11;
+  int q = 10;
+  std::vector<double> matrix_in = getRandomMatrix(p, q);
+  CRSMatrix matrix(matrix_in.data(), p, q);
+  std::vector<double> x(q + 1);
+  std::vector<double> out(p);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataTBB = std::make_shared<ppc::core::TaskData>();
+  taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(&matrix));
+  taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(x.data()));
+  taskDataTBB->inputs_count.emplace_back(q + 1);
+  taskDataTBB->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataTBB->outputs_count.emplace_back(p);
+
+  // Create Task
+  CRSMatVecMult testTaskTBB(taskDataTBB);
+  ASSERT_FALSE(testTaskTBB.validation());
+}
+
+TEST(Zorin_O_CRS_MatVecMult_TBB, random_matrix) {
+  // Create data
+  int p = 301;
+  int q = 157;
+  std::vector<double> matrix_in = getRandomMatrix(p, q, 0.05);
+  for (int j = 0; j < q; ++j) {
+    matrix_in[7 * q + j] = 1.0;
+  }
+  CRSMatrix matrix(matrix_in.data(), p, q);
+  std::vector<double> x = getRandomMatrix(1, q, 1.0);
+  std::vector<double> out(p);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataTBB = std::make_shared<ppc::core::TaskData>();
+  taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(&matrix));
+  taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(x.data()));
+  taskDataTBB->inputs_count.emplace_back(q);
+  taskDataTBB->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataTBB->outputs_count.emplace_back(p);
+
+  // Create Task
+  CRSMatVecMult testTaskTBB(taskDataTBB);
+  ASSERT_TRUE(testTaskTBB.validation());
+  ASSERT_TRUE(testTaskTBB.pre_processing());
+  ASSERT_TRUE(testTaskTBB.run());
+  ASSERT_TRUE(testTaskTBB.post_processing());
+  for (int i = 0; i < p; ++i) {
+    double expected = 0.0;
+    for (int j = 0; j < q; ++j) {
+      expected += matrix_in[i * q + j] * x[j];
+    }
+    EXPECT_NEAR(out[i], expected, 1e-9 * std::abs(expected) + 1e-12);
+  }
+}
+
+TEST(Zorin_O_CRS_MatVecMult_TBB, identity_matrix) {
+  // Create data
+  int n = 100;
+  std::vector<double> matrix_in = getIdentityMatrix(n);
+  CRSMatrix matrix(matrix_in.data(), n, n);
+  std::vector<double> x = getRandomMatrix(1, n, 1.0);
+  std::vector<double> out(n);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataTBB = std::make_shared<ppc::core::TaskData>();
+  taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(&matrix));
+  taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(x.data()));
+  taskDataTBB->inputs_count.emplace_back(n);
+  taskDataTBB->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskDataTBB->outputs_count.emplace_back(n);
+
+  // Create Task
+  CRSMatVecMult testTaskTBB(taskDataTBB);
+  ASSERT_TRUE(testTaskTBB.validation());
+  ASSERT_TRUE(testTaskTBB.pre_processing());
+  ASSERT_TRUE(testTaskTBB.run());
+  ASSERT_TRUE(testTaskTBB.post_processing());
+  for (int i = 0; i < n; ++i) {
+    EXPECT_DOUBLE_EQ(out[i], x[i]);
+  }
+}
@@ -1,9 +1,100 @@
 // Copyright 2024 Zorin Oleg
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
 #include "core/perf/include/perf.hpp"
 #include "tbb/tbb.h"
 #include "tbb/zorin_o_crs_matmult/include/crs_matmult_tbb.hpp"
+#include "tbb/zorin_o_crs_matmult/include/crs_matvec_tbb.hpp"
+
+namespace {
+
+// Row i has entries at columns i - half_width ... i + half_width
+CRSMatrix getBandedCRSMatrix(int n, int half_width) {
+  CRSMatrix matrix(n, n);
+  for (int i = 0; i < n; ++i) {
+    matrix.row_ptr.emplace_back(static_cast<int>(matrix.values.size()));
+    for (int j = std::max(0, i - half_width); j <= std::min(n - 1, i + half_width); ++j) {
+      matrix.col_index.emplace_back(j);
+      matrix.values.emplace_back(1.0 / (1 + std::abs(i - j)));
+    }
+  }
+  matrix.row_ptr.emplace_back(static_cast<int>(matrix.values.size()));
+  return matrix;
+}
+
+// Row lengths follow a power law (Pareto with exponent 1.5, at least 2),
+// like degrees of web and social graphs: a few rows hold a large part of
+// the entries. Columns are random
+CRSMatrix getPowerLawCRSMatrix(int n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::uniform_int_distribution<int> col(0, n - 1);
+  CRSMatrix matrix(n, n);
+  for (int i = 0; i < n; ++i) {
+    matrix.row_ptr.emplace_back(static_cast<int>(matrix.values.size()));
+    auto length = std::min(n, static_cast<int>(2.0 / std::pow(1.0 - uniform(gen), 1.0 / 1.5)));
+    std::vector<int> columns(length);
+    for (auto &c : columns) c = col(gen);
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+    for (int c : columns) {
+      matrix.col_index.emplace_back(c);
+      matrix.values.emplace_back(uniform(gen));
+    }
+  }
+  matrix.row_ptr.emplace_back(static_cast<int>(matrix.values.size()));
+  return matrix;
+}
+
+// Sweep of y = A x over sizes of matrices of the generator. GB/s of every
+// point is the traffic of the SELL-C-sigma arrays the task multiplies,
+// padding included, by its median time
+void runMatVecSweep(const std::function<CRSMatrix(int)> &generator) {
+  // data of the task being measured, the previous one is done with it
+  std::unique_ptr<CRSMatrix> matrix;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::shared_ptr<CRSMatVecMult> task;
+
+  auto sweepAttr = std::make_shared<ppc::core::SweepAttr>();
+  sweepAttr->sizes = ppc::core::SweepAttr::geometric_sizes(1 << 14, 1 << 20, 4.0);
+  sweepAttr->make_task = [&](uint64_t size) {
+    matrix = std::make_unique<CRSMatrix>(generator(static_cast<int>(size)));
+    x.assign(size, 1.0);
+    y.assign(size, 0.0);
+
+    std::shared_ptr<ppc::core::TaskData> taskDataTBB = std::make_shared<ppc::core::TaskData>();
+    taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.get()));
+    taskDataTBB->inputs.emplace_back(reinterpret_cast<uint8_t *>(x.data()));
+    taskDataTBB->inputs_count.emplace_back(size);
+    taskDataTBB->outputs.emplace_back(reinterpret_cast<uint8_t *>(y.data()));
+    taskDataTBB->outputs_count.emplace_back(size);
+    task = std::make_shared<CRSMatVecMult>(taskDataTBB);
+    return task;
+  };
+  sweepAttr->flops = [&](uint64_t) { return 2.0 * static_cast<double>(matrix->values.size()); };
+  sweepAttr->bytes = [&](uint64_t) { return ppc::core::get_spmv_bytes(task->get_sell_matrix()); };
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 20;
+  const auto t0 = oneapi::tbb::tick_count::now();
+  perfAttr->current_timer = [&] { return (oneapi::tbb::tick_count::now() - t0).seconds(); };
+
+  auto sweepResults = std::make_shared<ppc::core::SweepResults>();
+  ppc::core::Perf::sweep_run(perfAttr, sweepAttr, sweepResults, ppc::core::PerfResults::TypeOfRunning::TASK_RUN);
+  ppc::core::Perf::print_sweep_statistic(sweepResults);
+  ASSERT_EQ(sweepResults->points.size(), sweepAttr->sizes.size());
+  for (const auto &point : sweepResults->points) EXPECT_GT(point.gbytes_per_sec, 0.0);
+}
+
+}  // namespace
 
 TEST(Zorin_O_CRS_MatMult_TBB, test_pipeline_run) {
   // Create data
@@ -118,3 +209,11 @@ TEST(Zorin_O_CRS_MatMult_TBB, test_task_run) {
     }
   }
 }
+
+TEST(Zorin_O_CRS_MatVecMult_TBB, test_sweep_banded) {
+  runMatVecSweep([](int n) { return getBandedCRSMatrix(n, 8); });
+}
+
+TEST(Zorin_O_CRS_MatVecMult_TBB, test_sweep_power_law) {
+  runMatVecSweep([](int n) { return getPowerLawCRSMatrix(n, 42); });
+}